@@ -16,52 +16,100 @@ DEFINES += QT_DEPRECATED_WARNINGS
 #DEFINES += QT_DISABLE_DEPRECATED_BEFORE=0x060000    # disables all the APIs deprecated before Qt 6.0.0
 
 SOURCES += \
-    avltree.cpp \
+    benchmark.cpp \
+    benchmarkdialog.cpp \
     bsttree.cpp \
     btree.cpp \
+    btreeorderdialog.cpp \
+    bucketlanesitem.cpp \
+    cachelinemapitem.cpp \
     chighlighter.cpp \
+    counterpanel.cpp \
+    dataset.cpp \
+    distancematrixitem.cpp \
+    forcelayout.cpp \
     graph.cpp \
     graphicsview.cpp \
+    histogramitem.cpp \
+    layoutsearchdialog.cpp \
+    loditems.cpp \
     main.cpp \
     mainScene.cpp \
+    opcounter.cpp \
+    parallelsort.cpp \
     queue.cpp \
+    searchlayout.cpp \
     singlylist.cpp \
+    sorttrace.cpp \
+    speedupdialog.cpp \
     stack.cpp \
+    traceplayer.cpp \
     visualbtree.cpp \
     visualbubblesort.cpp \
     visualbucketsort.cpp \
     visualgraph.cpp \
     visualheap.cpp \
+    visuallayoutsearch.cpp \
+    visualparallelsort.cpp \
     visualqueue.cpp \
     visualquicksort.cpp \
+    visualradixsort.cpp \
     visualsearch.cpp \
     visualsinglylist.cpp \
     visualstack.cpp \
-    visualtree.cpp
+    visualtree.cpp \
+    workertimelineitem.cpp
 
 HEADERS += \
     avltree.h \
+    benchmark.h \
+    benchmarkdialog.h \
     binarytree.h \
     bsttree.h \
     btree.h \
+    btreeorderdialog.h \
+    bucketlanesitem.h \
+    cachelinemapitem.h \
     chighlighter.h \
+    counterpanel.h \
+    dataset.h \
+    distancematrixitem.h \
+    forcelayout.h \
     graph.h \
     graphicsview.h \
+    heapsort.h \
+    histogramitem.h \
+    introsort.h \
+    layoutsearchdialog.h \
+    loditems.h \
     mainScene.h \
+    nodepool.h \
+    opcounter.h \
+    parallelsort.h \
     queue.h \
+    radixsort.h \
+    search.h \
+    searchlayout.h \
     singlylist.h \
+    sorttrace.h \
+    speedupdialog.h \
     stack.h \
+    traceplayer.h \
     visualbtree.h \
     visualbubblesort.h \
     visualbucketsort.h \
     visualgraph.h \
     visualheap.h \
+    visuallayoutsearch.h \
+    visualparallelsort.h \
     visualqueue.h \
     visualquicksort.h \
+    visualradixsort.h \
     visualsearch.h \
     visualsinglylist.h \
     visualstack.h \
-    visualtree.h
+    visualtree.h \
+    workertimelineitem.h
 
 FORMS += \
     mainScene.ui
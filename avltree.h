@@ -1,33 +1,355 @@
 #ifndef AVLTREE_H
 #define AVLTREE_H
 
-#include "binarytree.h"
-#include <QDebug>
+#include "nodepool.h"
+#include "opcounter.h"
+#include <QtGlobal>
+#include <algorithm>
+#include <functional>
+#include <iterator>
+#include <memory>
+#include <type_traits>
+#include <vector>
 
+// 平衡二叉树（AVL）：键类型、比较器与分配器均为模板参数，不允许重复键
+// 插入与删除自根向下记录路径（指向各结点的链接），再沿路径自底向上回溯调整平衡因子，全程不递归
+// 结点只存键、左右孩子与 int8 平衡因子（右子树高度减左子树高度），int 键的结点 24 字节；
+// 结点由 NodePool 按块分配，clear() 整块归还；旋转次数经 Counter 记录，计时用 NullOpCounter
+template <class Key, class Compare = std::less<Key>, class Allocator = std::allocator<Key>, class Counter = OpCounter>
 class AVLTree {
 public:
-    AVLTree();
-    ~AVLTree();
-
-    void insert(int key);
-    void remove(int key);
-    void clear();
-    void clear(TreeNode* node);
-    void updateHeight(TreeNode* node);
-    int max(int a, int b);
-    int height(TreeNode* node);
-    int getBalance(TreeNode* node);
-
-    TreeNode* insert(TreeNode* node, int key);
-    TreeNode* remove(TreeNode* node, int key);
-    TreeNode* minValueNode(TreeNode* node);
-    TreeNode* getRoot() const;
-    TreeNode* rotateLeft(TreeNode* x);
-    TreeNode* rotateRight(TreeNode* y);
+    struct Node {
+        Key value;
+        Node* left;
+        Node* right;
+        qint8 balance;
+
+        explicit Node(const Key& key) : value(key), left(nullptr), right(nullptr), balance(0) {}
+    };
+
+    // AVL 树高不超过 1.44·log2(n + 2)，64 层足以容纳 2^43 个结点
+    static const int MaxHeight = 64;
+
+    // 中序迭代器：栈中保存“尚未访问、且当前结点位于其左子树中”的祖先，栈顶即当前结点
+    class const_iterator {
+    public:
+        typedef std::forward_iterator_tag iterator_category;
+        typedef Key value_type;
+        typedef std::ptrdiff_t difference_type;
+        typedef const Key* pointer;
+        typedef const Key& reference;
+
+        const_iterator() : m_depth(0) {}
+        const_iterator(const const_iterator& other) : m_depth(other.m_depth) {
+            std::copy(other.m_path, other.m_path + m_depth, m_path);   // 只复制用到的部分
+        }
+        const_iterator& operator=(const const_iterator& other) {
+            m_depth = other.m_depth;
+            std::copy(other.m_path, other.m_path + m_depth, m_path);
+            return *this;
+        }
+
+        reference operator*() const { return m_path[m_depth - 1]->value; }
+        pointer operator->() const { return &m_path[m_depth - 1]->value; }
+
+        const_iterator& operator++() {
+            const Node* node = m_path[--m_depth];
+            pushLeftSpine(node->right);
+            return *this;
+        }
+        const_iterator operator++(int) {
+            const_iterator old = *this;
+            ++*this;
+            return old;
+        }
+
+        bool operator==(const const_iterator& other) const {
+            return m_depth == other.m_depth && (m_depth == 0 || m_path[m_depth - 1] == other.m_path[m_depth - 1]);
+        }
+        bool operator!=(const const_iterator& other) const { return !(*this == other); }
+
+    private:
+        friend class AVLTree;
+
+        void push(const Node* node) { m_path[m_depth++] = node; }
+        void pushLeftSpine(const Node* node) {
+            for (; node; node = node->left)
+                push(node);
+        }
+
+        const Node* m_path[MaxHeight];
+        int m_depth;
+    };
+    typedef const_iterator iterator;
+
+    explicit AVLTree(const Compare& comp = Compare(), const Allocator& alloc = Allocator())
+        : m_root(nullptr), m_size(0), m_comp(comp), m_pool(alloc) {}
+    ~AVLTree() { clear(); }
+
+    AVLTree(const AVLTree&) = delete;
+    AVLTree& operator=(const AVLTree&) = delete;
+
+    // 返回是否插入了新键
+    bool insert(const Key& key) {
+        Node** path[MaxHeight];
+        int dirs[MaxHeight];                 // -1 向左，+1 向右
+        int depth = 0;
+        Node** link = &m_root;
+        while (*link) {
+            Node* node = *link;
+            path[depth] = link;
+            if (m_comp(key, node->value)) {
+                dirs[depth++] = -1;
+                link = &node->left;
+            } else if (m_comp(node->value, key)) {
+                dirs[depth++] = 1;
+                link = &node->right;
+            } else {
+                return false;
+            }
+        }
+        *link = m_pool.create(key);
+        ++m_size;
+
+        // 自底向上：所在一侧变高；平衡因子回到 0 说明高度不变，出现 ±2 时旋转后高度恢复
+        while (depth-- > 0) {
+            Node* node = *path[depth];
+            node->balance += dirs[depth];
+            if (node->balance == 0) break;
+            if (node->balance == 1 || node->balance == -1) continue;
+            *path[depth] = rebalance(node);
+            break;
+        }
+        return true;
+    }
+
+    // 空树时先排序去重再自底向上构建完全平衡的树（O(n log n) 排序 + O(n) 构建），否则逐个插入
+    template <class InputIt>
+    void insert(InputIt first, InputIt last) {
+        if (m_root) {
+            for (; first != last; ++first)
+                insert(*first);
+            return;
+        }
+        std::vector<Key> keys(first, last);
+        if (!std::is_sorted(keys.begin(), keys.end(), m_comp))
+            std::sort(keys.begin(), keys.end(), m_comp);
+        const Compare& comp = m_comp;
+        keys.erase(std::unique(keys.begin(), keys.end(),
+                               [&comp](const Key& a, const Key& b) { return !comp(a, b) && !comp(b, a); }),
+                   keys.end());
+        m_root = build(keys.data(), static_cast<qint64>(keys.size()));
+        m_size = static_cast<qint64>(keys.size());
+    }
+
+    // 返回删除的键数（0 或 1）
+    int erase(const Key& key) {
+        Node** path[MaxHeight];
+        int dirs[MaxHeight];
+        int depth = 0;
+        Node** link = &m_root;
+        while (*link) {
+            Node* node = *link;
+            if (m_comp(key, node->value)) {
+                path[depth] = link;
+                dirs[depth++] = -1;
+                link = &node->left;
+            } else if (m_comp(node->value, key)) {
+                path[depth] = link;
+                dirs[depth++] = 1;
+                link = &node->right;
+            } else {
+                break;
+            }
+        }
+        Node* target = *link;
+        if (!target) return 0;
+
+        if (target->left && target->right) {
+            // 用右子树的最小结点顶替：键移到 target，物理上删除后继结点
+            path[depth] = link;
+            dirs[depth++] = 1;
+            Node** successor = &target->right;
+            while ((*successor)->left) {
+                path[depth] = successor;
+                dirs[depth++] = -1;
+                successor = &(*successor)->left;
+            }
+            Node* removed = *successor;
+            target->value = std::move(removed->value);
+            *successor = removed->right;
+            m_pool.destroy(removed);
+        } else {
+            *link = target->left ? target->left : target->right;
+            m_pool.destroy(target);
+        }
+        --m_size;
+
+        // 自底向上：所在一侧变矮；平衡因子变为 ±1 说明高度不变；旋转后新根平衡因子非 0 时高度也不变
+        while (depth-- > 0) {
+            Node* node = *path[depth];
+            node->balance -= dirs[depth];
+            if (node->balance == 1 || node->balance == -1) break;
+            if (node->balance == 0) continue;
+            Node* root = rebalance(node);
+            *path[depth] = root;
+            if (root->balance != 0) break;
+        }
+        return 1;
+    }
+
+    // 键可平凡析构时不遍历，直接归还全部块
+    void clear() {
+        if (!std::is_trivially_destructible<Key>::value) {
+            std::vector<Node*> stack;
+            if (m_root) stack.push_back(m_root);
+            while (!stack.empty()) {
+                Node* node = stack.back();
+                stack.pop_back();
+                if (node->left) stack.push_back(node->left);
+                if (node->right) stack.push_back(node->right);
+                node->~Node();
+            }
+        }
+        m_pool.release();
+        m_root = nullptr;
+        m_size = 0;
+    }
+
+    bool contains(const Key& key) const {
+        const Node* node = m_root;
+        while (node) {
+            if (m_comp(key, node->value)) node = node->left;
+            else if (m_comp(node->value, key)) node = node->right;
+            else return true;
+        }
+        return false;
+    }
+
+    // 第一个不小于 key 的位置
+    const_iterator lower_bound(const Key& key) const {
+        const_iterator it;
+        for (const Node* node = m_root; node; ) {
+            if (m_comp(node->value, key)) {
+                node = node->right;
+            } else {
+                it.push(node);
+                node = node->left;
+            }
+        }
+        return it;
+    }
+
+    const_iterator find(const Key& key) const {
+        const_iterator it = lower_bound(key);
+        return it == end() || m_comp(key, *it) ? end() : it;
+    }
+
+    const_iterator begin() const {
+        const_iterator it;
+        it.pushLeftSpine(m_root);
+        return it;
+    }
+    const_iterator end() const { return const_iterator(); }
+
+    qint64 size() const { return m_size; }
+    bool empty() const { return m_size == 0; }
+
+    // 沿较高的一侧下降即得树高
+    int height() const {
+        int h = 0;
+        for (const Node* node = m_root; node; node = node->balance > 0 ? node->right : node->left)
+            ++h;
+        return h;
+    }
+
+    const Node* getRoot() const { return m_root; }
 
 private:
-    TreeNode* root;
-};
+    // 先序分配结点，子树内的结点在内存中相邻；左子树不小于右子树，平衡因子为 0 或 -1
+    Node* build(const Key* keys, qint64 n) {
+        if (n == 0) return nullptr;
+        const qint64 mid = n / 2;
+        Node* node = m_pool.create(keys[mid]);
+        node->left = build(keys, mid);
+        node->right = build(keys + mid + 1, n - mid - 1);
+        node->balance = static_cast<qint8>(perfectHeight(n - mid - 1) - perfectHeight(mid));
+        return node;
+    }
+
+    // 按中点划分构建的 n 个结点的树高，即 n 的二进制位数
+    static int perfectHeight(qint64 n) {
+        int h = 0;
+        for (; n > 0; n >>= 1)
+            ++h;
+        return h;
+    }
+
+    Node* rotateLeft(Node* x) {
+        Counter::add(OpCounter::Rotations);
+        Node* y = x->right;
+        x->right = y->left;
+        y->left = x;
+        return y;
+    }
 
+    Node* rotateRight(Node* y) {
+        Counter::add(OpCounter::Rotations);
+        Node* x = y->left;
+        y->left = x->right;
+        x->right = y;
+        return x;
+    }
+
+    // node 的平衡因子为 ±2，旋转后返回子树新根并修正涉及结点的平衡因子
+    Node* rebalance(Node* node) {
+        if (node->balance > 0) {
+            Node* right = node->right;
+            if (right->balance >= 0) {                   // RR；right 平衡因子为 0 只出现在删除中
+                Node* root = rotateLeft(node);
+                if (right->balance == 0) {
+                    node->balance = 1;
+                    right->balance = -1;
+                } else {
+                    node->balance = 0;
+                    right->balance = 0;
+                }
+                return root;
+            }
+            Node* pivot = right->left;                   // RL
+            node->right = rotateRight(right);
+            Node* root = rotateLeft(node);
+            node->balance = pivot->balance > 0 ? -1 : 0;
+            right->balance = pivot->balance < 0 ? 1 : 0;
+            pivot->balance = 0;
+            return root;
+        }
+
+        Node* left = node->left;
+        if (left->balance <= 0) {                        // LL
+            Node* root = rotateRight(node);
+            if (left->balance == 0) {
+                node->balance = -1;
+                left->balance = 1;
+            } else {
+                node->balance = 0;
+                left->balance = 0;
+            }
+            return root;
+        }
+        Node* pivot = left->right;                       // LR
+        node->left = rotateLeft(left);
+        Node* root = rotateRight(node);
+        node->balance = pivot->balance < 0 ? 1 : 0;
+        left->balance = pivot->balance > 0 ? -1 : 0;
+        pivot->balance = 0;
+        return root;
+    }
+
+    Node* m_root;
+    qint64 m_size;
+    Compare m_comp;
+    NodePool<Node, Allocator> m_pool;
+};
 
 #endif // AVLTREE_H
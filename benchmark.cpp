@@ -0,0 +1,430 @@
+#include "benchmark.h"
+#include "avltree.h"
+#include "bsttree.h"
+#include "btree.h"
+#include "singlylist.h"
+#include "dataset.h"
+#include "radixsort.h"
+#include "introsort.h"
+#include "heapsort.h"
+#include <QElapsedTimer>
+#include <QProcess>
+#include <QtMath>
+#include <algorithm>
+#include <new>
+#include <set>
+
+static const int kProcessTimeoutMs = 600000;   // 外部程序单次运行的超时
+
+// 计时在工作线程中进行，不写界面线程采样的全局操作计数
+typedef AVLTree<int, std::less<int>, std::allocator<int>, NullOpCounter> TimedAVLTree;
+typedef BTree<int, 8, NullOpCounter> TimedBTree;
+
+QString ComplexityFit::modelName(Model model) {
+    switch (model) {
+    case Linear:    return "n";
+    case NLogN:     return "n log n";
+    case Quadratic: return "n²";
+    }
+    return QString();
+}
+
+double ComplexityFit::modelValue(Model model, double n) {
+    switch (model) {
+    case Linear:    return n;
+    case NLogN:     return n * qLn(qMax(2.0, n)) / qLn(2.0);
+    case Quadratic: return n * n;
+    }
+    return n;
+}
+
+QVector<ComplexityFit> ComplexityFit::fit(const QVector<BenchmarkPoint>& points) {
+    QVector<ComplexityFit> fits;
+    for (int m = Linear; m <= Quadratic; ++m) {
+        Model model = static_cast<Model>(m);
+
+        // ln t = ln c + ln f(n)，最小二乘解为对数差的均值
+        double sum = 0;
+        int count = 0;
+        for (const BenchmarkPoint& p : points) {
+            if (p.seconds <= 0) continue;
+            sum += qLn(p.seconds) - qLn(modelValue(model, p.n));
+            ++count;
+        }
+        if (count == 0) continue;
+        double logC = sum / count;
+
+        double residual = 0;
+        for (const BenchmarkPoint& p : points) {
+            if (p.seconds <= 0) continue;
+            double d = qLn(p.seconds) - logC - qLn(modelValue(model, p.n));
+            residual += d * d;
+        }
+        fits.append(ComplexityFit{model, qExp(logC), residual / count});
+    }
+    std::sort(fits.begin(), fits.end(), [](const ComplexityFit& a, const ComplexityFit& b) {
+        return a.residual < b.residual;
+    });
+    return fits;
+}
+
+double ComplexityFit::empiricalExponent(const QVector<BenchmarkPoint>& points) {
+    double sx = 0, sy = 0, sxx = 0, sxy = 0;
+    int count = 0;
+    for (const BenchmarkPoint& p : points) {
+        if (p.seconds <= 0) continue;
+        double x = qLn(p.n);
+        double y = qLn(p.seconds);
+        sx += x; sy += y; sxx += x * x; sxy += x * y;
+        ++count;
+    }
+    double denom = count * sxx - sx * sx;
+    if (count < 2 || qAbs(denom) < 1e-12) return 0;
+    return (count * sxy - sx * sy) / denom;
+}
+
+BenchmarkWorker::BenchmarkWorker(const Config& config, QObject* parent)
+    : QObject(parent), m_config(config), m_cancelled(0), m_startupSeconds(0) {}
+
+QString BenchmarkWorker::targetName(Target target) {
+    switch (target) {
+    case AVLTreeInsert:    return "AVLTree 插入";
+    case AVLTreeBulkInsert: return "AVLTree 区间插入";
+    case StdSetInsert:     return "std::set 插入";
+    case BSTTreeInsert:    return "BSTTree 插入";
+    case BSTTreeSortedInsert: return "BSTTree 有序插入（平衡保护）";
+    case BSTTreeBuildBalanced: return "BSTTree 有序构建";
+    case BTreeInsert:      return "BTree 插入（t = 8）";
+    case BTreeBulkLoad:    return "BTree 批量构建（t = 8）";
+    case LinkedListAppend: return "SinglyLinkedList 尾插";
+    case RadixSortLSD:     return "LSD 基数排序（2^8）";
+    case PdqSort:          return "pdqsort（块划分，九数取中）";
+    case HeapSortD2:       return "堆排序（二叉堆）";
+    case HeapSortD4:       return "堆排序（4 叉堆）";
+    case HeapSortD8:       return "堆排序（8 叉堆）";
+    case HeapSortBottomUp: return "堆排序（二叉堆，自底向上下沉）";
+    case ParallelMergeSort: return "并行归并排序（全部线程）";
+    case ParallelSampleSort: return "并行样本排序（全部线程）";
+    case StdSort:          return "std::sort";
+    case ExternalProgram:  return "temp_code 程序（-O2）";
+    }
+    return QString();
+}
+
+QVector<qint64> BenchmarkWorker::sizes(qint64 minN, qint64 maxN) {
+    QVector<qint64> result;
+    for (int k = 0; ; ++k) {
+        qint64 n = qRound64(100 * qPow(10.0, k / 2.0));
+        if (n > maxN) break;
+        if (n >= minN) result.append(n);
+    }
+    return result;
+}
+
+void BenchmarkWorker::cancel() {
+    m_cancelled.storeRelease(1);
+}
+
+void BenchmarkWorker::run() {
+    if (m_config.target == ExternalProgram) {
+        // 以规模 0 运行一次，估计进程启动开销并在之后扣除
+        if (!runProgram(0, &m_startupSeconds)) {
+            emit finished();
+            return;
+        }
+    }
+
+    for (qint64 n : sizes(m_config.minN, m_config.maxN)) {
+        QVector<double> times;
+        QElapsedTimer budget;
+        budget.start();
+
+        // 至少测一次；时间预算内最多重复 repeats 次
+        for (int r = 0; r < m_config.repeats; ++r) {
+            if (m_cancelled.loadAcquire()) break;
+            double seconds = 0;
+            if (!measureOnce(n, static_cast<quint32>(r + 1), &seconds)) {
+                emit finished();
+                return;
+            }
+            times.append(seconds);
+            if (budget.elapsed() > m_config.budgetMs) break;
+        }
+        if (times.isEmpty()) break;
+
+        std::sort(times.begin(), times.end());
+        emit pointMeasured(BenchmarkPoint{n, times[times.size() / 2], times.size()});
+
+        // 单次运行已超出预算，更大的规模不再测量
+        if (m_cancelled.loadAcquire() || times.first() * 1000 > m_config.budgetMs) break;
+    }
+    emit finished();
+}
+
+bool BenchmarkWorker::measureOnce(qint64 n, quint32 seed, double* seconds) {
+    if (m_config.target == ExternalProgram) {
+        if (!runProgram(n, seconds)) return false;
+        *seconds = qMax(0.0, *seconds - m_startupSeconds);
+        return true;
+    }
+
+    // 输入数据在计时之外生成，结构的释放也不计入
+    const QVector<int> keys = Dataset::generate(Dataset::Random, static_cast<int>(n), seed);
+    QElapsedTimer timer;
+
+    switch (m_config.target) {
+    case AVLTreeInsert: {
+        TimedAVLTree tree;
+        timer.start();
+        for (int key : keys)
+            tree.insert(key);
+        *seconds = timer.nsecsElapsed() / 1e9;
+        break;
+    }
+    case AVLTreeBulkInsert: {
+        TimedAVLTree tree;
+        timer.start();
+        tree.insert(keys.begin(), keys.end());
+        *seconds = timer.nsecsElapsed() / 1e9;
+        break;
+    }
+    case StdSetInsert: {
+        std::set<int> tree;
+        timer.start();
+        for (int key : keys)
+            tree.insert(key);
+        *seconds = timer.nsecsElapsed() / 1e9;
+        break;
+    }
+    case BSTTreeInsert: {
+        BSTTree tree;
+        timer.start();
+        for (int key : keys)
+            tree.insert(key);
+        *seconds = timer.nsecsElapsed() / 1e9;
+        break;
+    }
+    case BSTTreeSortedInsert: {
+        QVector<int> sorted = keys;
+        std::sort(sorted.begin(), sorted.end());
+        BSTTree tree;
+        tree.setBalanceGuard(true);
+        timer.start();
+        for (int key : sorted)
+            tree.insert(key);
+        *seconds = timer.nsecsElapsed() / 1e9;
+        break;
+    }
+    case BSTTreeBuildBalanced: {
+        QVector<int> sorted = keys;
+        std::sort(sorted.begin(), sorted.end());
+        BSTTree tree;
+        timer.start();
+        tree.buildBalanced(sorted);
+        *seconds = timer.nsecsElapsed() / 1e9;
+        break;
+    }
+    case BTreeInsert: {
+        TimedBTree tree;
+        timer.start();
+        for (int key : keys)
+            tree.insert(key);
+        *seconds = timer.nsecsElapsed() / 1e9;
+        break;
+    }
+    case BTreeBulkLoad: {
+        QVector<int> sorted = keys;
+        std::sort(sorted.begin(), sorted.end());
+        TimedBTree tree;
+        timer.start();
+        tree.bulkLoad(sorted.constData(), sorted.size());
+        *seconds = timer.nsecsElapsed() / 1e9;
+        break;
+    }
+    case LinkedListAppend: {
+        SinglyLinkedList list;
+        timer.start();
+        for (int key : keys) {
+            list.insertAtTail(key);
+            if (m_cancelled.loadAcquire()) break;
+        }
+        *seconds = timer.nsecsElapsed() / 1e9;
+        break;
+    }
+    case RadixSortLSD: {
+        QVector<int> a = keys;
+        RadixSort::NullRecorder rec;
+        timer.start();
+        RadixSort::lsd(a, 8, rec);
+        *seconds = timer.nsecsElapsed() / 1e9;
+        break;
+    }
+    case PdqSort: {
+        QVector<int> a = keys;
+        IntroSort::Options options;
+        options.partition = IntroSort::Block;
+        options.pivot = IntroSort::Ninther;
+        options.patternDefeating = true;
+        RadixSort::NullRecorder rec;
+        timer.start();
+        IntroSort::sort(a, options, rec);
+        *seconds = timer.nsecsElapsed() / 1e9;
+        break;
+    }
+    case HeapSortD2:
+    case HeapSortD4:
+    case HeapSortD8:
+    case HeapSortBottomUp: {
+        QVector<int> a = keys;
+        HeapSort::Options options;
+        options.arity = m_config.target == HeapSortD4 ? 4 : m_config.target == HeapSortD8 ? 8 : 2;
+        options.sift = m_config.target == HeapSortBottomUp ? HeapSort::BottomUp : HeapSort::Standard;
+        RadixSort::NullRecorder rec;
+        timer.start();
+        HeapSort::sort(a, options, rec);
+        *seconds = timer.nsecsElapsed() / 1e9;
+        break;
+    }
+    case ParallelMergeSort:
+    case ParallelSampleSort:
+        *seconds = ParallelSort::timeSort(m_config.target == ParallelMergeSort ? ParallelSort::MergeSort : ParallelSort::SampleSort,
+                                          keys, WorkStealingPool::maxWorkers(), 1);
+        break;
+    case StdSort: {
+        QVector<int> a = keys;
+        timer.start();
+        std::sort(a.begin(), a.end());
+        *seconds = timer.nsecsElapsed() / 1e9;
+        break;
+    }
+    default:
+        break;
+    }
+    return true;
+}
+
+bool BenchmarkWorker::runProgram(qint64 n, double* seconds) {
+    QProcess process;
+    QElapsedTimer timer;
+    timer.start();
+    process.start(m_config.program, QStringList() << QString::number(n));
+    if (!process.waitForStarted()) {
+        emit failed("无法启动程序：" + m_config.program);
+        return false;
+    }
+    if (!process.waitForFinished(kProcessTimeoutMs)) {
+        process.kill();
+        emit failed(QString("程序在规模 %1 下运行超时").arg(n));
+        return false;
+    }
+    *seconds = timer.nsecsElapsed() / 1e9;
+
+    if (process.exitStatus() != QProcess::NormalExit || process.exitCode() != 0) {
+        emit failed(QString("程序在规模 %1 下异常退出（退出码 %2）").arg(n).arg(process.exitCode()));
+        return false;
+    }
+    return true;
+}
+
+SpeedupWorker::SpeedupWorker(ParallelSort::Algorithm algorithm, const QVector<int>& input, int maxWorkers, int repeats,
+                             QObject* parent)
+    : QObject(parent), m_algorithm(algorithm), m_input(input), m_maxWorkers(maxWorkers), m_repeats(repeats), m_cancelled(0) {}
+
+void SpeedupWorker::cancel() {
+    m_cancelled.storeRelease(1);
+}
+
+void SpeedupWorker::run() {
+    for (int workers = 1; workers <= m_maxWorkers; ++workers) {
+        QVector<double> times;
+        for (int r = 0; r < m_repeats && !m_cancelled.loadAcquire(); ++r)
+            times.append(ParallelSort::timeSort(m_algorithm, m_input, workers, 1));
+        if (times.isEmpty()) break;
+        std::sort(times.begin(), times.end());
+        emit measured(workers, times[times.size() / 2]);
+    }
+    emit finished();
+}
+
+const qint64 LayoutSearchWorker::MinBytes;
+
+LayoutSearchWorker::LayoutSearchWorker(qint64 maxBytes, int lookups, QObject* parent)
+    : QObject(parent), m_maxBytes(maxBytes), m_lookups(lookups), m_cancelled(0) {}
+
+QVector<qint64> LayoutSearchWorker::sizes(qint64 maxBytes) {
+    QVector<qint64> result;
+    for (qint64 bytes = MinBytes; bytes <= maxBytes; bytes *= 4)
+        result.append(bytes);
+    return result;
+}
+
+QString LayoutSearchWorker::bytesName(qint64 bytes) {
+    if (bytes >= (1 << 30)) return QString("%1 GB").arg(bytes >> 30);
+    if (bytes >= (1 << 20)) return QString("%1 MB").arg(bytes >> 20);
+    return QString("%1 KB").arg(bytes >> 10);
+}
+
+void LayoutSearchWorker::cancel() {
+    m_cancelled.storeRelease(1);
+}
+
+void LayoutSearchWorker::run() {
+    for (qint64 bytes : sizes(m_maxBytes)) {
+        for (int k = 0; k < SearchLayout::KindCount; ++k) {
+            if (m_cancelled.loadAcquire()) {
+                emit finished();
+                return;
+            }
+            double nanos = 0;
+            try {
+                nanos = SearchLayout::nanosPerLookup(static_cast<SearchLayout::Kind>(k), bytes / sizeof(int), m_lookups, 1);
+            } catch (const std::bad_alloc&) {
+                emit failed(QString("内存不足，无法构建 %1 的数组").arg(bytesName(bytes)));
+                emit finished();
+                return;
+            }
+            emit measured(bytes, k, nanos);
+        }
+    }
+    emit finished();
+}
+
+BTreeOrderWorker::BTreeOrderWorker(int n, int lookups, QObject* parent)
+    : QObject(parent), m_n(n), m_lookups(lookups), m_cancelled(0) {}
+
+void BTreeOrderWorker::cancel() {
+    m_cancelled.storeRelease(1);
+}
+
+void BTreeOrderWorker::run() {
+    for (int degree : AnyBTree::supportedDegrees()) {
+        if (m_cancelled.loadAcquire()) break;
+        AnyBTree::Timing timing;
+        try {
+            timing = AnyBTree::measure(degree, m_n, m_lookups, 1);
+        } catch (const std::bad_alloc&) {
+            emit failed(QString("内存不足，无法构建 %1 个键的 B 树").arg(m_n));
+            break;
+        }
+        emit measured(degree, timing.insertNanos, timing.lookupNanos, timing.height);
+    }
+    emit finished();
+}
+
+BTreeBulkWorker::BTreeBulkWorker(int minDegree, const QVector<int>& input, double fill, QObject* parent)
+    : QObject(parent), m_minDegree(minDegree), m_input(input), m_fill(fill), m_cancelled(0) {}
+
+void BTreeBulkWorker::cancel() {
+    m_cancelled.storeRelease(1);
+}
+
+void BTreeBulkWorker::run() {
+    AnyBTree::BulkTiming timing;
+    try {
+        if (AnyBTree::measureBulkLoad(m_minDegree, m_input, m_fill, &m_cancelled, &timing))
+            emit measured(timing.bulkMs, timing.bulkHeight, timing.insertMs, timing.insertHeight);
+    } catch (const std::bad_alloc&) {
+        emit failed(QString("内存不足，无法构建 %1 个键的 B 树").arg(m_input.size()));
+    }
+    emit finished();
+}
@@ -0,0 +1,193 @@
+#ifndef BENCHMARK_H
+#define BENCHMARK_H
+
+#include "parallelsort.h"
+#include "searchlayout.h"
+#include <QObject>
+#include <QString>
+#include <QVector>
+#include <QAtomicInt>
+#include <QMetaType>
+
+// 某一规模下的测量结果
+struct BenchmarkPoint {
+    qint64 n;
+    double seconds;    // 多次重复的中位数
+    int repeats;
+};
+Q_DECLARE_METATYPE(BenchmarkPoint)
+
+// 增长模型拟合结果：t ≈ coefficient · f(n)
+struct ComplexityFit {
+    enum Model {
+        Linear,       // n
+        NLogN,        // n log n
+        Quadratic     // n²
+    };
+
+    Model model;
+    double coefficient;
+    double residual;   // 对数空间的均方残差，越小越贴合
+
+    static QString modelName(Model model);
+    static double modelValue(Model model, double n);
+
+    // 对三种模型分别拟合，按残差从小到大排序
+    static QVector<ComplexityFit> fit(const QVector<BenchmarkPoint>& points);
+    // 双对数坐标下的线性回归斜率，即经验阶数
+    static double empiricalExponent(const QVector<BenchmarkPoint>& points);
+};
+
+// 规模测试：在工作线程中以几何增长的 n 原生运行算法（不产生轨迹），逐点报告计时中位数
+class BenchmarkWorker : public QObject {
+    Q_OBJECT
+
+public:
+    enum Target {
+        AVLTreeInsert,
+        AVLTreeBulkInsert,  // 空树上的区间插入：排序去重后 O(n) 构建
+        StdSetInsert,       // std::set 逐个插入，作为 AVLTree 的参照
+        BSTTreeInsert,
+        BSTTreeSortedInsert, // 有序键逐个插入，开启平衡保护（替罪羊子树重建）
+        BSTTreeBuildBalanced, // 有序键一次构建完全平衡的树
+        BTreeInsert,
+        BTreeBulkLoad,      // 有序键自底向上逐层装填（t = 8，满填充），O(n) 且没有分裂
+        LinkedListAppend,
+        RadixSortLSD,       // LSD 基数排序（2^8），与下面的比较排序对照
+        PdqSort,            // pdq 模式内省排序（块划分、九数取中）
+        HeapSortD2,         // d 叉堆排序，d = 2 / 4 / 8：层数与缓存行利用率的对照
+        HeapSortD4,
+        HeapSortD8,
+        HeapSortBottomUp,   // 二叉堆，自底向上下沉：比较次数约为标准下沉的一半
+        ParallelMergeSort,  // 并行归并排序，使用全部硬件线程
+        ParallelSampleSort, // 并行样本排序，使用全部硬件线程
+        StdSort,
+        ExternalProgram     // 用户代码的优化构建 temp_code_bench，argv[1] 为规模
+    };
+
+    struct Config {
+        Target target;
+        qint64 minN;
+        qint64 maxN;
+        int repeats;
+        qint64 budgetMs;    // 单个规模的时间预算，超出后不再继续增大规模
+        QString program;    // ExternalProgram 的可执行文件路径
+    };
+
+    explicit BenchmarkWorker(const Config& config, QObject* parent = nullptr);
+
+    static QString targetName(Target target);
+    static QVector<qint64> sizes(qint64 minN, qint64 maxN);   // 每十倍取两个点
+
+    void run();         // 在工作线程中执行
+    void cancel();      // 可从任意线程调用
+
+signals:
+    void pointMeasured(const BenchmarkPoint& point);
+    void failed(const QString& message);
+    void finished();
+
+private:
+    bool measureOnce(qint64 n, quint32 seed, double* seconds);
+    bool runProgram(qint64 n, double* seconds);
+
+    Config m_config;
+    QAtomicInt m_cancelled;
+    double m_startupSeconds;    // 外部程序的进程启动开销
+};
+
+// 加速比测试：同一数据集上依次以 1…maxWorkers 个工作者计时，逐点报告中位数
+class SpeedupWorker : public QObject {
+    Q_OBJECT
+
+public:
+    SpeedupWorker(ParallelSort::Algorithm algorithm, const QVector<int>& input, int maxWorkers, int repeats,
+                  QObject* parent = nullptr);
+
+    void run();         // 在工作线程中执行
+    void cancel();      // 可从任意线程调用
+
+signals:
+    void measured(int workers, double seconds);
+    void finished();
+
+private:
+    ParallelSort::Algorithm m_algorithm;
+    QVector<int> m_input;
+    int m_maxWorkers;
+    int m_repeats;
+    QAtomicInt m_cancelled;
+};
+
+// 查找布局测试：数组大小从 MinBytes 起按 4 倍增长到 maxBytes，三种布局各做 lookups 次随机查找，
+// 逐点报告每次查找的平均纳秒数；每个布局单独构建、测完即释放
+class LayoutSearchWorker : public QObject {
+    Q_OBJECT
+
+public:
+    static const qint64 MinBytes = 1024;
+
+    LayoutSearchWorker(qint64 maxBytes, int lookups, QObject* parent = nullptr);
+
+    static QVector<qint64> sizes(qint64 maxBytes);
+    static QString bytesName(qint64 bytes);     // 1 KB、256 MB 等
+
+    void run();         // 在工作线程中执行
+    void cancel();      // 可从任意线程调用
+
+signals:
+    void measured(qint64 bytes, int kind, double nanos);
+    void failed(const QString& message);
+    void finished();
+
+private:
+    qint64 m_maxBytes;
+    int m_lookups;
+    QAtomicInt m_cancelled;
+};
+
+// B 树阶数测试：对每个支持的最小度数 t 插入 n 个随机键，再做 lookups 次随机查找（一半命中），
+// 逐点报告每次插入与查找的平均纳秒数；每棵树单独构建、测完即释放
+class BTreeOrderWorker : public QObject {
+    Q_OBJECT
+
+public:
+    BTreeOrderWorker(int n, int lookups, QObject* parent = nullptr);
+
+    void run();         // 在工作线程中执行
+    void cancel();      // 可从任意线程调用
+
+signals:
+    void measured(int minDegree, double insertNanos, double lookupNanos, int height);
+    void failed(const QString& message);
+    void finished();
+
+private:
+    int m_n;
+    int m_lookups;
+    QAtomicInt m_cancelled;
+};
+
+// B 树批量构建与逐个插入的对比：完整数据集可达千万个键，排序与两次构建都在工作线程中进行
+class BTreeBulkWorker : public QObject {
+    Q_OBJECT
+
+public:
+    BTreeBulkWorker(int minDegree, const QVector<int>& input, double fill, QObject* parent = nullptr);
+
+    void run();         // 在工作线程中执行
+    void cancel();      // 可从任意线程调用
+
+signals:
+    void measured(double bulkMs, int bulkHeight, double insertMs, int insertHeight);
+    void failed(const QString& message);
+    void finished();
+
+private:
+    int m_minDegree;
+    QVector<int> m_input;
+    double m_fill;
+    QAtomicInt m_cancelled;
+};
+
+#endif // BENCHMARK_H
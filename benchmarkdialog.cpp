@@ -0,0 +1,263 @@
+#include "benchmarkdialog.h"
+#include <QHBoxLayout>
+#include <QVBoxLayout>
+#include <QCloseEvent>
+#include <QtMath>
+
+static const qint64 kMinN = 100;
+static const qint64 kBudgetMs = 2000;      // 单个规模的时间预算
+static const qreal kChartMargin = 36;
+
+// 坐标轴取整到十的幂
+static qreal floorDecade(qreal v) { return qPow(10.0, qFloor(std::log10(v))); }
+static qreal ceilDecade(qreal v)  { return qPow(10.0, qCeil(std::log10(v))); }
+
+static QColor modelColor(ComplexityFit::Model model) {
+    switch (model) {
+    case ComplexityFit::Linear:    return QColor("#98C379");
+    case ComplexityFit::NLogN:     return QColor("#61AFEF");
+    case ComplexityFit::Quadratic: return QColor("#E06C75");
+    }
+    return QColor("#ABB2BF");
+}
+
+ScalingChart::ScalingChart(QWidget* parent)
+    : QWidget(parent) {
+    setMinimumSize(420, 280);
+}
+
+void ScalingChart::setPoints(const QVector<BenchmarkPoint>& points, const QVector<ComplexityFit>& fits) {
+    m_points = points;
+    m_fits = fits;
+    update();
+}
+
+void ScalingChart::paintEvent(QPaintEvent* event) {
+    Q_UNUSED(event);
+    QPainter painter(this);
+    painter.setRenderHint(QPainter::Antialiasing);
+    painter.setFont(QFont("Segoe UI", 8));
+
+    const QRectF area = QRectF(rect()).adjusted(kChartMargin + 12, 10, -10, -kChartMargin);
+    painter.setPen(QPen(QColor("#555555"), 1));
+    painter.drawLine(area.bottomLeft(), area.bottomRight());
+    painter.drawLine(area.bottomLeft(), area.topLeft());
+
+    QVector<BenchmarkPoint> valid;
+    for (const BenchmarkPoint& p : m_points)
+        if (p.seconds > 0) valid.append(p);
+    if (valid.isEmpty()) return;
+
+    // 坐标范围：横轴覆盖所有规模，纵轴覆盖所有测量值
+    qreal minN = valid.first().n, maxN = minN, minT = valid.first().seconds, maxT = minT;
+    for (const BenchmarkPoint& p : valid) {
+        minN = qMin<qreal>(minN, p.n); maxN = qMax<qreal>(maxN, p.n);
+        minT = qMin(minT, p.seconds); maxT = qMax(maxT, p.seconds);
+    }
+    minN = floorDecade(minN); maxN = qMax(ceilDecade(maxN), minN * 10);
+    minT = floorDecade(minT); maxT = qMax(ceilDecade(maxT), minT * 10);
+
+    const qreal lx0 = std::log10(minN), lx1 = std::log10(maxN);
+    const qreal ly0 = std::log10(minT), ly1 = std::log10(maxT);
+    auto toPoint = [&](qreal n, qreal t) {
+        return QPointF(area.left() + area.width() * (std::log10(n) - lx0) / (lx1 - lx0),
+                       area.bottom() - area.height() * (std::log10(t) - ly0) / (ly1 - ly0));
+    };
+
+    // 十倍刻度
+    painter.setPen(QPen(QColor("#444444"), 1, Qt::DotLine));
+    for (qreal n = minN; n <= maxN * 1.001; n *= 10) {
+        QPointF p = toPoint(n, minT);
+        painter.drawLine(QPointF(p.x(), area.top()), QPointF(p.x(), area.bottom()));
+    }
+    for (qreal t = minT; t <= maxT * 1.001; t *= 10) {
+        QPointF p = toPoint(minN, t);
+        painter.drawLine(QPointF(area.left(), p.y()), QPointF(area.right(), p.y()));
+    }
+    painter.setPen(QColor("#ABB2BF"));
+    for (qreal n = minN; n <= maxN * 1.001; n *= 10) {
+        QPointF p = toPoint(n, minT);
+        painter.drawText(QRectF(p.x() - 30, area.bottom() + 4, 60, 14), Qt::AlignCenter,
+                         QString("1e%1").arg(qRound(std::log10(n))));
+    }
+    for (qreal t = minT; t <= maxT * 1.001; t *= 10) {
+        QPointF p = toPoint(minN, t);
+        painter.drawText(QRectF(0, p.y() - 7, area.left() - 4, 14), Qt::AlignRight | Qt::AlignVCenter,
+                         QString("1e%1s").arg(qRound(std::log10(t))));
+    }
+    painter.drawText(QRectF(area.left(), area.bottom() + 18, area.width(), 14), Qt::AlignCenter, "n");
+
+    // 参考线：c · f(n)，虚线，截取到纵轴范围内
+    const int kSteps = 48;
+    for (const ComplexityFit& fit : m_fits) {
+        QVector<QPointF> line;
+        for (int i = 0; i <= kSteps; ++i) {
+            qreal n = qPow(10.0, lx0 + (lx1 - lx0) * i / kSteps);
+            qreal t = fit.coefficient * ComplexityFit::modelValue(fit.model, n);
+            if (t < minT || t > maxT) continue;
+            line.append(toPoint(n, t));
+        }
+        if (line.size() < 2) continue;
+        painter.setPen(QPen(modelColor(fit.model), 1, Qt::DashLine));
+        painter.drawPolyline(line.constData(), line.size());
+    }
+
+    // 实测点
+    QVector<QPointF> measured;
+    for (const BenchmarkPoint& p : valid)
+        measured.append(toPoint(p.n, p.seconds));
+    painter.setPen(QPen(QColor("#E5C07B"), 2));
+    painter.drawPolyline(measured.constData(), measured.size());
+    painter.setBrush(QColor("#E5C07B"));
+    for (const QPointF& p : measured)
+        painter.drawEllipse(p, 3, 3);
+
+    // 图例
+    qreal y = area.top() + 4;
+    for (int m = ComplexityFit::Linear; m <= ComplexityFit::Quadratic; ++m) {
+        ComplexityFit::Model model = static_cast<ComplexityFit::Model>(m);
+        painter.setPen(QPen(modelColor(model), 1, Qt::DashLine));
+        painter.drawLine(QPointF(area.left() + 10, y + 6), QPointF(area.left() + 30, y + 6));
+        painter.setPen(QColor("#ABB2BF"));
+        painter.drawText(QPointF(area.left() + 36, y + 10), ComplexityFit::modelName(model));
+        y += 16;
+    }
+}
+
+BenchmarkDialog::BenchmarkDialog(const QString& program, QWidget* parent)
+    : QDialog(parent), m_program(program), m_thread(nullptr), m_worker(nullptr) {
+    qRegisterMetaType<BenchmarkPoint>("BenchmarkPoint");
+
+    setWindowTitle("规模测试");
+    setStyleSheet("background-color:#333333; color:#ABB2BF;");
+
+    QString buttonStyle =
+        "QToolButton { background-color: transparent; border: none; padding: 3px; color:#ABB2BF; font-weight:bold; }"
+        "QToolButton:hover { background-color: rgba(255, 255, 255, 30); }"
+        "QToolButton:disabled { color:#666666; }";
+
+    m_targetCombo = new QComboBox;
+    for (int t = BenchmarkWorker::AVLTreeInsert; t <= BenchmarkWorker::ExternalProgram; ++t)
+        m_targetCombo->addItem(BenchmarkWorker::targetName(static_cast<BenchmarkWorker::Target>(t)), t);
+    m_targetCombo->setToolTip("temp_code 程序需先构建（使用 -O2 优化版本），程序以 argv[1] 接收规模 n，"
+                              "n = 0 时只应测出启动开销，退出码非 0 视为运行失败");
+
+    m_maxNCombo = new QComboBox;
+    for (qint64 n : {100000LL, 1000000LL, 10000000LL})
+        m_maxNCombo->addItem(QString("n ≤ %1").arg(n), n);
+    m_maxNCombo->setCurrentIndex(1);
+
+    QLabel* repeatsLabel = new QLabel("重复");
+    m_repeatsSpinBox = new QSpinBox;
+    m_repeatsSpinBox->setRange(1, 50);
+    m_repeatsSpinBox->setValue(5);
+    m_repeatsSpinBox->setToolTip("每个规模重复测量的次数，取中位数");
+
+    m_startButton = new QToolButton;
+    m_startButton->setText("开始");
+    m_startButton->setStyleSheet(buttonStyle);
+    m_stopButton = new QToolButton;
+    m_stopButton->setText("停止");
+    m_stopButton->setStyleSheet(buttonStyle);
+    m_stopButton->setEnabled(false);
+
+    QHBoxLayout* controls = new QHBoxLayout;
+    controls->addWidget(m_targetCombo);
+    controls->addWidget(m_maxNCombo);
+    controls->addWidget(repeatsLabel);
+    controls->addWidget(m_repeatsSpinBox);
+    controls->addStretch();
+    controls->addWidget(m_startButton);
+    controls->addWidget(m_stopButton);
+
+    m_chart = new ScalingChart;
+    m_resultLabel = new QLabel("选择测试对象后点击开始");
+
+    QVBoxLayout* layout = new QVBoxLayout(this);
+    layout->addLayout(controls);
+    layout->addWidget(m_chart, 1);
+    layout->addWidget(m_resultLabel);
+
+    connect(m_startButton, &QToolButton::clicked, this, &BenchmarkDialog::start);
+    connect(m_stopButton, &QToolButton::clicked, this, &BenchmarkDialog::stop);
+}
+
+BenchmarkDialog::~BenchmarkDialog() {
+    stop();
+}
+
+void BenchmarkDialog::closeEvent(QCloseEvent* event) {
+    stop();
+    QDialog::closeEvent(event);
+}
+
+void BenchmarkDialog::start() {
+    if (m_thread) return;
+
+    BenchmarkWorker::Config config;
+    config.target = static_cast<BenchmarkWorker::Target>(m_targetCombo->currentData().toInt());
+    config.minN = kMinN;
+    config.maxN = m_maxNCombo->currentData().toLongLong();
+    config.repeats = m_repeatsSpinBox->value();
+    config.budgetMs = kBudgetMs;
+    config.program = m_program;
+
+    m_points.clear();
+    m_chart->setPoints(m_points, QVector<ComplexityFit>());
+    m_resultLabel->setText("测量中……");
+    m_startButton->setEnabled(false);
+    m_stopButton->setEnabled(true);
+
+    // 工作对象没有父对象，随线程结束一起释放
+    m_thread = new QThread;
+    m_worker = new BenchmarkWorker(config);
+    m_worker->moveToThread(m_thread);
+    connect(m_thread, &QThread::started, m_worker, &BenchmarkWorker::run);
+    connect(m_worker, &BenchmarkWorker::finished, m_thread, &QThread::quit);
+    connect(m_thread, &QThread::finished, m_worker, &QObject::deleteLater);
+    connect(m_thread, &QThread::finished, m_thread, &QObject::deleteLater);
+    connect(m_worker, &BenchmarkWorker::pointMeasured, this, &BenchmarkDialog::onPointMeasured);
+    connect(m_worker, &BenchmarkWorker::failed, this, [=](const QString& message) {
+        m_resultLabel->setText(message);
+    });
+    connect(m_worker, &BenchmarkWorker::finished, this, &BenchmarkDialog::onFinished);
+    m_thread->start();
+}
+
+void BenchmarkDialog::stop() {
+    if (!m_thread) return;
+    m_worker->cancel();
+    m_thread->quit();
+    m_thread->wait();
+    // 线程已退出，deleteLater 由 finished 信号排入主线程事件队列
+    m_thread = nullptr;
+    m_worker = nullptr;
+    m_startButton->setEnabled(true);
+    m_stopButton->setEnabled(false);
+}
+
+void BenchmarkDialog::onPointMeasured(const BenchmarkPoint& point) {
+    m_points.append(point);
+    updateResult();
+}
+
+void BenchmarkDialog::onFinished() {
+    stop();
+    // failed() 已写入错误信息时保留原文
+    if (m_points.size() < 2 && m_resultLabel->text() == "测量中……")
+        m_resultLabel->setText("测量点不足，无法拟合");
+}
+
+void BenchmarkDialog::updateResult() {
+    QVector<ComplexityFit> fits = ComplexityFit::fit(m_points);
+    m_chart->setPoints(m_points, fits);
+    if (m_points.size() < 2 || fits.isEmpty()) {
+        m_resultLabel->setText(QString("n = %1：%2 s").arg(m_points.last().n).arg(m_points.last().seconds));
+        return;
+    }
+    m_resultLabel->setText(QString("经验阶数 ≈ %1，最接近 O(%2)；最大规模 n = %3 耗时 %4 s")
+                           .arg(ComplexityFit::empiricalExponent(m_points), 0, 'f', 2)
+                           .arg(ComplexityFit::modelName(fits.first().model))
+                           .arg(m_points.last().n)
+                           .arg(m_points.last().seconds, 0, 'g', 3));
+}
@@ -0,0 +1,64 @@
+#ifndef BENCHMARKDIALOG_H
+#define BENCHMARKDIALOG_H
+
+#include "benchmark.h"
+#include <QDialog>
+#include <QWidget>
+#include <QComboBox>
+#include <QSpinBox>
+#include <QLabel>
+#include <QToolButton>
+#include <QThread>
+#include <QPainter>
+#include <QPaintEvent>
+#include <QVector>
+
+// 双对数坐标下的规模-耗时曲线，附带按拟合系数缩放的 n、n log n、n² 参考线
+class ScalingChart : public QWidget {
+    Q_OBJECT
+
+public:
+    explicit ScalingChart(QWidget* parent = nullptr);
+    void setPoints(const QVector<BenchmarkPoint>& points, const QVector<ComplexityFit>& fits);
+
+protected:
+    void paintEvent(QPaintEvent* event) override;
+
+private:
+    QVector<BenchmarkPoint> m_points;
+    QVector<ComplexityFit> m_fits;
+};
+
+// 规模测试对话框：选择测试对象与最大规模，在工作线程中测量并给出经验阶数
+class BenchmarkDialog : public QDialog {
+    Q_OBJECT
+
+public:
+    explicit BenchmarkDialog(const QString& program, QWidget* parent = nullptr);
+    ~BenchmarkDialog();
+
+protected:
+    void closeEvent(QCloseEvent* event) override;
+
+private:
+    void start();
+    void stop();                                   // 取消测量并等待工作线程退出
+    void onPointMeasured(const BenchmarkPoint& point);
+    void onFinished();
+    void updateResult();
+
+    QString m_program;
+    QComboBox* m_targetCombo;
+    QComboBox* m_maxNCombo;
+    QSpinBox* m_repeatsSpinBox;
+    QToolButton* m_startButton;
+    QToolButton* m_stopButton;
+    QLabel* m_resultLabel;
+    ScalingChart* m_chart;
+
+    QThread* m_thread;
+    BenchmarkWorker* m_worker;
+    QVector<BenchmarkPoint> m_points;
+};
+
+#endif // BENCHMARKDIALOG_H
@@ -1,25 +1,34 @@
 #include "bsttree.h"
+#include <cmath>
 
-BSTTree::BSTTree() : root(nullptr) {}
+BSTTree::BSTTree() : root(nullptr), count(0), guard(false) {}
 
 BSTTree::~BSTTree() {
     clear();
 }
 
-TreeNode* BSTTree::insert(TreeNode *node, int value) {
-    if (node == nullptr) {
-        return new TreeNode(value);
+TreeNode* BSTTree::insert(int value) {
+    TreeNode** link = &root;
+    if (!guard) {
+        while (*link)
+            link = value < (*link)->value ? &(*link)->left : &(*link)->right;
+        *link = pool.create(value);
+        ++count;
+        return root;
     }
-    if (value < node->value) {
-        node->left = insert(node->left, value);
-    } else {
-        node->right = insert(node->right, value);
+
+    QVector<TreeNode**> path;
+    while (*link) {
+        path.append(link);
+        link = value < (*link)->value ? &(*link)->left : &(*link)->right;
     }
-    return node;
-}
+    *link = pool.create(value);
+    ++count;
 
-TreeNode* BSTTree::insert(int value) {
-    root = insert(root, value);
+    // 深度上限 log_{3/2} n
+    const int depthLimit = static_cast<int>(std::log(static_cast<double>(count)) / std::log(1.5));
+    if (path.size() > depthLimit)
+        rebuildScapegoat(path, *link);
     return root;
 }
 
@@ -27,32 +36,137 @@ TreeNode* BSTTree::getRoot() const {
     return root;
 }
 
-TreeNode* BSTTree::find(TreeNode *node, int value) const {
-    if (node == nullptr) {
-        return nullptr;
+TreeNode* BSTTree::find(int value) const {
+    TreeNode* node = root;
+    while (node && node->value != value)
+        node = value < node->value ? node->left : node->right;
+    return node;
+}
+
+void BSTTree::clear() {
+    pool.release();
+    root = nullptr;
+    count = 0;
+}
+
+void BSTTree::buildBalanced(const QVector<int>& sorted) {
+    clear();
+    root = build(sorted.constData(), sorted.size());
+    count = sorted.size();
+}
+
+// 先序创建结点，子树在内存中相邻；递归深度为 log2 n
+TreeNode* BSTTree::build(const int* sorted, int n) {
+    if (n == 0) return nullptr;
+    const int mid = n / 2;
+    TreeNode* node = pool.create(sorted[mid]);
+    node->left = build(sorted, mid);
+    node->right = build(sorted + mid + 1, n - mid - 1);
+    return node;
+}
+
+void BSTTree::rebalance() {
+    rebalanceAt(&root, count);
+}
+
+// 把 *link 为根、共 size 个结点的子树原地重建为完全平衡的树
+void BSTTree::rebalanceAt(TreeNode** link, qint64 size) {
+    TreeNode pseudo(0);             // 伪根，右孩子为待重建的子树
+    pseudo.right = *link;
+
+    // 右旋消去所有左孩子，得到按中序排列的右单链
+    TreeNode* tail = &pseudo;
+    TreeNode* rest = tail->right;
+    while (rest) {
+        if (!rest->left) {
+            tail = rest;
+            rest = rest->right;
+        } else {
+            TreeNode* left = rest->left;
+            rest->left = left->right;
+            left->right = rest;
+            rest = left;
+            tail->right = left;
+        }
     }
-    if (node->value == value) {
-        return node;
-    } else if (value < node->value) {
-        return find(node->left, value);
-    } else {
-        return find(node->right, value);
+
+    // 沿单链每隔一个结点左旋一次，count 次旋转把单链的前 2·count 个结点折成 count 棵两结点子树
+    auto compress = [&pseudo](qint64 rotations) {
+        TreeNode* scanner = &pseudo;
+        for (qint64 i = 0; i < rotations; ++i) {
+            TreeNode* child = scanner->right;
+            scanner->right = child->right;
+            scanner = scanner->right;
+            child->right = scanner->left;
+            scanner->left = child;
+        }
+    };
+
+    // 先把多出满二叉树的结点压到最底层，再逐轮减半
+    qint64 full = 1;
+    while (full * 2 <= size + 1)
+        full *= 2;
+    compress(size + 1 - full);
+    for (qint64 remaining = full - 1; remaining > 1; remaining /= 2)
+        compress(remaining / 2);
+
+    *link = pseudo.right;
+}
+
+// path[i] 为插入路径上第 i 层结点的链接，inserted 为新结点
+void BSTTree::rebuildScapegoat(const QVector<TreeNode**>& path, TreeNode* inserted) {
+    const TreeNode* child = inserted;
+    qint64 childSize = 1;
+    for (int i = path.size() - 1; i >= 0; --i) {
+        const TreeNode* node = *path[i];
+        const TreeNode* sibling = node->left == child ? node->right : node->left;
+        const qint64 nodeSize = childSize + 1 + subtreeSize(sibling);
+        if (3 * childSize > 2 * nodeSize) {
+            rebalanceAt(path[i], nodeSize);
+            return;
+        }
+        child = node;
+        childSize = nodeSize;
     }
 }
 
-TreeNode* BSTTree::find(int value) const {
-    return find(root, value);
+qint64 BSTTree::subtreeSize(const TreeNode* node) {
+    qint64 size = 0;
+    QVector<const TreeNode*> stack;
+    if (node) stack.append(node);
+    while (!stack.isEmpty()) {
+        const TreeNode* current = stack.takeLast();
+        ++size;
+        if (current->left) stack.append(current->left);
+        if (current->right) stack.append(current->right);
+    }
+    return size;
 }
 
-void BSTTree::clear(TreeNode *node) {
-    if (node == nullptr) return;
-    clear(node->left);
-    clear(node->right);
-    delete node;
+void BSTTree::setBalanceGuard(bool enabled) {
+    guard = enabled;
 }
 
-void BSTTree::clear() {
-    clear(root);
-    root = nullptr;
+bool BSTTree::balanceGuard() const {
+    return guard;
 }
 
+qint64 BSTTree::size() const {
+    return count;
+}
+
+int BSTTree::height() const {
+    int levels = 0;
+    QVector<const TreeNode*> level;
+    if (root) level.append(root);
+    while (!level.isEmpty()) {
+        ++levels;
+        QVector<const TreeNode*> next;
+        for (const TreeNode* node : level) {
+            if (node->left) next.append(node->left);
+            if (node->right) next.append(node->right);
+        }
+        level.swap(next);
+    }
+    return levels;
+}
@@ -2,7 +2,11 @@
 #define BSTTREE_H
 
 #include "binarytree.h"
+#include "nodepool.h"
+#include <QVector>
 
+// 二叉排序树：插入、查找均为迭代实现，有序输入形成的单链也不会耗尽调用栈
+// 相等的值放入右子树；可选的平衡保护在插入过深时重建替罪羊子树，保持高度为 O(log n)
 class BSTTree {
 public:
     BSTTree();
@@ -11,13 +15,31 @@ public:
     TreeNode* insert(int value);
     TreeNode* getRoot() const;
     TreeNode* find(int value) const;
-    TreeNode* insert(TreeNode *node, int value);
-    TreeNode* find(TreeNode *node, int value) const;
-    void clear(TreeNode *node);
-    void clear();
+    void clear();                   // 整块归还结点，不遍历
+
+    // 以有序序列构建完全平衡的树（原有结点被清空），O(n)
+    void buildBalanced(const QVector<int>& sorted);
+    // Day-Stout-Warren：先右旋成右单链，再逐轮左旋压缩为完全平衡的树，O(n) 时间、O(1) 额外空间
+    void rebalance();
+
+    // 开启后，插入深度超过 log_{3/2} n 时沿插入路径找到第一个“孩子大小超过自身 2/3”的祖先并重建其子树，
+    // 均摊 O(log n)；可视化需要保持原始形状，默认关闭
+    void setBalanceGuard(bool enabled);
+    bool balanceGuard() const;
+
+    qint64 size() const;
+    int height() const;             // 逐层遍历计算，不递归
 
 private:
+    TreeNode* build(const int* sorted, int n);
+    void rebalanceAt(TreeNode** link, qint64 size);
+    void rebuildScapegoat(const QVector<TreeNode**>& path, TreeNode* inserted);
+    static qint64 subtreeSize(const TreeNode* node);
+
     TreeNode *root;
+    qint64 count;
+    bool guard;
+    NodePool<TreeNode> pool;
 
 };
 
@@ -1,267 +1,141 @@
 #include "btree.h"
-
-
-BTreeNode::BTreeNode(bool isLeaf) : isLeaf(isLeaf), numKeys(0) {
-    for (int i = 0; i < 2 * DEGREE; i++) children[i] = nullptr;
-}
-
-BTreeNode::~BTreeNode() {
-    for (int i = 0; i <= numKeys; i++) {
-        delete children[i];
+#include <QElapsedTimer>
+#include <QRandomGenerator>
+#include <algorithm>
+
+static volatile qint64 s_sink;   // 接收查找结果，防止计时循环被整体优化掉
+
+namespace {
+
+// 把某个阶数的 BTree<int, t> 包装成 AnyBTree；各阶数的实例化都集中在本文件
+template <int MinDegree>
+class BTreeAdapter : public AnyBTree {
+public:
+    typedef BTree<int, MinDegree> Tree;
+    typedef BTree<int, MinDegree, NullOpCounter> TimedTree;   // 在工作线程中计时，不写全局操作计数
+
+    int minDegree() const override { return MinDegree; }
+    void insert(int key) override { m_tree.insert(key); }
+    void remove(int key) override { m_tree.remove(key); }
+    bool contains(int key) const override { return m_tree.contains(key); }
+    void clear() override { m_tree.clear(); }
+    void bulkLoad(const int* sorted, qint64 n, double fill) override { m_tree.bulkLoad(sorted, n, fill); }
+    qint64 size() const override { return m_tree.size(); }
+    int height() const override { return m_tree.height(); }
+
+    Node root() const override { return m_tree.getRoot(); }
+    int keyCount(Node node) const override { return cast(node)->numKeys; }
+    int key(Node node, int i) const override { return cast(node)->keys[i]; }
+    bool isLeaf(Node node) const override { return cast(node)->isLeaf; }
+    Node child(Node node, int i) const override { return cast(node)->children[i]; }
+    int leafSpan(Node node) const override { return Tree::leafSpan(cast(node)); }
+
+    static Timing measure(int n, int lookups, quint32 seed) {
+        QRandomGenerator rng(seed);
+        QVector<int> keys(n);
+        for (int& key : keys)
+            key = static_cast<int>(rng.generate() >> 1);
+        QVector<int> queries(lookups);
+        for (int& query : queries)
+            query = keys.isEmpty() || rng.bounded(2) ? static_cast<int>(rng.generate() >> 1) : keys[rng.bounded(n)];
+
+        Timing timing;
+        TimedTree tree;
+        QElapsedTimer timer;
+        timer.start();
+        for (int key : keys)
+            tree.insert(key);
+        timing.insertNanos = n > 0 ? static_cast<double>(timer.nsecsElapsed()) / n : 0;
+
+        qint64 found = 0;
+        timer.restart();
+        for (int query : queries)
+            found += tree.contains(query);
+        timing.lookupNanos = lookups > 0 ? static_cast<double>(timer.nsecsElapsed()) / lookups : 0;
+        s_sink = found;
+        timing.height = tree.height();
+        return timing;
     }
-}
 
-void BTreeNode::insertNonFull(int key) {
-    int i = numKeys - 1;
-    if (isLeaf) {
-        while (i >= 0 && keys[i] > key) {
-            keys[i + 1] = keys[i];
-            i--;
+    static bool measureBulkLoad(const QVector<int>& input, double fill, const QAtomicInt* cancelled,
+                                BulkTiming* timing) {
+        QElapsedTimer timer;
+        {
+            QVector<int> sorted = input;
+            std::sort(sorted.begin(), sorted.end());
+            if (cancelled->loadAcquire()) return false;
+            TimedTree tree;
+            timer.start();
+            tree.bulkLoad(sorted.constData(), sorted.size(), fill);
+            timing->bulkMs = timer.nsecsElapsed() / 1e6;
+            timing->bulkHeight = tree.height();
         }
-        keys[i + 1] = key;
-        numKeys++;
-    } else {
-        while (i >= 0 && keys[i] > key)
-            i--;
-        if (children[i + 1]->numKeys == 2 * DEGREE - 1) {
-            splitChild(i + 1, children[i + 1]);
-            if (key > keys[i + 1]) i++;
+        {
+            TimedTree tree;
+            timer.restart();
+            for (int i = 0; i < input.size(); ++i) {
+                if ((i & 0xFFFF) == 0 && cancelled->loadAcquire()) return false;
+                tree.insert(input[i]);
+            }
+            timing->insertMs = timer.nsecsElapsed() / 1e6;
+            timing->insertHeight = tree.height();
         }
-        children[i + 1]->insertNonFull(key);
+        return true;
     }
-}
-
-void BTreeNode::splitChild(int i, BTreeNode* y) {
-    BTreeNode* z = new BTreeNode(y->isLeaf);
-    z->numKeys = DEGREE - 1;
 
-    for (int j = 0; j < DEGREE - 1; j++)
-        z->keys[j] = y->keys[j + DEGREE];
-
-    if (!y->isLeaf) {
-        for (int j = 0; j < DEGREE; j++)
-            z->children[j] = y->children[j + DEGREE];
+private:
+    static const typename Tree::Node* cast(Node node) {
+        return static_cast<const typename Tree::Node*>(node);
     }
 
-    y->numKeys = DEGREE - 1;
-
-    for (int j = numKeys; j >= i + 1; j--)
-        children[j + 1] = children[j];
+    Tree m_tree;
+};
 
-    children[i + 1] = z;
-
-    for (int j = numKeys - 1; j >= i; j--)
-        keys[j + 1] = keys[j];
-
-    keys[i] = y->keys[DEGREE - 1];
-    numKeys++;
 }
 
-BTreeNode* BTreeNode::search(int key) {
-    int i = 0;
-    while (i < numKeys && key > keys[i]) i++;
-    if (i < numKeys && keys[i] == key) return this;
-    if (isLeaf) return nullptr;
-    return children[i]->search(key);
-}
-
-void BTreeNode::remove(int key) {
-    int idx = 0;
-    while (idx < numKeys && keys[idx] < key) ++idx;
-    if (idx < numKeys && keys[idx] == key) {
-        if (isLeaf) removeFromLeaf(idx);
-        else removeFromNonLeaf(idx);
-    } else {
-        if (isLeaf) return;
-        bool flag = (idx == numKeys);
-        if (children[idx]->numKeys < DEGREE)
-            fill(idx);
-        if (flag && idx > numKeys)
-            children[idx - 1]->remove(key);
-        else
-            children[idx]->remove(key);
+AnyBTree* AnyBTree::create(int minDegree) {
+    switch (minDegree) {
+    case 3:   return new BTreeAdapter<3>;
+    case 4:   return new BTreeAdapter<4>;
+    case 8:   return new BTreeAdapter<8>;
+    case 16:  return new BTreeAdapter<16>;
+    case 32:  return new BTreeAdapter<32>;
+    case 64:  return new BTreeAdapter<64>;
+    case 128: return new BTreeAdapter<128>;
+    case 256: return new BTreeAdapter<256>;
+    default:  return new BTreeAdapter<2>;
     }
 }
 
-void BTreeNode::removeFromLeaf(int idx) {
-    for (int i = idx + 1; i < numKeys; ++i)
-        keys[i - 1] = keys[i];
-    numKeys--;
+QVector<int> AnyBTree::supportedDegrees() {
+    return {2, 3, 4, 8, 16, 32, 64, 128, 256};
 }
 
-void BTreeNode::removeFromNonLeaf(int idx) {
-    int key = keys[idx];
-    if (children[idx]->numKeys >= DEGREE) {
-        int pred = getPred(idx);
-        keys[idx] = pred;
-        children[idx]->remove(pred);
-    } else if (children[idx + 1]->numKeys >= DEGREE) {
-        int succ = getSucc(idx);
-        keys[idx] = succ;
-        children[idx + 1]->remove(succ);
-    } else {
-        merge(idx);
-        children[idx]->remove(key);
+AnyBTree::Timing AnyBTree::measure(int minDegree, int n, int lookups, quint32 seed) {
+    switch (minDegree) {
+    case 3:   return BTreeAdapter<3>::measure(n, lookups, seed);
+    case 4:   return BTreeAdapter<4>::measure(n, lookups, seed);
+    case 8:   return BTreeAdapter<8>::measure(n, lookups, seed);
+    case 16:  return BTreeAdapter<16>::measure(n, lookups, seed);
+    case 32:  return BTreeAdapter<32>::measure(n, lookups, seed);
+    case 64:  return BTreeAdapter<64>::measure(n, lookups, seed);
+    case 128: return BTreeAdapter<128>::measure(n, lookups, seed);
+    case 256: return BTreeAdapter<256>::measure(n, lookups, seed);
+    default:  return BTreeAdapter<2>::measure(n, lookups, seed);
     }
 }
 
-int BTreeNode::getPred(int idx) {
-    BTreeNode* cur = children[idx];
-    while (!cur->isLeaf) cur = cur->children[cur->numKeys];
-    return cur->keys[cur->numKeys - 1];
-}
-
-int BTreeNode::getSucc(int idx) {
-    BTreeNode* cur = children[idx + 1];
-    while (!cur->isLeaf) cur = cur->children[0];
-    return cur->keys[0];
-}
-
-void BTreeNode::fill(int idx) {
-    if (idx != 0 && children[idx - 1]->numKeys >= DEGREE)
-        borrowFromPrev(idx);
-    else if (idx != numKeys && children[idx + 1]->numKeys >= DEGREE)
-        borrowFromNext(idx);
-    else {
-        if (idx != numKeys) merge(idx);
-        else merge(idx - 1);
+bool AnyBTree::measureBulkLoad(int minDegree, const QVector<int>& input, double fill,
+                               const QAtomicInt* cancelled, BulkTiming* timing) {
+    switch (minDegree) {
+    case 3:   return BTreeAdapter<3>::measureBulkLoad(input, fill, cancelled, timing);
+    case 4:   return BTreeAdapter<4>::measureBulkLoad(input, fill, cancelled, timing);
+    case 8:   return BTreeAdapter<8>::measureBulkLoad(input, fill, cancelled, timing);
+    case 16:  return BTreeAdapter<16>::measureBulkLoad(input, fill, cancelled, timing);
+    case 32:  return BTreeAdapter<32>::measureBulkLoad(input, fill, cancelled, timing);
+    case 64:  return BTreeAdapter<64>::measureBulkLoad(input, fill, cancelled, timing);
+    case 128: return BTreeAdapter<128>::measureBulkLoad(input, fill, cancelled, timing);
+    case 256: return BTreeAdapter<256>::measureBulkLoad(input, fill, cancelled, timing);
+    default:  return BTreeAdapter<2>::measureBulkLoad(input, fill, cancelled, timing);
     }
 }
-
-void BTreeNode::borrowFromPrev(int idx) {
-    BTreeNode* child = children[idx];
-    BTreeNode* sibling = children[idx - 1];
-
-    for (int i = child->numKeys - 1; i >= 0; --i)
-        child->keys[i + 1] = child->keys[i];
-
-    if (!child->isLeaf) {
-        for (int i = child->numKeys; i >= 0; --i)
-            child->children[i + 1] = child->children[i];
-    }
-
-    child->keys[0] = keys[idx - 1];
-
-    if (!child->isLeaf)
-        child->children[0] = sibling->children[sibling->numKeys];
-
-    keys[idx - 1] = sibling->keys[sibling->numKeys - 1];
-
-    child->numKeys++;
-    sibling->numKeys--;
-}
-
-void BTreeNode::borrowFromNext(int idx) {
-    BTreeNode* child = children[idx];
-    BTreeNode* sibling = children[idx + 1];
-
-    child->keys[child->numKeys] = keys[idx];
-
-    if (!child->isLeaf)
-        child->children[child->numKeys + 1] = sibling->children[0];
-
-    keys[idx] = sibling->keys[0];
-
-    for (int i = 1; i < sibling->numKeys; ++i)
-        sibling->keys[i - 1] = sibling->keys[i];
-
-    if (!sibling->isLeaf) {
-        for (int i = 1; i <= sibling->numKeys; ++i)
-            sibling->children[i - 1] = sibling->children[i];
-    }
-
-    child->numKeys++;
-    sibling->numKeys--;
-}
-
-void BTreeNode::merge(int idx) {
-    BTreeNode* child = children[idx];
-    BTreeNode* sibling = children[idx + 1];
-
-    child->keys[DEGREE - 1] = keys[idx];
-
-    for (int i = 0; i < sibling->numKeys; ++i)
-        child->keys[i + DEGREE] = sibling->keys[i];
-
-    if (!child->isLeaf) {
-        for (int i = 0; i <= sibling->numKeys; ++i)
-            child->children[i + DEGREE] = sibling->children[i];
-    }
-
-    for (int i = idx + 1; i < numKeys; ++i)
-        keys[i - 1] = keys[i];
-
-    for (int i = idx + 2; i <= numKeys; ++i)
-        children[i - 1] = children[i];
-
-    child->numKeys += sibling->numKeys + 1;
-    numKeys--;
-
-    delete sibling;
-}
-
-BTree::BTree() {
-    root = nullptr;
-}
-
-BTree::~BTree() {
-    clear();
-}
-
-void BTree::insert(int key) {
-    if (!root) {
-        root = new BTreeNode(true);
-        root->keys[0] = key;
-        root->numKeys = 1;
-    } else {
-        if (root->numKeys == 2 * DEGREE - 1) {
-            BTreeNode* s = new BTreeNode(false);
-            s->children[0] = root;
-            s->splitChild(0, root);
-
-            int i = (s->keys[0] < key) ? 1 : 0;
-            s->children[i]->insertNonFull(key);
-
-            root = s;
-        } else {
-            root->insertNonFull(key);
-        }
-    }
-}
-
-void BTree::remove(int key) {
-    if (!root) return;
-
-    root->remove(key);
-
-    if (root->numKeys == 0) {
-        BTreeNode* tmp = root;
-        if (root->isLeaf)
-            root = nullptr;
-        else
-            root = root->children[0];
-        delete tmp;
-    }
-}
-
-BTreeNode* BTree::search(int key) {
-    return (root == nullptr) ? nullptr : root->search(key);
-}
-
-void BTree::clear() {
-    clearNode(root);
-    root = nullptr;
-}
-
-void BTree::clearNode(BTreeNode* node) {
-    if (!node) return;
-    if (!node->isLeaf) {
-        for (int i = 0; i <= node->numKeys; i++)
-            clearNode(node->children[i]);
-    }
-    delete node;
-}
-
-BTreeNode* BTree::getRoot() {
-    return root;
-}
@@ -1,50 +1,455 @@
 #ifndef BTREE_H
 #define BTREE_H
 
-#include <QObject>
-#include <iostream>
+#include "nodepool.h"
+#include "opcounter.h"
+#include <QVector>
+#include <QAtomicInt>
+#include <QtGlobal>
+#include <algorithm>
+#include <type_traits>
+#if defined(__AVX2__) && defined(__GNUC__)
+#include <immintrin.h>
+#endif
 
-#define DEGREE 2  // 最小度数
+// 结点内查找：返回第一个不小于 key 的下标（0…n）
+namespace BTreeKeys {
 
-class BTreeNode {
-public:
-    BTreeNode(bool isLeaf);
-    ~BTreeNode();
-
-    int keys[2 * DEGREE - 1];         // 关键字数组
-    BTreeNode* children[2 * DEGREE];  // 子节点数组
-    int numKeys;                      // 当前关键字数
-    bool isLeaf;                      // 是否为叶子
-
-    void insertNonFull(int key);               // 插入（非满）
-    void splitChild(int i, BTreeNode* y);      // 分裂子节点
-    BTreeNode* search(int key);                // 查找关键字
-
-    void remove(int key);                      // 删除关键字
-    void removeFromLeaf(int idx);              // 从叶子删除
-    void removeFromNonLeaf(int idx);           // 从非叶删除
-    int getPred(int idx);                      // 获取前驱
-    int getSucc(int idx);                      // 获取后继
-    void fill(int idx);                        // 填充子节点
-    void borrowFromPrev(int idx);              // 向左兄弟借
-    void borrowFromNext(int idx);              // 向右兄弟借
-    void merge(int idx);                       // 合并子节点
-};
+// 无分支折半查找，与 SearchLayout 的有序数组查找相同的写法
+template <class Key>
+inline int lowerBound(const Key* keys, int n, const Key& key) {
+    if (n == 0) return 0;
+    const Key* base = keys;
+    int length = n;
+    while (length > 1) {
+        const int half = length / 2;
+        base += (base[half - 1] < key) * half;     // 乘法代替分支，编译为条件传送
+        length -= half;
+    }
+    return static_cast<int>(base - keys) + (*base < key);
+}
+
+#if defined(__AVX2__) && defined(__GNUC__)
+// int 键：每次比较 8 个键得到“小于 key”的掩码；键有序，掩码不满的块即为终点
+inline int lowerBound(const int* keys, int n, int key) {
+    const __m256i needle = _mm256_set1_epi32(key);
+    int i = 0;
+    for (; i + 8 <= n; i += 8) {
+        const __m256i block = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(keys + i));
+        const int mask = _mm256_movemask_ps(_mm256_castsi256_ps(_mm256_cmpgt_epi32(needle, block)));
+        if (mask != 0xFF) return i + __builtin_popcount(mask);
+    }
+    while (i < n && keys[i] < key)
+        ++i;
+    return i;
+}
+#endif
+
+}
 
+// 阶数为模板参数的 B 树（CLRS 最小度数 t：每个结点 t-1…2t-1 个键，根除外），允许重复键
+// 插入时自顶向下预先分裂满结点、删除时预先补足到 t 个键，都只沿一条路径下降一次，全程不递归
+// 结点按缓存行对齐，键数组位于结点开头：t = 8 时 15 个 int 键与键数恰好占满一条缓存行；
+// 结点由 NodePool 按块分配，clear() 整块归还；分裂、合并与借键经 Counter 记录，计时用 NullOpCounter
+template <class Key, int MinDegree, class Counter = OpCounter>
 class BTree {
 public:
-    BTree();
-    ~BTree();
+    static_assert(MinDegree >= 2, "B 树的最小度数至少为 2");
+
+    static const int MaxKeys = 2 * MinDegree - 1;
+    static const int MaxDepth = 64;
+
+    struct alignas(64) Node {
+        Key keys[MaxKeys];
+        int numKeys;
+        bool isLeaf;
+        mutable bool spanValid;                  // leafSpan 是否有效
+        mutable int leafSpan;                    // 子树覆盖的叶子数（布局缓存）
+        Node* children[MaxKeys + 1];             // 叶子结点不使用，也不初始化
+
+        explicit Node(bool leaf) : numKeys(0), isLeaf(leaf), spanValid(false), leafSpan(1) {}
+    };
+
+    BTree() : m_root(nullptr), m_size(0) {}
+    ~BTree() { clear(); }
+
+    BTree(const BTree&) = delete;
+    BTree& operator=(const BTree&) = delete;
+
+    void insert(const Key& key) {
+        if (!m_root) {
+            m_root = m_pool.create(true);
+            m_root->keys[0] = key;
+            m_root->numKeys = 1;
+            ++m_size;
+            return;
+        }
+        if (m_root->numKeys == MaxKeys) {
+            Node* root = m_pool.create(false);
+            root->children[0] = m_root;
+            m_root = root;
+            splitChild(root, 0);
+        }
+
+        Node* path[MaxDepth];
+        int depth = 0;
+        Node* node = m_root;
+        while (!node->isLeaf) {
+            path[depth++] = node;
+            int i = BTreeKeys::lowerBound(node->keys, node->numKeys, key);
+            if (node->children[i]->numKeys == MaxKeys) {
+                splitChild(node, i);
+                invalidateSpans(path, depth);
+                if (node->keys[i] < key) ++i;
+            }
+            node = node->children[i];
+        }
+
+        const int i = BTreeKeys::lowerBound(node->keys, node->numKeys, key);
+        std::copy_backward(node->keys + i, node->keys + node->numKeys, node->keys + node->numKeys + 1);
+        node->keys[i] = key;
+        ++node->numKeys;
+        ++m_size;
+    }
+
+    // 自底向上批量构建：sorted 须为非降序，原有内容被清空
+    // 叶子按 fill · (2t - 1) 个键（不少于 t - 1）均匀装填，相邻结点之间的一个键上移为上一层的键，
+    // 逐层重复直到只剩根；每个键只复制一次，O(n)，没有分裂。同层结点连续分配
+    void bulkLoad(const Key* sorted, qint64 n, double fill = 1.0) {
+        clear();
+        if (n <= 0) return;
+        int target = qRound(fill * MaxKeys);
+        if (target < MinDegree - 1) target = MinDegree - 1;
+        if (target > MaxKeys) target = MaxKeys;
+
+        QVector<Node*> level;
+        QVector<Key> separators;
+        packLevel(sorted, n, target, nullptr, &level, &separators);
+        while (level.size() > 1) {
+            QVector<Node*> parents;
+            QVector<Key> upper;
+            packLevel(separators.constData(), separators.size(), target, level.constData(), &parents, &upper);
+            level.swap(parents);
+            separators.swap(upper);
+        }
+        m_root = level.first();
+        m_size = n;
+    }
 
-    void insert(int key);                      // 插入关键字
-    void remove(int key);                      // 删除关键字
-    BTreeNode* search(int key);                // 查找
-    void clear();                              // 清空整棵树
-    BTreeNode* getRoot();                      // 获取根节点
+    // 删除一个等于 key 的键；不存在时不做任何事
+    void remove(const Key& key) {
+        if (!m_root) return;
+
+        Node* path[MaxDepth];
+        int depth = 0;
+        Node* node = m_root;
+        Key target = key;
+        while (true) {
+            path[depth++] = node;
+            int idx = BTreeKeys::lowerBound(node->keys, node->numKeys, target);
+            const bool found = idx < node->numKeys && !(target < node->keys[idx]);
+
+            if (found && node->isLeaf) {
+                std::copy(node->keys + idx + 1, node->keys + node->numKeys, node->keys + idx);
+                --node->numKeys;
+                --m_size;
+                break;
+            }
+            if (found) {
+                // 内部结点：能借就用前驱或后继顶替，再到对应子树中删除它；否则合并两侧孩子后继续
+                Node* left = node->children[idx];
+                Node* right = node->children[idx + 1];
+                if (left->numKeys >= MinDegree) {
+                    target = maxKey(left);
+                    node->keys[idx] = target;
+                    node = left;
+                } else if (right->numKeys >= MinDegree) {
+                    target = minKey(right);
+                    node->keys[idx] = target;
+                    node = right;
+                } else {
+                    merge(node, idx);
+                    invalidateSpans(path, depth);
+                    node = left;
+                }
+                continue;
+            }
+            if (node->isLeaf) break;
+
+            if (node->children[idx]->numKeys < MinDegree)
+                idx = fill(node, idx, path, depth);
+            node = node->children[idx];
+        }
+
+        // 根的两个孩子合并后根变空，树高减一
+        if (m_root->numKeys == 0) {
+            Node* old = m_root;
+            m_root = old->isLeaf ? nullptr : old->children[0];
+            m_pool.destroy(old);
+        }
+    }
+
+    // 返回包含 key 的结点，没有时返回 nullptr
+    const Node* search(const Key& key) const {
+        const Node* node = m_root;
+        while (node) {
+            const int i = BTreeKeys::lowerBound(node->keys, node->numKeys, key);
+            if (i < node->numKeys && !(key < node->keys[i])) return node;
+            node = node->isLeaf ? nullptr : node->children[i];
+        }
+        return nullptr;
+    }
+
+    bool contains(const Key& key) const { return search(key) != nullptr; }
+
+    // 键可平凡析构时不遍历，直接归还全部块
+    void clear() {
+        if (!std::is_trivially_destructible<Key>::value && m_root) {
+            QVector<Node*> stack;
+            stack.append(m_root);
+            while (!stack.isEmpty()) {
+                Node* node = stack.takeLast();
+                if (!node->isLeaf) {
+                    for (int i = 0; i <= node->numKeys; ++i)
+                        stack.append(node->children[i]);
+                }
+                node->~Node();
+            }
+        }
+        m_pool.release();
+        m_root = nullptr;
+        m_size = 0;
+    }
+
+    const Node* getRoot() const { return m_root; }
+    qint64 size() const { return m_size; }
+
+    // 所有叶子同层，沿最左孩子下降即得树高
+    int height() const {
+        int h = 0;
+        for (const Node* node = m_root; node; node = node->isLeaf ? nullptr : node->children[0])
+            ++h;
+        return h;
+    }
+
+    // 子树覆盖的叶子数，只重算失效的结点
+    static int leafSpan(const Node* node) {
+        if (node->spanValid) return node->leafSpan;
+        int span = 1;
+        if (!node->isLeaf) {
+            span = 0;
+            for (int i = 0; i <= node->numKeys; ++i)
+                span += leafSpan(node->children[i]);
+        }
+        node->leafSpan = span;
+        node->spanValid = true;
+        return span;
+    }
 
 private:
-    BTreeNode* root;
-    void clearNode(BTreeNode* node);           // 递归释放节点
+    // n 个键分成若干结点、结点之间各留一个键上移：按目标键数取结点数，
+    // 但不超过 (n + 1) / t 个，使平均键数不低于 t - 1；整层只有一个结点时即为根，不受下限约束
+    static qint64 nodeCount(qint64 n, int target) {
+        const qint64 byTarget = (n + target + 1) / (target + 1);
+        const qint64 byMinimum = (n + 1) / MinDegree;
+        return qMax<qint64>(1, qMin(byTarget, byMinimum));
+    }
+
+    // 装填一层：children 为空时是叶子层，否则每个 k 键结点依次取走 k + 1 个孩子
+    void packLevel(const Key* keys, qint64 n, int target, Node* const* children,
+                   QVector<Node*>* nodes, QVector<Key>* separators) {
+        const qint64 count = nodeCount(n, target);
+        const qint64 stay = n - (count - 1);          // 留在本层的键数，均分给各结点
+        const qint64 base = stay / count;
+        const qint64 extra = stay % count;
+        nodes->reserve(static_cast<int>(count));
+        separators->reserve(static_cast<int>(count - 1));
+
+        qint64 next = 0;
+        for (qint64 i = 0; i < count; ++i) {
+            Node* node = m_pool.create(children == nullptr);
+            const int size = static_cast<int>(base + (i < extra ? 1 : 0));
+            std::copy(keys + next, keys + next + size, node->keys);
+            if (children) {
+                std::copy(children, children + size + 1, node->children);
+                children += size + 1;
+            }
+            node->numKeys = size;
+            next += size;
+            nodes->append(node);
+            if (i + 1 < count)
+                separators->append(keys[next++]);
+        }
+    }
+
+    // 结构变化的结点及其全部祖先的跨度失效；未触及的子树保留缓存
+    static void invalidateSpans(Node* const* path, int depth) {
+        for (int i = 0; i < depth; ++i)
+            path[i]->spanValid = false;
+    }
+
+    // 满孩子 children[i] 的中间键上移，后半部分移入新结点
+    void splitChild(Node* parent, int i) {
+        Counter::add(OpCounter::Splits);
+        Node* y = parent->children[i];
+        Node* z = m_pool.create(y->isLeaf);
+        z->numKeys = MinDegree - 1;
+        std::copy(y->keys + MinDegree, y->keys + MaxKeys, z->keys);
+        if (!y->isLeaf)
+            std::copy(y->children + MinDegree, y->children + MaxKeys + 1, z->children);
+        y->numKeys = MinDegree - 1;
+
+        std::copy_backward(parent->children + i + 1, parent->children + parent->numKeys + 1,
+                           parent->children + parent->numKeys + 2);
+        parent->children[i + 1] = z;
+        std::copy_backward(parent->keys + i, parent->keys + parent->numKeys, parent->keys + parent->numKeys + 1);
+        parent->keys[i] = y->keys[MinDegree - 1];
+        ++parent->numKeys;
+
+        parent->spanValid = false;
+        y->spanValid = false;
+    }
+
+    // 使 children[idx] 至少有 t 个键，返回此后应当下降的孩子下标
+    int fill(Node* node, int idx, Node* const* path, int depth) {
+        if (idx > 0 && node->children[idx - 1]->numKeys >= MinDegree) {
+            borrowFromPrev(node, idx);
+            return idx;
+        }
+        if (idx < node->numKeys && node->children[idx + 1]->numKeys >= MinDegree) {
+            borrowFromNext(node, idx);
+            return idx;
+        }
+        if (idx == node->numKeys) --idx;
+        merge(node, idx);
+        invalidateSpans(path, depth);
+        return idx;
+    }
+
+    void borrowFromPrev(Node* node, int idx) {
+        Counter::add(OpCounter::Borrows);
+        Node* child = node->children[idx];
+        Node* sibling = node->children[idx - 1];
+
+        std::copy_backward(child->keys, child->keys + child->numKeys, child->keys + child->numKeys + 1);
+        child->keys[0] = node->keys[idx - 1];
+        if (!child->isLeaf) {
+            std::copy_backward(child->children, child->children + child->numKeys + 1, child->children + child->numKeys + 2);
+            child->children[0] = sibling->children[sibling->numKeys];
+        }
+        node->keys[idx - 1] = sibling->keys[sibling->numKeys - 1];
+
+        ++child->numKeys;
+        --sibling->numKeys;
+        child->spanValid = false;
+        sibling->spanValid = false;
+    }
+
+    void borrowFromNext(Node* node, int idx) {
+        Counter::add(OpCounter::Borrows);
+        Node* child = node->children[idx];
+        Node* sibling = node->children[idx + 1];
+
+        child->keys[child->numKeys] = node->keys[idx];
+        if (!child->isLeaf)
+            child->children[child->numKeys + 1] = sibling->children[0];
+        node->keys[idx] = sibling->keys[0];
+
+        std::copy(sibling->keys + 1, sibling->keys + sibling->numKeys, sibling->keys);
+        if (!sibling->isLeaf)
+            std::copy(sibling->children + 1, sibling->children + sibling->numKeys + 1, sibling->children);
+
+        ++child->numKeys;
+        --sibling->numKeys;
+        child->spanValid = false;
+        sibling->spanValid = false;
+    }
+
+    // children[idx]、keys[idx] 与 children[idx + 1] 合并为一个 2t-1 键的结点
+    void merge(Node* node, int idx) {
+        Counter::add(OpCounter::Merges);
+        Node* child = node->children[idx];
+        Node* sibling = node->children[idx + 1];
+
+        child->keys[MinDegree - 1] = node->keys[idx];
+        std::copy(sibling->keys, sibling->keys + sibling->numKeys, child->keys + MinDegree);
+        if (!child->isLeaf)
+            std::copy(sibling->children, sibling->children + sibling->numKeys + 1, child->children + MinDegree);
+
+        std::copy(node->keys + idx + 1, node->keys + node->numKeys, node->keys + idx);
+        std::copy(node->children + idx + 2, node->children + node->numKeys + 1, node->children + idx + 1);
+
+        child->numKeys += sibling->numKeys + 1;
+        --node->numKeys;
+        child->spanValid = false;
+        node->spanValid = false;
+
+        m_pool.destroy(sibling);
+    }
+
+    static Key maxKey(const Node* node) {
+        while (!node->isLeaf)
+            node = node->children[node->numKeys];
+        return node->keys[node->numKeys - 1];
+    }
+
+    static Key minKey(const Node* node) {
+        while (!node->isLeaf)
+            node = node->children[0];
+        return node->keys[0];
+    }
+
+    Node* m_root;
+    qint64 m_size;
+    NodePool<Node> m_pool;
+};
+
+// 运行时选择阶数的 int 键 B 树：可视化与 GDB 分支只持有 AnyBTree*，结点以不透明句柄访问
+class AnyBTree {
+public:
+    typedef const void* Node;
+
+    struct Timing {
+        double insertNanos;     // 每次插入的平均纳秒数
+        double lookupNanos;     // 每次查找的平均纳秒数
+        int height;
+    };
+
+    struct BulkTiming {
+        double bulkMs;          // 批量构建耗时（不含排序）
+        int bulkHeight;
+        double insertMs;        // 按原顺序逐个插入的耗时
+        int insertHeight;
+    };
+
+    virtual ~AnyBTree() {}
+
+    // 不支持的最小度数按 2 处理
+    static AnyBTree* create(int minDegree);
+    static QVector<int> supportedDegrees();     // 2、3、4、8 … 256
+    // 插入 n 个随机键后做 lookups 次随机查找；内存不足时抛出 std::bad_alloc
+    // 可在工作线程中调用：计时用的树不写全局操作计数
+    static Timing measure(int minDegree, int n, int lookups, quint32 seed);
+    // 同一数据集先排序后批量构建、再按原顺序逐个插入，两棵树先后构建、各自释放；
+    // cancelled 置位时尽快返回 false。内存不足时抛出 std::bad_alloc，同样可在工作线程中调用
+    static bool measureBulkLoad(int minDegree, const QVector<int>& input, double fill,
+                                const QAtomicInt* cancelled, BulkTiming* timing);
+
+    virtual int minDegree() const = 0;
+    virtual void insert(int key) = 0;
+    virtual void remove(int key) = 0;
+    virtual bool contains(int key) const = 0;
+    virtual void clear() = 0;
+    virtual void bulkLoad(const int* sorted, qint64 n, double fill) = 0;   // 见 BTree::bulkLoad
+    virtual qint64 size() const = 0;
+    virtual int height() const = 0;
+
+    virtual Node root() const = 0;
+    virtual int keyCount(Node node) const = 0;
+    virtual int key(Node node, int i) const = 0;
+    virtual bool isLeaf(Node node) const = 0;
+    virtual Node child(Node node, int i) const = 0;
+    virtual int leafSpan(Node node) const = 0;
 };
 
 #endif // BTREE_H
@@ -0,0 +1,206 @@
+#include "btreeorderdialog.h"
+#include "btree.h"
+#include <QHBoxLayout>
+#include <QVBoxLayout>
+#include <QCloseEvent>
+#include <QtMath>
+
+static const qreal kChartMargin = 44;
+
+BTreeOrderChart::BTreeOrderChart(QWidget* parent)
+    : QWidget(parent) {
+    setMinimumSize(480, 300);
+}
+
+void BTreeOrderChart::setPoints(const QVector<QPointF>& insert, const QVector<QPointF>& lookup) {
+    m_insert = insert;
+    m_lookup = lookup;
+    update();
+}
+
+void BTreeOrderChart::paintEvent(QPaintEvent* event) {
+    Q_UNUSED(event);
+    QPainter painter(this);
+    painter.setRenderHint(QPainter::Antialiasing);
+    painter.setFont(QFont("Segoe UI", 8));
+
+    const QRectF area = QRectF(rect()).adjusted(kChartMargin, 10, -10, -kChartMargin);
+    painter.setPen(QPen(QColor("#555555"), 1));
+    painter.drawLine(area.bottomLeft(), area.bottomRight());
+    painter.drawLine(area.bottomLeft(), area.topLeft());
+
+    double maxNanos = 1;
+    for (const QPointF& p : m_insert)
+        maxNanos = qMax(maxNanos, p.y());
+    for (const QPointF& p : m_lookup)
+        maxNanos = qMax(maxNanos, p.y());
+    maxNanos *= 1.1;
+
+    const QVector<int> degrees = AnyBTree::supportedDegrees();
+    const double logMin = qLn(degrees.first());
+    const double logSpan = qLn(degrees.last()) - logMin;
+    auto toPoint = [&](double degree, double nanos) {
+        return QPointF(area.left() + area.width() * (qLn(degree) - logMin) / logSpan,
+                       area.bottom() - area.height() * nanos / maxNanos);
+    };
+
+    painter.setPen(QColor("#ABB2BF"));
+    for (int degree : degrees) {
+        QPointF p = toPoint(degree, 0);
+        painter.drawText(QRectF(p.x() - 20, area.bottom() + 4, 40, 14), Qt::AlignCenter, QString::number(degree));
+    }
+    painter.drawText(QRectF(area.left(), area.bottom() + 20, area.width(), 14), Qt::AlignCenter, "最小度数 t（结点最多 2t - 1 个键）");
+
+    for (int i = 0; i <= 4; ++i) {
+        const double nanos = maxNanos * i / 4;
+        QPointF q = toPoint(degrees.first(), nanos);
+        painter.drawText(QRectF(0, q.y() - 7, area.left() - 4, 14), Qt::AlignRight | Qt::AlignVCenter,
+                         QString("%1 ns").arg(qRound(nanos)));
+    }
+
+    const QVector<QPointF>* series[] = {&m_insert, &m_lookup};
+    const QColor colors[] = {QColor("#E06C75"), QColor("#61AFEF")};
+    const QString names[] = {"插入", "查找"};
+    for (int s = 0; s < 2; ++s) {
+        QVector<QPointF> line;
+        for (const QPointF& p : *series[s])
+            line.append(toPoint(p.x(), p.y()));
+        painter.setPen(QPen(colors[s], 2));
+        painter.drawPolyline(line.constData(), line.size());
+        painter.setBrush(colors[s]);
+        for (const QPointF& p : line)
+            painter.drawEllipse(p, 3, 3);
+        painter.setBrush(Qt::NoBrush);
+
+        const qreal y = area.top() + 10 + s * 16;
+        painter.drawLine(QPointF(area.right() - 80, y), QPointF(area.right() - 60, y));
+        painter.setPen(QColor("#ABB2BF"));
+        painter.drawText(QPointF(area.right() - 54, y + 4), names[s]);
+    }
+}
+
+BTreeOrderDialog::BTreeOrderDialog(QWidget* parent)
+    : QDialog(parent), m_thread(nullptr), m_worker(nullptr) {
+    setWindowTitle("B 树阶数：t = 2 … 256");
+    setStyleSheet("background-color:#333333; color:#ABB2BF;");
+
+    QString buttonStyle =
+        "QToolButton { background-color: transparent; border: none; padding: 3px; color:#ABB2BF; font-weight:bold; }"
+        "QToolButton:hover { background-color: rgba(255, 255, 255, 30); }"
+        "QToolButton:disabled { color:#666666; }";
+
+    QLabel* sizeLabel = new QLabel("键数");
+    m_sizeCombo = new QComboBox;
+    for (int n : {100000, 1000000, 10000000})
+        m_sizeCombo->addItem(QString::number(n), n);
+    m_sizeCombo->setCurrentIndex(1);
+
+    QLabel* lookupsLabel = new QLabel("查找次数");
+    m_lookupsSpinBox = new QSpinBox;
+    m_lookupsSpinBox->setRange(10000, 10000000);
+    m_lookupsSpinBox->setSingleStep(100000);
+    m_lookupsSpinBox->setValue(1000000);
+    m_lookupsSpinBox->setToolTip("每个阶数的随机查找次数，约一半命中");
+
+    m_startButton = new QToolButton;
+    m_startButton->setText("开始");
+    m_startButton->setStyleSheet(buttonStyle);
+    m_stopButton = new QToolButton;
+    m_stopButton->setText("停止");
+    m_stopButton->setStyleSheet(buttonStyle);
+    m_stopButton->setEnabled(false);
+
+    QHBoxLayout* controls = new QHBoxLayout;
+    controls->addWidget(sizeLabel);
+    controls->addWidget(m_sizeCombo);
+    controls->addWidget(lookupsLabel);
+    controls->addWidget(m_lookupsSpinBox);
+    controls->addStretch();
+    controls->addWidget(m_startButton);
+    controls->addWidget(m_stopButton);
+
+    m_chart = new BTreeOrderChart;
+    m_resultLabel = new QLabel("阶数越大树越矮、每层的缓存缺失越少，但结点内查找与插入时的移动越多");
+
+    QVBoxLayout* layout = new QVBoxLayout(this);
+    layout->addLayout(controls);
+    layout->addWidget(m_chart, 1);
+    layout->addWidget(m_resultLabel);
+
+    connect(m_startButton, &QToolButton::clicked, this, &BTreeOrderDialog::start);
+    connect(m_stopButton, &QToolButton::clicked, this, &BTreeOrderDialog::stop);
+}
+
+BTreeOrderDialog::~BTreeOrderDialog() {
+    stop();
+}
+
+void BTreeOrderDialog::closeEvent(QCloseEvent* event) {
+    stop();
+    QDialog::closeEvent(event);
+}
+
+void BTreeOrderDialog::start() {
+    if (m_thread) return;
+
+    m_insert.clear();
+    m_lookup.clear();
+    m_chart->setPoints(m_insert, m_lookup);
+    m_resultLabel->setText("测量中……");
+    m_startButton->setEnabled(false);
+    m_stopButton->setEnabled(true);
+    m_sizeCombo->setEnabled(false);
+    m_lookupsSpinBox->setEnabled(false);
+
+    // 工作对象没有父对象，随线程结束一起释放
+    m_thread = new QThread;
+    m_worker = new BTreeOrderWorker(m_sizeCombo->currentData().toInt(), m_lookupsSpinBox->value());
+    m_worker->moveToThread(m_thread);
+    connect(m_thread, &QThread::started, m_worker, &BTreeOrderWorker::run);
+    connect(m_worker, &BTreeOrderWorker::finished, m_thread, &QThread::quit);
+    connect(m_thread, &QThread::finished, m_worker, &QObject::deleteLater);
+    connect(m_thread, &QThread::finished, m_thread, &QObject::deleteLater);
+    connect(m_worker, &BTreeOrderWorker::measured, this, &BTreeOrderDialog::onMeasured);
+    connect(m_worker, &BTreeOrderWorker::failed, this, &BTreeOrderDialog::onFailed);
+    connect(m_worker, &BTreeOrderWorker::finished, this, &BTreeOrderDialog::onFinished);
+    m_thread->start();
+}
+
+void BTreeOrderDialog::stop() {
+    if (!m_thread) return;
+    m_worker->cancel();
+    m_thread->quit();
+    m_thread->wait();
+    // 线程已退出，deleteLater 由 finished 信号排入主线程事件队列
+    m_thread = nullptr;
+    m_worker = nullptr;
+    m_startButton->setEnabled(true);
+    m_stopButton->setEnabled(false);
+    m_sizeCombo->setEnabled(true);
+    m_lookupsSpinBox->setEnabled(true);
+}
+
+void BTreeOrderDialog::onMeasured(int minDegree, double insertNanos, double lookupNanos, int height) {
+    m_insert.append(QPointF(minDegree, insertNanos));
+    m_lookup.append(QPointF(minDegree, lookupNanos));
+    m_chart->setPoints(m_insert, m_lookup);
+
+    // 目前查找最快的阶数
+    int best = 0;
+    for (int i = 1; i < m_lookup.size(); ++i)
+        if (m_lookup[i].y() < m_lookup[best].y()) best = i;
+    m_resultLabel->setText(QString("t = %1：插入 %2 ns · 查找 %3 ns · 树高 %4；查找最快为 t = %5")
+                           .arg(minDegree)
+                           .arg(insertNanos, 0, 'f', 1)
+                           .arg(lookupNanos, 0, 'f', 1)
+                           .arg(height)
+                           .arg(qRound(m_lookup[best].x())));
+}
+
+void BTreeOrderDialog::onFailed(const QString& message) {
+    m_resultLabel->setText(message);
+}
+
+void BTreeOrderDialog::onFinished() {
+    stop();
+}
@@ -0,0 +1,65 @@
+#ifndef BTREEORDERDIALOG_H
+#define BTREEORDERDIALOG_H
+
+#include "benchmark.h"
+#include <QDialog>
+#include <QWidget>
+#include <QSpinBox>
+#include <QComboBox>
+#include <QLabel>
+#include <QToolButton>
+#include <QThread>
+#include <QPainter>
+#include <QPaintEvent>
+#include <QPointF>
+#include <QVector>
+
+// 最小度数-单次操作耗时曲线，横轴为对数刻度，插入与查找各一条
+class BTreeOrderChart : public QWidget {
+    Q_OBJECT
+
+public:
+    explicit BTreeOrderChart(QWidget* parent = nullptr);
+    // 两条曲线均为 (最小度数, 纳秒) 序列
+    void setPoints(const QVector<QPointF>& insert, const QVector<QPointF>& lookup);
+
+protected:
+    void paintEvent(QPaintEvent* event) override;
+
+private:
+    QVector<QPointF> m_insert;
+    QVector<QPointF> m_lookup;
+};
+
+// B 树阶数对话框：在同样的随机键上比较 t = 2 … 256 的 B 树插入与查找耗时
+class BTreeOrderDialog : public QDialog {
+    Q_OBJECT
+
+public:
+    explicit BTreeOrderDialog(QWidget* parent = nullptr);
+    ~BTreeOrderDialog();
+
+protected:
+    void closeEvent(QCloseEvent* event) override;
+
+private:
+    void start();
+    void stop();                                   // 取消测量并等待工作线程退出
+    void onMeasured(int minDegree, double insertNanos, double lookupNanos, int height);
+    void onFailed(const QString& message);
+    void onFinished();
+
+    QComboBox* m_sizeCombo;
+    QSpinBox* m_lookupsSpinBox;
+    QToolButton* m_startButton;
+    QToolButton* m_stopButton;
+    QLabel* m_resultLabel;
+    BTreeOrderChart* m_chart;
+
+    QThread* m_thread;
+    BTreeOrderWorker* m_worker;
+    QVector<QPointF> m_insert;
+    QVector<QPointF> m_lookup;
+};
+
+#endif // BTREEORDERDIALOG_H
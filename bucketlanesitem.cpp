@@ -0,0 +1,384 @@
+#include "bucketlanesitem.h"
+
+static const qreal kMargin = 30;          // 四周留白
+static const qreal kInputRatio = 0.3;     // 上方数组条带占区域高度的比例
+static const qreal kLaneGap = 20;         // 数组条带与桶道之间的间距
+static const qreal kMinLaneHeight = 8;    // 桶道低于该高度时分列排布
+static const qreal kLabelWidth = 110;     // 桶道左侧区间标签宽度
+static const qreal kMaxCellWidth = 40;
+static const qreal kMinLabelSlot = 24;    // 格宽不小于该值时才绘制数值
+
+BucketLanesItem::BucketLanesItem(QSizeF areaSize, QGraphicsItem* parent)
+    : QGraphicsItem(parent), m_areaSize(areaSize) {
+    clear();
+}
+
+void BucketLanesItem::clear() {
+    m_input.clear();
+    m_lanes.clear();
+    m_swapped.clear();
+    m_maxInput = 1;
+    m_maxLaneSize = 1;
+    m_assignCursor = 0;
+    m_outputCount = 0;
+    m_outputBucket = 0;
+    m_outputPos = 0;
+    m_output.clear();
+    m_passLow = -1;
+    m_passHigh = -1;
+    m_activeInput = -1;
+    update();
+}
+
+void BucketLanesItem::appendInput(int value) {
+    m_input.append(Cell{value, Normal});
+    m_maxInput = qMax(m_maxInput, value);
+    update();
+}
+
+void BucketLanesItem::setBucketCount(int count) {
+    count = qMax(1, count);
+    if (count == m_lanes.size()) return;
+    m_lanes.resize(count);
+    update();
+}
+
+void BucketLanesItem::setBucketRange(int bucket, int low, int high) {
+    if (bucket < 0) return;
+    if (bucket >= m_lanes.size()) setBucketCount(bucket + 1);
+    m_lanes[bucket].low = low;
+    m_lanes[bucket].high = high;
+    m_lanes[bucket].hasRange = true;
+    update();
+}
+
+bool BucketLanesItem::assign(int value, int bucket) {
+    if (bucket < 0) return false;
+
+    // 轨迹通常按输入顺序分配，先看游标处
+    int index = -1;
+    if (m_assignCursor < m_input.size() && m_input[m_assignCursor].value == value
+            && m_input[m_assignCursor].state == Normal) {
+        index = m_assignCursor;
+    } else {
+        for (int i = 0; i < m_input.size(); ++i) {
+            if (m_input[i].value == value && m_input[i].state == Normal) {
+                index = i;
+                break;
+            }
+        }
+    }
+    if (index < 0) return false;
+    m_input[index].state = Moved;
+    m_assignCursor = index + 1;
+
+    // 未收到 BUCKET_INIT 的旧轨迹：桶数随出现的桶号增长
+    if (bucket >= m_lanes.size()) setBucketCount(bucket + 1);
+    Lane& lane = m_lanes[bucket];
+    if (!lane.hasRange) {
+        lane.low = lane.cells.isEmpty() ? value : qMin(lane.low, value);
+        lane.high = lane.cells.isEmpty() ? value : qMax(lane.high, value);
+    }
+    lane.cells.append(Cell{value, Normal});
+    m_maxLaneSize = qMax(m_maxLaneSize, lane.cells.size());
+    update();
+    return true;
+}
+
+bool BucketLanesItem::swapInBucket(int bucket, int i, int j) {
+    if (bucket < 0 || bucket >= m_lanes.size()) return false;
+    QVector<Cell>& cells = m_lanes[bucket].cells;
+    if (i < 0 || j < 0 || i >= cells.size() || j >= cells.size() || i == j) return false;
+
+    clearSwapStates();
+    std::swap(cells[i].value, cells[j].value);
+    cells[i].state = Swap;
+    cells[j].state = Swap;
+    m_swapped.append(qMakePair(bucket, i));
+    m_swapped.append(qMakePair(bucket, j));
+    update(laneRect(bucket));
+    return true;
+}
+
+bool BucketLanesItem::emitFinal(int value) {
+    clearSwapStates();
+
+    // 输出按桶序、桶内顺序进行，游标向前找到第一个未取出的格子
+    while (m_outputBucket < m_lanes.size()) {
+        const QVector<Cell>& cells = m_lanes[m_outputBucket].cells;
+        while (m_outputPos < cells.size() && cells[m_outputPos].state == Moved)
+            ++m_outputPos;
+        if (m_outputPos < cells.size()) break;
+        ++m_outputBucket;
+        m_outputPos = 0;
+    }
+
+    Cell* source = nullptr;
+    if (m_outputBucket < m_lanes.size() && m_lanes[m_outputBucket].cells[m_outputPos].value == value) {
+        source = &m_lanes[m_outputBucket].cells[m_outputPos];
+    } else {
+        // 输出顺序与桶序不一致时退回全量查找
+        for (Lane& lane : m_lanes) {
+            for (Cell& cell : lane.cells) {
+                if (cell.value == value && cell.state != Moved) {
+                    source = &cell;
+                    break;
+                }
+            }
+            if (source) break;
+        }
+    }
+    if (!source || m_outputCount >= m_input.size()) return false;
+
+    source->state = Moved;
+    m_input[m_outputCount] = Cell{value, Final};
+    ++m_outputCount;
+    update();
+    return true;
+}
+
+void BucketLanesItem::clearSwapStates() {
+    for (const auto& slot : m_swapped) {
+        QVector<Cell>& cells = m_lanes[slot.first].cells;
+        if (slot.second < cells.size() && cells[slot.second].state == Swap)
+            cells[slot.second].state = Normal;
+        update(laneRect(slot.first));
+    }
+    m_swapped.clear();
+}
+
+void BucketLanesItem::setLaneTitle(const QString& title) {
+    m_laneTitle = title;
+    update();
+}
+
+void BucketLanesItem::beginPass(int laneCount, int low, int high) {
+    m_lanes.clear();
+    m_lanes.resize(qMax(1, laneCount));
+    m_swapped.clear();
+    m_maxLaneSize = 1;
+    m_activeInput = -1;
+    m_passLow = qBound(0, low, m_input.size());
+    m_passHigh = qBound(m_passLow, high, m_input.size());
+
+    m_output.resize(m_input.size());
+    for (int i = 0; i < m_input.size(); ++i)
+        m_output[i] = m_input[i].value;
+    update();
+}
+
+void BucketLanesItem::clearActive() {
+    if (m_activeInput >= 0 && m_activeInput < m_input.size() && m_input[m_activeInput].state == Active)
+        m_input[m_activeInput].state = Normal;
+    m_activeInput = -1;
+}
+
+void BucketLanesItem::countInto(int index, int bucket) {
+    if (index < 0 || index >= m_input.size() || bucket < 0 || bucket >= m_lanes.size()) return;
+    clearActive();
+    m_input[index].state = Active;
+    m_activeInput = index;
+    ++m_lanes[bucket].count;
+    update();
+}
+
+void BucketLanesItem::computePrefix() {
+    clearActive();
+    int offset = qMax(0, m_passLow);
+    for (Lane& lane : m_lanes) {
+        lane.offset = offset;
+        offset += lane.count;
+        // 格宽按最大计数确定，散射后的格子恰好填满直方图
+        m_maxLaneSize = qMax(m_maxLaneSize, lane.count);
+    }
+    update();
+}
+
+void BucketLanesItem::scatter(int index, int dest, int bucket) {
+    if (index < 0 || index >= m_input.size() || dest < 0 || dest >= m_output.size()
+            || bucket < 0 || bucket >= m_lanes.size()) return;
+    clearActive();
+    const int value = m_input[index].value;
+    m_input[index].state = Moved;
+    m_output[dest] = value;
+
+    Lane& lane = m_lanes[bucket];
+    lane.cells.append(Cell{value, Normal});
+    m_maxLaneSize = qMax(m_maxLaneSize, lane.cells.size());
+    update();
+}
+
+void BucketLanesItem::endPass() {
+    clearActive();
+    for (int i = m_passLow; i >= 0 && i < m_passHigh; ++i)
+        m_input[i] = Cell{m_output[i], Normal};
+    m_passLow = -1;
+    m_passHigh = -1;
+    update();
+}
+
+void BucketLanesItem::setAllFinal() {
+    clearActive();
+    for (Cell& cell : m_input)
+        cell.state = Final;
+    update();
+}
+
+int BucketLanesItem::bucketCount() const {
+    return m_lanes.size();
+}
+
+int BucketLanesItem::inputCount() const {
+    return m_input.size();
+}
+
+QRectF BucketLanesItem::boundingRect() const {
+    return QRectF(0, 0, m_areaSize.width(), m_areaSize.height());
+}
+
+QColor BucketLanesItem::stateColor(CellState state) {
+    switch (state) {
+    case Swap:   return QColor("#E06C75");
+    case Active: return QColor("#E5C07B");
+    case Moved:  return QColor("#3A3A3A");
+    case Final:  return QColor("#98C379");
+    default:     return QColor("#707070");
+    }
+}
+
+QRectF BucketLanesItem::laneRect(int bucket) const {
+    const qreal top = m_areaSize.height() * kInputRatio + kLaneGap;
+    const qreal height = m_areaSize.height() - kMargin - top;
+    const qreal width = m_areaSize.width() - 2 * kMargin;
+    const int count = qMax(1, m_lanes.size());
+
+    // 每列至少容纳 height / kMinLaneHeight 条桶道，放不下时增加列数
+    const int rowsFit = qMax(1, static_cast<int>(height / kMinLaneHeight));
+    const int columns = (count + rowsFit - 1) / rowsFit;
+    const int rows = (count + columns - 1) / columns;
+    const qreal laneHeight = height / rows;
+    const qreal columnWidth = width / columns;
+
+    const int column = bucket / rows;
+    const int row = bucket % rows;
+    return QRectF(kMargin + column * columnWidth, top + row * laneHeight, columnWidth, laneHeight);
+}
+
+QString BucketLanesItem::laneLabel(int bucket) const {
+    const Lane& lane = m_lanes[bucket];
+    const QString title = m_laneTitle.isEmpty() ? QString("桶 %1").arg(bucket) : m_laneTitle;
+    if (!lane.hasRange && lane.cells.isEmpty())
+        return title;
+    if (lane.low == lane.high)
+        return QString("%1 = %2").arg(title).arg(lane.low);
+    return QString("%1 [%2, %3]").arg(title).arg(lane.low).arg(lane.high);
+}
+
+void BucketLanesItem::paint(QPainter* painter, const QStyleOptionGraphicsItem* option, QWidget* widget) {
+    Q_UNUSED(widget);
+    const QRectF exposed = option->exposedRect;
+
+    const QRectF inputArea(kMargin, kMargin, m_areaSize.width() - 2 * kMargin,
+                           m_areaSize.height() * kInputRatio - kMargin);
+    if (exposed.intersects(inputArea))
+        paintInput(painter, inputArea);
+
+    for (int b = 0; b < m_lanes.size(); ++b) {
+        if (exposed.intersects(laneRect(b)))
+            paintLane(painter, b);
+    }
+}
+
+void BucketLanesItem::paintInput(QPainter* painter, const QRectF& area) {
+    if (m_input.isEmpty()) return;
+
+    // 上方数组按柱状绘制：格宽足够时带数值标签，否则柱子连成一片
+    const qreal slot = qMin(kMaxCellWidth, area.width() / m_input.size());
+    const bool wide = slot >= 6;
+    const qreal barWidth = wide ? slot * 0.8 : slot;
+    const bool labels = slot >= kMinLabelSlot;
+    const qreal baseline = area.bottom() - (labels ? 24 : 0);
+    const qreal maxHeight = baseline - area.top();
+
+    // 分配趟的处理区间在条带下方用一条线标出
+    if (m_passLow >= 0 && m_passHigh > m_passLow) {
+        painter->setPen(QPen(stateColor(Active), 2));
+        painter->drawLine(QPointF(area.left() + m_passLow * slot, baseline + 2),
+                          QPointF(area.left() + m_passHigh * slot, baseline + 2));
+    }
+
+    painter->setPen(wide ? QPen(QColor("#E0E0E0"), 1) : QPen(Qt::NoPen));
+    for (int i = 0; i < m_input.size(); ++i) {
+        const Cell& cell = m_input[i];
+        if (cell.state == Moved) continue;
+        qreal h = qMax<qreal>(1, maxHeight * qMax(0, cell.value) / m_maxInput);
+        painter->setBrush(stateColor(static_cast<CellState>(cell.state)));
+        painter->drawRect(QRectF(area.left() + i * slot + (slot - barWidth) / 2, baseline - h, barWidth, h));
+    }
+
+    if (!labels) return;
+    painter->setPen(QColor("#ABB2BF"));
+    painter->setFont(QFont("Segoe UI", 10, QFont::Bold));
+    for (int i = 0; i < m_input.size(); ++i) {
+        if (m_input[i].state == Moved) continue;
+        painter->drawText(QRectF(area.left() + i * slot, baseline + 4, slot, 20),
+                          Qt::AlignHCenter | Qt::AlignTop, QString::number(m_input[i].value));
+    }
+}
+
+void BucketLanesItem::paintLane(QPainter* painter, int bucket) {
+    const QRectF rect = laneRect(bucket);
+    const Lane& lane = m_lanes[bucket];
+
+    // 桶道足够高、足够宽时在左侧显示桶号与区间
+    const bool showLabel = rect.height() >= 14 && rect.width() >= 2 * kLabelWidth;
+    const qreal labelWidth = showLabel ? kLabelWidth : 0;
+    const QRectF cellsArea = rect.adjusted(labelWidth, rect.height() > 4 ? 1 : 0, -4, 0);
+
+    painter->setPen(Qt::NoPen);
+    painter->setBrush(QColor(bucket % 2 ? "#2F2F2F" : "#353535"));
+    painter->drawRect(rect);
+
+    if (showLabel) {
+        painter->setPen(QColor("#ABB2BF"));
+        painter->setFont(QFont("Segoe UI", qBound(7, static_cast<int>(rect.height() * 0.45), 11)));
+        painter->drawText(QRectF(rect.left() + 4, rect.top(), kLabelWidth - 8, rect.height()),
+                          Qt::AlignLeft | Qt::AlignVCenter, laneLabel(bucket));
+    }
+
+    // 所有桶道共用格宽，列对齐便于比较各桶大小
+    const qreal slot = qMin(kMaxCellWidth, cellsArea.width() / qMax(m_maxLaneSize, lane.count));
+
+    // 基数排序的直方图：计数为空框，散射的元素逐格填入；右端标出计数与前缀和起点
+    if (lane.count > 0) {
+        painter->setPen(QPen(stateColor(Active), 1));
+        painter->setBrush(QColor(229, 192, 123, 50));
+        painter->drawRect(QRectF(cellsArea.left(), cellsArea.top(), lane.count * slot, cellsArea.height()));
+        if (showLabel) {
+            QString text = lane.offset >= 0 ? QString("×%1 @%2").arg(lane.count).arg(lane.offset)
+                                            : QString("×%1").arg(lane.count);
+            painter->setPen(QColor("#ABB2BF"));
+            painter->drawText(cellsArea.adjusted(0, 0, -4, 0), Qt::AlignRight | Qt::AlignVCenter, text);
+        }
+    }
+    if (lane.cells.isEmpty()) return;
+    const bool wide = slot >= 6 && cellsArea.height() >= 6;
+    const qreal cellWidth = wide ? slot - 2 : slot;
+
+    painter->setPen(wide ? QPen(QColor("#E0E0E0"), 1) : QPen(Qt::NoPen));
+    for (int i = 0; i < lane.cells.size(); ++i) {
+        const Cell& cell = lane.cells[i];
+        if (cell.state == Moved) continue;
+        painter->setBrush(stateColor(static_cast<CellState>(cell.state)));
+        painter->drawRect(QRectF(cellsArea.left() + i * slot, cellsArea.top(), cellWidth, cellsArea.height()));
+    }
+
+    if (slot < kMinLabelSlot || cellsArea.height() < 16) return;
+    painter->setPen(Qt::white);
+    painter->setFont(QFont("Segoe UI", 9, QFont::Bold));
+    for (int i = 0; i < lane.cells.size(); ++i) {
+        if (lane.cells[i].state == Moved) continue;
+        painter->drawText(QRectF(cellsArea.left() + i * slot, cellsArea.top(), cellWidth, cellsArea.height()),
+                          Qt::AlignCenter, QString::number(lane.cells[i].value));
+    }
+}
@@ -0,0 +1,90 @@
+#ifndef BUCKETLANESITEM_H
+#define BUCKETLANESITEM_H
+
+#include <QGraphicsItem>
+#include <QStyleOptionGraphicsItem>
+#include <QPainter>
+#include <QVector>
+#include <QPair>
+#include <QSizeF>
+#include <QColor>
+
+// 桶排序与基数排序的整体视图：上方为数组条带，下方为桶道
+// 桶数与各桶区间由数据决定；桶道过多时分多列排布，始终适应视图大小
+class BucketLanesItem : public QGraphicsItem {
+public:
+    enum CellState : quint8 {
+        Normal,     // 普通
+        Swap,       // 刚刚交换
+        Active,     // 正在统计
+        Moved,      // 元素已移走，只留空位
+        Final       // 已回写到输出位置
+    };
+
+    explicit BucketLanesItem(QSizeF areaSize, QGraphicsItem* parent = nullptr);
+
+    void appendInput(int value);
+    void setBucketCount(int count);               // 重新划分桶道，已分配的元素保留
+    void setBucketRange(int bucket, int low, int high);
+    bool assign(int value, int bucket);           // 把上方第一个未分配的 value 移入桶尾
+    bool swapInBucket(int bucket, int i, int j);
+    bool emitFinal(int value);                    // 从桶中取出 value，写入下一个输出位置
+    void clearSwapStates();
+    void clear();
+
+    // 基数排序：每趟先统计直方图，再计算前缀和，最后按前缀和散射
+    void setLaneTitle(const QString& title);      // 以标题代替“桶 i”，桶道区间即数字范围
+    void beginPass(int laneCount, int low, int high); // 清空桶道，本趟只处理 [low, high)
+    void countInto(int index, int bucket);
+    void computePrefix();                         // 各桶起点 = 区间起点 + 之前各桶计数之和
+    void scatter(int index, int dest, int bucket);
+    void endPass();                               // 输出缓冲写回上方数组
+    void setAllFinal();
+
+    int bucketCount() const;
+    int inputCount() const;
+
+    QRectF boundingRect() const override;
+    void paint(QPainter* painter, const QStyleOptionGraphicsItem* option, QWidget* widget = nullptr) override;
+
+    static QColor stateColor(CellState state);
+
+private:
+    struct Cell {
+        int value;
+        quint8 state;
+    };
+    struct Lane {
+        QVector<Cell> cells;
+        int low = 0;
+        int high = 0;
+        bool hasRange = false;  // 区间来自 BUCKET_RANGE；否则按已分配的值统计
+        int count = 0;          // 基数排序的直方图计数
+        int offset = -1;        // 前缀和得到的起点，-1 表示尚未计算
+    };
+
+    QRectF laneRect(int bucket) const;
+    QString laneLabel(int bucket) const;
+    void paintInput(QPainter* painter, const QRectF& area);
+    void paintLane(QPainter* painter, int bucket);
+    void clearActive();
+
+    QSizeF m_areaSize;
+    QVector<Cell> m_input;      // 上方数组：输入值，随后被输出覆盖
+    QVector<Lane> m_lanes;
+    int m_maxInput;
+    int m_maxLaneSize;          // 最长桶道的长度，决定桶内格宽
+    int m_assignCursor;         // 下一个待分配的上方下标（按输入顺序分配时 O(1)）
+    int m_outputCount;          // 已输出的元素个数，即下一个输出位置
+    int m_outputBucket;         // 输出游标：按桶序、桶内顺序取元素
+    int m_outputPos;
+    QVector<QPair<int, int>> m_swapped;   // 带有交换高亮的桶内格子
+
+    QString m_laneTitle;
+    QVector<int> m_output;      // 基数排序本趟的输出缓冲
+    int m_passLow;              // 本趟区间，-1 表示不在分配趟中
+    int m_passHigh;
+    int m_activeInput;          // 正在统计的上方下标
+};
+
+#endif // BUCKETLANESITEM_H
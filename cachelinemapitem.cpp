@@ -0,0 +1,126 @@
+#include "cachelinemapitem.h"
+#include "searchlayout.h"
+
+static const qreal kSideMargin = 40;     // 与柱状图左右留白一致
+static const qreal kTitleHeight = 20;
+static const qreal kLineGap = 4;         // 相邻缓存行之间的间隔
+static const qreal kMaxCell = 40;
+
+CacheLineMapItem::CacheLineMapItem(const QString& title, QSizeF areaSize, QGraphicsItem* parent)
+    : QGraphicsItem(parent), m_title(title), m_areaSize(areaSize), m_result(-1), m_queries(0), m_totalLines(0) {}
+
+void CacheLineMapItem::setMemory(const QVector<int>& values, const QVector<int>& ranks) {
+    m_values = values;
+    m_ranks = ranks;
+    m_probes.clear();
+    m_touchedLines.clear();
+    m_result = -1;
+    m_queries = 0;
+    m_totalLines = 0;
+    update();
+}
+
+void CacheLineMapItem::beginQuery() {
+    m_probes.clear();
+    m_touchedLines.clear();
+    m_result = -1;
+    ++m_queries;
+    update();
+}
+
+void CacheLineMapItem::probe(int pos) {
+    if (pos < 0 || pos >= m_values.size()) return;
+    m_probes.append(pos);
+    const int line = pos / SearchLayout::KeysPerLine;
+    if (!m_touchedLines.contains(line)) {
+        m_touchedLines.insert(line);
+        ++m_totalLines;
+    }
+    update();
+}
+
+void CacheLineMapItem::setResult(int pos) {
+    m_result = pos;
+    update();
+}
+
+int CacheLineMapItem::linesThisQuery() const {
+    return m_touchedLines.size();
+}
+
+int CacheLineMapItem::queryCount() const {
+    return m_queries;
+}
+
+double CacheLineMapItem::averageLines() const {
+    return m_queries > 0 ? static_cast<double>(m_totalLines) / m_queries : 0;
+}
+
+QRectF CacheLineMapItem::boundingRect() const {
+    return QRectF(0, 0, m_areaSize.width(), m_areaSize.height());
+}
+
+void CacheLineMapItem::paint(QPainter* painter, const QStyleOptionGraphicsItem* option, QWidget* widget) {
+    Q_UNUSED(option);
+    Q_UNUSED(widget);
+    const int keys = SearchLayout::KeysPerLine;
+
+    painter->setFont(QFont("Segoe UI", 9, QFont::Bold));
+    painter->setPen(QColor("#ABB2BF"));
+    QString title = m_title;
+    if (m_queries > 0)
+        title += QString("    本次 %1 条缓存行 · 平均 %2 条").arg(linesThisQuery()).arg(averageLines(), 0, 'f', 2);
+    painter->drawText(QRectF(kSideMargin, 0, m_areaSize.width() - 2 * kSideMargin, kTitleHeight),
+                      Qt::AlignLeft | Qt::AlignVCenter, title);
+    if (m_values.isEmpty()) return;
+
+    // 选择每行放几条缓存行，使格子尽可能大
+    const int lines = (m_values.size() + keys - 1) / keys;
+    const qreal width = m_areaSize.width() - 2 * kSideMargin;
+    const qreal height = m_areaSize.height() - kTitleHeight - 4;
+    int perRow = 1;
+    qreal cell = 0;
+    for (int candidate = 1; candidate <= lines; ++candidate) {
+        const int rows = (lines + candidate - 1) / candidate;
+        const qreal size = qMin((width - (candidate - 1) * kLineGap) / (candidate * keys), (height - (rows - 1) * kLineGap) / rows);
+        if (size > cell) {
+            cell = size;
+            perRow = candidate;
+        }
+    }
+    cell = qMin(cell, kMaxCell);
+    if (cell < 1) return;
+
+    const bool showText = cell >= 16;
+    painter->setFont(QFont("Segoe UI", qBound(5, static_cast<int>(cell * 0.3), 9)));
+    for (int line = 0; line < lines; ++line) {
+        const qreal x = kSideMargin + (line % perRow) * (keys * cell + kLineGap);
+        const qreal y = kTitleHeight + 4 + (line / perRow) * (cell + kLineGap);
+        for (int i = 0; i < keys; ++i) {
+            const int pos = line * keys + i;
+            const QRectF rect(x + i * cell, y, cell, cell);
+            const bool isKey = pos < m_values.size() && m_ranks.value(pos, -1) >= 0;
+            const bool highlighted = m_probes.contains(pos) || pos == m_result;
+            QColor color = isKey ? QColor("#4B5263") : QColor("#2A2A2A");
+            if (m_probes.contains(pos))
+                color = QColor("#E5C07B");
+            if (pos == m_result)
+                color = QColor("#98C379");
+            painter->setPen(QPen(QColor("#333333"), 1));
+            painter->setBrush(color);
+            painter->drawRect(rect);
+
+            if (showText && isKey) {
+                painter->setPen(highlighted ? QColor("#282C34") : QColor("#ABB2BF"));
+                painter->drawText(rect, Qt::AlignCenter, QString::number(m_values[pos]));
+            }
+        }
+
+        // 本次查询触及的缓存行描边
+        if (m_touchedLines.contains(line)) {
+            painter->setPen(QPen(QColor("#E5C07B"), 2));
+            painter->setBrush(Qt::NoBrush);
+            painter->drawRect(QRectF(x - 1, y - 1, keys * cell + 2, cell + 2));
+        }
+    }
+}
@@ -0,0 +1,43 @@
+#ifndef CACHELINEMAPITEM_H
+#define CACHELINEMAPITEM_H
+
+#include <QGraphicsItem>
+#include <QStyleOptionGraphicsItem>
+#include <QPainter>
+#include <QVector>
+#include <QSet>
+#include <QSizeF>
+#include <QString>
+
+// 一种查找布局的内存图：每 16 个槽位为一条缓存行，按行排成网格
+// 当前查询探查过的槽位与所在缓存行高亮，标题栏给出本次与平均触及的缓存行数
+class CacheLineMapItem : public QGraphicsItem {
+public:
+    CacheLineMapItem(const QString& title, QSizeF areaSize, QGraphicsItem* parent = nullptr);
+
+    // values 为布局的内存内容，ranks 为各槽位对应的有序下标，-1 表示填充或未使用的槽位
+    void setMemory(const QVector<int>& values, const QVector<int>& ranks);
+    void beginQuery();
+    void probe(int pos);
+    void setResult(int pos);                  // 不存在时为 -1
+
+    int linesThisQuery() const;
+    int queryCount() const;
+    double averageLines() const;              // 平均每次查询触及的缓存行数
+
+    QRectF boundingRect() const override;
+    void paint(QPainter* painter, const QStyleOptionGraphicsItem* option, QWidget* widget = nullptr) override;
+
+private:
+    QString m_title;
+    QSizeF m_areaSize;
+    QVector<int> m_values;
+    QVector<int> m_ranks;
+    QVector<int> m_probes;                    // 本次查询按顺序探查的槽位
+    QSet<int> m_touchedLines;
+    int m_result;
+    int m_queries;
+    int m_totalLines;
+};
+
+#endif // CACHELINEMAPITEM_H
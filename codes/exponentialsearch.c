@@ -0,0 +1,81 @@
+#include <stdio.h>
+#include <stdlib.h>
+
+#define N 16                        /* 演示数组的长度；规模测试时由 argv[1] 指定 n */
+
+int demo[N] = {3, 9, 14, 21, 25, 32, 38, 44, 51, 57, 62, 70, 76, 83, 88, 95};
+int *a = demo;
+int n = N;
+volatile int sink;                  /* 规模测试时累计查找结果，防止查找被整体优化掉 */
+
+/* 在 [left, right] 内折半 */
+int binarySearch(int left, int right, int target) {
+    while (left <= right) {
+        int mid = left + (right - left) / 2;
+        TRACE("RANGE %d %d %d\n", left, right, mid);
+        if (a[mid] == target) {
+            TRACE("FOUND_INDEX %d\n", mid);
+            return mid;
+        }
+        if (a[mid] < target)
+            left = mid + 1;
+        else
+            right = mid - 1;
+    }
+    TRACE("NOT_FOUND %d\n", target);
+    return -1;
+}
+
+/* 依次探查 0、1、2、4…直到越过目标，再在最后一段 (bound / 2, bound) 内折半 */
+int exponentialSearch(int target) {
+    TRACE("RANGE %d %d %d\n", 0, n - 1, 0);
+    if (a[0] == target) {
+        TRACE("FOUND_INDEX %d\n", 0);
+        return 0;
+    }
+    if (a[0] > target) {
+        TRACE("NOT_FOUND %d\n", target);
+        return -1;
+    }
+
+    int bound = 1;
+    while (bound < n) {
+        TRACE("RANGE %d %d %d\n", bound / 2 + 1, n - 1, bound);
+        if (a[bound] == target) {
+            TRACE("FOUND_INDEX %d\n", bound);
+            return bound;
+        }
+        if (a[bound] > target)
+            break;
+        bound = bound > n / 2 ? n : bound * 2;
+    }
+    return binarySearch(bound / 2 + 1, (bound < n ? bound : n) - 1, target);
+}
+
+/* 不带参数时在演示数组中查找一次；规模测试以 argv[1] 传入 n，
+   在 n 个递增的键中做 n 次伪随机查找（n = 0 只测启动开销） */
+int main(int argc, char **argv) {
+    if (argc < 2) {
+        for (int i = 0; i < n; i++)
+            TRACE("INSERT %d\n", a[i]);
+        exponentialSearch(32);
+        return 0;
+    }
+
+    n = atoi(argv[1]);
+    if (n <= 0) return 0;
+    a = malloc(n * sizeof(int));
+    unsigned seed = 1;
+    for (int i = 0; i < n; i++) {   /* 相邻键的间隔为 1…5 */
+        seed = seed * 1103515245u + 12345u;
+        a[i] = 3 * i + (int)((seed >> 16) % 3);
+    }
+    int found = 0;
+    for (int q = 0; q < n; q++) {
+        seed = seed * 1103515245u + 12345u;
+        found += exponentialSearch((int)((seed >> 1) % (3u * n + 3))) >= 0;
+    }
+    sink = found;
+    free(a);
+    return 0;
+}
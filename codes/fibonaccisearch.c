@@ -0,0 +1,78 @@
+#include <stdio.h>
+#include <stdlib.h>
+
+#define N 16                        /* 演示数组的长度；规模测试时由 argv[1] 指定 n */
+
+int demo[N] = {3, 9, 14, 21, 25, 32, 38, 44, 51, 57, 62, 70, 76, 83, 88, 95};
+int *a = demo;
+int n = N;
+volatile int sink;                  /* 规模测试时累计查找结果，防止查找被整体优化掉 */
+
+/* 按斐波那契数划分区间：候选区间为 [offset + 1, offset + fib]，在 offset + fib2 处探查 */
+int fibonacciSearch(int target) {
+    int fib2 = 0, fib1 = 1, fib = 1;
+    while (fib < n) {
+        fib2 = fib1;
+        fib1 = fib;
+        fib = fib1 + fib2;
+    }
+
+    int offset = -1;
+    while (fib > 1) {
+        int i = offset + fib2 < n - 1 ? offset + fib2 : n - 1;
+        TRACE("RANGE %d %d %d\n", offset + 1, offset + fib < n - 1 ? offset + fib : n - 1, i);
+        if (a[i] == target) {
+            TRACE("FOUND_INDEX %d\n", i);
+            return i;
+        }
+        if (a[i] < target) {
+            if (i == n - 1)
+                break;
+            fib = fib1;
+            fib1 = fib2;
+            fib2 = fib - fib1;
+            offset = i;
+        } else {
+            fib = fib2;
+            fib1 = fib1 - fib2;
+            fib2 = fib - fib1;
+        }
+    }
+    if (fib == 1 && offset + 1 < n) {
+        TRACE("RANGE %d %d %d\n", offset + 1, offset + 1, offset + 1);
+        if (a[offset + 1] == target) {
+            TRACE("FOUND_INDEX %d\n", offset + 1);
+            return offset + 1;
+        }
+    }
+    TRACE("NOT_FOUND %d\n", target);
+    return -1;
+}
+
+/* 不带参数时在演示数组中查找一次；规模测试以 argv[1] 传入 n，
+   在 n 个递增的键中做 n 次伪随机查找（n = 0 只测启动开销） */
+int main(int argc, char **argv) {
+    if (argc < 2) {
+        for (int i = 0; i < n; i++)
+            TRACE("INSERT %d\n", a[i]);
+        fibonacciSearch(76);
+        return 0;
+    }
+
+    n = atoi(argv[1]);
+    if (n <= 0) return 0;
+    a = malloc(n * sizeof(int));
+    unsigned seed = 1;
+    for (int i = 0; i < n; i++) {   /* 相邻键的间隔为 1…5 */
+        seed = seed * 1103515245u + 12345u;
+        a[i] = 3 * i + (int)((seed >> 16) % 3);
+    }
+    int found = 0;
+    for (int q = 0; q < n; q++) {
+        seed = seed * 1103515245u + 12345u;
+        found += fibonacciSearch((int)((seed >> 1) % (3u * n + 3))) >= 0;
+    }
+    sink = found;
+    free(a);
+    return 0;
+}
@@ -0,0 +1,58 @@
+#include <stdio.h>
+#include <stdlib.h>
+
+#define N 16                        /* 演示数组的长度；规模测试时由 argv[1] 指定 n */
+
+int demo[N] = {3, 9, 14, 21, 25, 32, 38, 44, 51, 57, 62, 70, 76, 83, 88, 95};
+int *a = demo;
+int n = N;
+volatile int sink;                  /* 规模测试时累计查找结果，防止查找被整体优化掉 */
+
+/* 按目标值在 a[left]…a[right] 间的比例估计位置；键分布越均匀，估计越准 */
+int interpolationSearch(int target) {
+    int left = 0, right = n - 1;
+    while (left <= right && target >= a[left] && target <= a[right]) {
+        int mid = left;
+        if (a[right] != a[left])
+            mid = left + (int)((long long)(target - a[left]) * (right - left) / (a[right] - a[left]));
+        TRACE("RANGE %d %d %d\n", left, right, mid);
+        if (a[mid] == target) {
+            TRACE("FOUND_INDEX %d\n", mid);
+            return mid;
+        }
+        if (a[mid] < target)
+            left = mid + 1;
+        else
+            right = mid - 1;
+    }
+    TRACE("NOT_FOUND %d\n", target);
+    return -1;
+}
+
+/* 不带参数时在演示数组中查找一次；规模测试以 argv[1] 传入 n，
+   在 n 个递增的键中做 n 次伪随机查找（n = 0 只测启动开销） */
+int main(int argc, char **argv) {
+    if (argc < 2) {
+        for (int i = 0; i < n; i++)
+            TRACE("INSERT %d\n", a[i]);
+        interpolationSearch(70);
+        return 0;
+    }
+
+    n = atoi(argv[1]);
+    if (n <= 0) return 0;
+    a = malloc(n * sizeof(int));
+    unsigned seed = 1;
+    for (int i = 0; i < n; i++) {   /* 相邻键的间隔为 1…5 */
+        seed = seed * 1103515245u + 12345u;
+        a[i] = 3 * i + (int)((seed >> 16) % 3);
+    }
+    int found = 0;
+    for (int q = 0; q < n; q++) {
+        seed = seed * 1103515245u + 12345u;
+        found += interpolationSearch((int)((seed >> 1) % (3u * n + 3))) >= 0;
+    }
+    sink = found;
+    free(a);
+    return 0;
+}
@@ -0,0 +1,143 @@
+#include <stdio.h>
+#include <stdlib.h>
+
+#define N 20                        /* 演示数组的长度；规模测试时由 argv[1] 指定 n */
+#define THRESHOLD 4                 /* 不超过该长度的区间直接插入排序 */
+
+void swap(int a[], int i, int j) {
+    int t = a[i];
+    a[i] = a[j];
+    a[j] = t;
+    TRACE("SWAP %d %d\n", i, j);
+}
+
+/* 插入排序：小区间上比快速排序更快 */
+void insertionSort(int a[], int lo, int hi) {
+    for (int i = lo + 1; i <= hi; i++) {
+        for (int j = i; j > lo; j--) {
+            TRACE("COMPARE %d %d\n", j - 1, j);
+            if (a[j - 1] <= a[j]) break;
+            swap(a, j - 1, j);
+        }
+    }
+    for (int i = lo; i <= hi; i++)
+        TRACE("MARK_SORTED %d\n", i);
+}
+
+/* 堆排序：递归过深时的回退方案，保证最坏 O(n log n) */
+void siftDown(int a[], int lo, int root, int size) {
+    while (2 * root + 1 < size) {
+        int child = 2 * root + 1;
+        if (child + 1 < size) {
+            TRACE("COMPARE %d %d\n", lo + child, lo + child + 1);
+            if (a[lo + child] < a[lo + child + 1]) child++;
+        }
+        TRACE("COMPARE %d %d\n", lo + root, lo + child);
+        if (a[lo + root] >= a[lo + child]) return;
+        swap(a, lo + root, lo + child);
+        root = child;
+    }
+}
+
+void heapSort(int a[], int lo, int hi) {
+    int size = hi - lo + 1;
+    TRACE("HEAP_FALLBACK %d %d\n", lo, hi);
+    for (int i = size / 2 - 1; i >= 0; i--)
+        siftDown(a, lo, i, size);
+    for (int end = size - 1; end > 0; end--) {
+        swap(a, lo, lo + end);
+        siftDown(a, lo, 0, end);
+    }
+    for (int i = lo; i <= hi; i++)
+        TRACE("MARK_SORTED %d\n", i);
+}
+
+/* 三数取中：把首、中、尾的中位数换到 a[lo] 作为主元 */
+void medianOf3(int a[], int lo, int hi) {
+    int mid = lo + (hi - lo) / 2;
+    TRACE("COMPARE %d %d\n", lo, mid);
+    if (a[mid] < a[lo]) swap(a, lo, mid);
+    TRACE("COMPARE %d %d\n", mid, hi);
+    if (a[hi] < a[mid]) swap(a, mid, hi);
+    TRACE("COMPARE %d %d\n", lo, mid);
+    if (a[mid] < a[lo]) swap(a, lo, mid);
+    swap(a, lo, mid);
+}
+
+/* Hoare 划分：左右指针相向扫描，返回分界点 j（a[lo..j] <= 主元 <= a[j+1..hi]） */
+int partition(int a[], int lo, int hi) {
+    int pivot = a[lo];
+    int i = lo - 1, j = hi + 1;
+    TRACE("PIVOT %d %d\n", lo, pivot);
+    while (1) {
+        do {
+            i++;
+            TRACE("COMPARE_A %d %d\n", i, lo);
+        } while (a[i] < pivot);
+        do {
+            j--;
+            TRACE("COMPARE_B %d %d\n", j, lo);
+        } while (a[j] > pivot);
+        if (i >= j) return j;
+        swap(a, i, j);
+    }
+}
+
+/* 内省排序：快速排序，区间足够小时插入排序，深度用完时改用堆排序 */
+void introSort(int a[], int lo, int hi, int depthLimit) {
+    while (hi - lo + 1 > THRESHOLD) {
+        if (depthLimit == 0) {
+            heapSort(a, lo, hi);
+            return;
+        }
+        depthLimit--;
+        medianOf3(a, lo, hi);
+        int p = partition(a, lo, hi);
+        /* 先递归较短的一侧，较长的一侧留在循环里，栈深不超过 log n */
+        if (p - lo < hi - p) {
+            introSort(a, lo, p, depthLimit);
+            lo = p + 1;
+        } else {
+            introSort(a, p + 1, hi, depthLimit);
+            hi = p;
+        }
+    }
+    if (lo <= hi)
+        insertionSort(a, lo, hi);
+}
+
+/* 不带参数时排序演示数组；规模测试以 argv[1] 传入 n，排序 n 个伪随机数（n = 0 只测启动开销），
+   结果未排好序时退出码为 1 */
+int main(int argc, char **argv) {
+    int demo[N] = {38, 27, 43, 3, 9, 82, 10, 55, 17, 64, 3, 91, 26, 48, 72, 5, 33, 60, 21, 14};
+    int *a = demo;
+    int n = N;
+    if (argc >= 2) {
+        n = atoi(argv[1]);
+        if (n <= 0) return 0;
+        a = malloc(n * sizeof(int));
+        unsigned seed = 1;
+        for (int i = 0; i < n; i++) {
+            seed = seed * 1103515245u + 12345u;
+            a[i] = (int)(seed >> 1);
+        }
+    }
+    for (int i = 0; i < n; i++)
+        TRACE("INSERT %d\n", a[i]);
+
+    int depthLimit = 0;             /* 2·log2(n) */
+    for (int m = n; m > 1; m >>= 1)
+        depthLimit += 2;
+
+    introSort(a, 0, n - 1, depthLimit);
+    TRACE("SORT_FINISHED\n");
+
+    int unsorted = 0;
+    for (int i = 0; i < n; i++) {
+        TRACE("%d ", a[i]);
+        if (i > 0 && a[i - 1] > a[i]) unsorted = 1;
+    }
+    TRACE("\n");
+    if (a != demo) free(a);
+    return unsorted;
+}
@@ -0,0 +1,152 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <limits.h>
+
+#define N 40                        /* 演示数组的长度；规模测试时由 argv[1] 指定 n */
+#define B 16                        /* 一条 64 字节缓存行的 int 个数，也是 B 树节点的键数 */
+#define QUERIES 6
+
+/* 三种布局按缓存行对齐，内存位置 / 16 即所在的缓存行 */
+int n = N;
+int blocks;                         /* B 树节点数 (n + B - 1) / B */
+int *sorted;
+int *eytzinger;                     /* n + 1 个，下标从 1 开始，0 不用 */
+int *btree;                         /* blocks * B 个，最后一个节点不满时用 INT_MAX 填充 */
+int *ranksE;                        /* 内存位置对应的有序下标，-1 为未用或填充 */
+int *ranksB;
+volatile int sink;                  /* 规模测试时累计查找结果，防止查找被整体优化掉 */
+
+/* 多申请一条缓存行，起点向上取整到 64 字节；程序结束时由系统回收 */
+int *alignedInts(int count) {
+    char *raw = malloc((size_t)count * sizeof(int) + 64);
+    return (int *)(((uintptr_t)raw + 63) & ~(uintptr_t)63);
+}
+
+/* 中序遍历隐式二叉树，依次填入有序键 */
+int buildEytzinger(int k, int next) {
+    if (k > n) return next;
+    next = buildEytzinger(2 * k, next);
+    ranksE[k] = next;
+    eytzinger[k] = sorted[next++];
+    return buildEytzinger(2 * k + 1, next);
+}
+
+/* 中序遍历隐式 B 树：节点 k 的第 i 个孩子为 k * (B + 1) + i + 1 */
+int buildBTree(int k, int next) {
+    if (k >= blocks) return next;
+    for (int i = 0; i < B; i++) {
+        next = buildBTree(k * (B + 1) + i + 1, next);
+        if (next < n) {
+            ranksB[k * B + i] = next;
+            btree[k * B + i] = sorted[next++];
+        } else {
+            ranksB[k * B + i] = -1;
+            btree[k * B + i] = INT_MAX;
+        }
+    }
+    return buildBTree(k * (B + 1) + B + 1, next);
+}
+
+/* 无分支折半查找：每步只根据比较结果移动起点 */
+int searchSorted(int x) {
+    int *base = sorted;
+    int length = n;
+    while (length > 1) {
+        int half = length / 2;
+        length -= half;
+        TRACE("LAYOUT_PROBE 0 %d\n", (int)(base - sorted) + half - 1);
+        base += (base[half - 1] < x) * half;
+    }
+    TRACE("LAYOUT_PROBE 0 %d\n", (int)(base - sorted));
+    int pos = (int)(base - sorted) + (*base < x);
+    if (pos < n)
+        TRACE("LAYOUT_RESULT 0 %d %d\n", pos, pos);
+    else
+        TRACE("LAYOUT_RESULT 0 -1 -1\n");
+    return pos < n ? pos : -1;
+}
+
+/* 沿隐式二叉树下降；最后一次向左走的位置即答案 */
+int searchEytzinger(int x) {
+    unsigned k = 1;
+    while (k <= (unsigned)n) {
+        TRACE("LAYOUT_PROBE 1 %u\n", k);
+        k = 2 * k + (eytzinger[k] < x);
+    }
+    while (k & 1)
+        k >>= 1;
+    k >>= 1;
+    if (k != 0)
+        TRACE("LAYOUT_RESULT 1 %u %d\n", k, ranksE[k]);
+    else
+        TRACE("LAYOUT_RESULT 1 -1 -1\n");
+    return k != 0 ? (int)k : -1;
+}
+
+/* 每个节点统计小于目标的键数 i，再进入第 i 个孩子 */
+int searchBTree(int x) {
+    int k = 0, result = -1;
+    while (k < blocks) {
+        int i = 0;
+        for (int j = 0; j < B; j++)
+            i += btree[k * B + j] < x;
+        TRACE("LAYOUT_PROBE 2 %d\n", k * B + (i < B ? i : B - 1));
+        if (i < B)
+            result = k * B + i;
+        k = k * (B + 1) + i + 1;
+    }
+    if (result >= 0 && ranksB[result] >= 0)
+        TRACE("LAYOUT_RESULT 2 %d %d\n", result, ranksB[result]);
+    else
+        TRACE("LAYOUT_RESULT 2 -1 -1\n");
+    return result >= 0 && ranksB[result] >= 0 ? result : -1;
+}
+
+/* 不带参数时用 N 个键演示 QUERIES 次查询；规模测试以 argv[1] 传入 n，
+   在 n 个键上做 n 次伪随机查询（n = 0 只测启动开销） */
+int main(int argc, char **argv) {
+    int benchmark = argc >= 2;
+    if (benchmark) {
+        n = atoi(argv[1]);
+        if (n <= 0) return 0;
+    }
+    blocks = (n + B - 1) / B;
+    sorted = alignedInts(n);
+    eytzinger = alignedInts(n + 1);
+    btree = alignedInts(blocks * B);
+    ranksE = malloc((n + 1) * sizeof(int));
+    ranksB = malloc(blocks * B * sizeof(int));
+
+    for (int i = 0; i < n; i++) {
+        sorted[i] = 3 * i + 2;
+        TRACE("INSERT %d\n", sorted[i]);
+    }
+    ranksE[0] = -1;
+    eytzinger[0] = INT_MIN;
+    buildEytzinger(1, 0);
+    buildBTree(0, 0);
+
+    if (benchmark) {
+        unsigned seed = 1;
+        int found = 0;
+        for (int q = 0; q < n; q++) {
+            seed = seed * 1103515245u + 12345u;
+            int x = (int)((seed >> 1) % (3u * n + 3));
+            found += searchSorted(x) + searchEytzinger(x) + searchBTree(x);
+        }
+        sink = found;
+        return 0;
+    }
+
+    /* 命中的键、落在两个键之间的值、小于最小键与大于最大键的值 */
+    int queries[QUERIES] = {50, 2, 95, 31, 0, 200};
+    for (int q = 0; q < QUERIES; q++) {
+        TRACE("LAYOUT_QUERY %d\n", queries[q]);
+        searchSorted(queries[q]);
+        searchEytzinger(queries[q]);
+        searchBTree(queries[q]);
+    }
+    TRACE("SORT_FINISHED\n");
+    return 0;
+}
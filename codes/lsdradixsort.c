@@ -0,0 +1,79 @@
+#include <stdio.h>
+#include <stdlib.h>
+
+#define N 10                        /* 演示数组的长度；规模测试时由 argv[1] 指定 n */
+#define BITS 4                      /* 每趟处理的位数，基数为 2^BITS */
+#define RADIX (1 << BITS)
+
+/* LSD 基数排序：从最低位开始，每一趟都是一次稳定的计数排序 */
+void radixSort(int a[], int n) {
+    int *buffer = malloc(n * sizeof(int));
+    int count[RADIX + 1];
+    int maxValue = a[0];
+    for (int i = 1; i < n; i++)
+        if (a[i] > maxValue) maxValue = a[i];
+
+    /* shift 不能达到 int 的位宽，否则移位未定义 */
+    for (int shift = 0; shift < 31 && (maxValue >> shift) > 0; shift += BITS) {
+        TRACE("RADIX_RANGE %d %d\n", 0, n);
+        TRACE("RADIX_PASS %d %d\n", shift, BITS);
+
+        /* 1. 直方图：统计每个数字出现的次数 */
+        for (int d = 0; d <= RADIX; d++)
+            count[d] = 0;
+        for (int i = 0; i < n; i++) {
+            int d = (a[i] >> shift) & (RADIX - 1);
+            count[d + 1]++;
+            TRACE("RADIX_COUNT %d %d\n", i, d);
+        }
+
+        /* 2. 前缀和：count[d] 变为数字 d 的起始位置 */
+        TRACE("RADIX_PREFIX\n");
+        for (int d = 0; d < RADIX; d++)
+            count[d + 1] += count[d];
+
+        /* 3. 散射：按原顺序写入输出，保证稳定 */
+        for (int i = 0; i < n; i++) {
+            int d = (a[i] >> shift) & (RADIX - 1);
+            int dest = count[d]++;
+            buffer[dest] = a[i];
+            TRACE("RADIX_SCATTER %d %d %d\n", i, dest, d);
+        }
+        for (int i = 0; i < n; i++)
+            a[i] = buffer[i];
+        TRACE("RADIX_DONE\n");
+    }
+    free(buffer);
+    TRACE("SORT_FINISHED\n");
+}
+
+/* 不带参数时排序演示数组；规模测试以 argv[1] 传入 n，排序 n 个伪随机数（n = 0 只测启动开销），
+   结果未排好序时退出码为 1 */
+int main(int argc, char **argv) {
+    int demo[N] = {170, 45, 75, 90, 802, 24, 2, 66, 131, 7};
+    int *a = demo;
+    int n = N;
+    if (argc >= 2) {
+        n = atoi(argv[1]);
+        if (n <= 0) return 0;
+        a = malloc(n * sizeof(int));
+        unsigned seed = 1;
+        for (int i = 0; i < n; i++) {
+            seed = seed * 1103515245u + 12345u;
+            a[i] = (int)(seed >> 1);
+        }
+    }
+    for (int i = 0; i < n; i++)
+        TRACE("INSERT %d\n", a[i]);
+
+    radixSort(a, n);
+
+    int unsorted = 0;
+    for (int i = 0; i < n; i++) {
+        TRACE("%d ", a[i]);
+        if (i > 0 && a[i - 1] > a[i]) unsorted = 1;
+    }
+    TRACE("\n");
+    if (a != demo) free(a);
+    return unsorted;
+}
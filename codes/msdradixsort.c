@@ -0,0 +1,93 @@
+#include <stdio.h>
+#include <stdlib.h>
+
+#define N 10                        /* 演示数组的长度；规模测试时由 argv[1] 指定 n */
+#define BITS 4                      /* 每趟处理的位数，基数为 2^BITS */
+#define RADIX (1 << BITS)
+
+int *buffer;
+
+/* MSD 基数排序：按当前最高位把 a[lo, hi) 分配到各桶，再对每个桶递归处理下一位 */
+void radixSort(int a[], int lo, int hi, int shift) {
+    int count[RADIX + 1];
+    if (hi - lo < 2) return;
+
+    TRACE("RADIX_RANGE %d %d\n", lo, hi);
+    TRACE("RADIX_PASS %d %d\n", shift, BITS);
+
+    /* 1. 直方图 */
+    for (int d = 0; d <= RADIX; d++)
+        count[d] = 0;
+    for (int i = lo; i < hi; i++) {
+        int d = (a[i] >> shift) & (RADIX - 1);
+        count[d + 1]++;
+        TRACE("RADIX_COUNT %d %d\n", i, d);
+    }
+
+    /* 2. 前缀和：count[d] 为数字 d 的起始位置（从 lo 开始） */
+    TRACE("RADIX_PREFIX\n");
+    count[0] = lo;
+    for (int d = 0; d < RADIX; d++)
+        count[d + 1] += count[d];
+
+    /* 3. 散射 */
+    int next[RADIX];
+    for (int d = 0; d < RADIX; d++)
+        next[d] = count[d];
+    for (int i = lo; i < hi; i++) {
+        int d = (a[i] >> shift) & (RADIX - 1);
+        int dest = next[d]++;
+        buffer[dest] = a[i];
+        TRACE("RADIX_SCATTER %d %d %d\n", i, dest, d);
+    }
+    for (int i = lo; i < hi; i++)
+        a[i] = buffer[i];
+    TRACE("RADIX_DONE\n");
+
+    /* 4. 每个桶按下一位继续排序 */
+    if (shift == 0) return;
+    for (int d = 0; d < RADIX; d++)
+        radixSort(a, count[d], count[d + 1], shift - BITS);
+}
+
+/* 不带参数时排序演示数组；规模测试以 argv[1] 传入 n，排序 n 个伪随机数（n = 0 只测启动开销），
+   结果未排好序时退出码为 1 */
+int main(int argc, char **argv) {
+    int demo[N] = {170, 45, 75, 90, 802, 24, 2, 66, 131, 7};
+    int *a = demo;
+    int n = N;
+    if (argc >= 2) {
+        n = atoi(argv[1]);
+        if (n <= 0) return 0;
+        a = malloc(n * sizeof(int));
+        unsigned seed = 1;
+        for (int i = 0; i < n; i++) {
+            seed = seed * 1103515245u + 12345u;
+            a[i] = (int)(seed >> 1);
+        }
+    }
+    buffer = malloc(n * sizeof(int));
+    for (int i = 0; i < n; i++)
+        TRACE("INSERT %d\n", a[i]);
+
+    /* 最高位所在的趟：演示数组中 802 需要 10 位，按 4 位一趟从第 8 位开始 */
+    int maxValue = a[0];
+    for (int i = 1; i < n; i++)
+        if (a[i] > maxValue) maxValue = a[i];
+    int shift = 0;
+    while ((maxValue >> shift) >= RADIX)
+        shift += BITS;
+
+    radixSort(a, 0, n, shift);
+    TRACE("SORT_FINISHED\n");
+
+    int unsorted = 0;
+    for (int i = 0; i < n; i++) {
+        TRACE("%d ", a[i]);
+        if (i > 0 && a[i - 1] > a[i]) unsorted = 1;
+    }
+    TRACE("\n");
+    free(buffer);
+    if (a != demo) free(a);
+    return unsorted;
+}
@@ -0,0 +1,133 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdarg.h>
+#include <pthread.h>
+
+#define N 32                        /* 演示数组的长度；规模测试时由 argv[1] 指定 n */
+#define WORKERS 4                   /* 工作者（线程）个数，取 2 的幂 */
+#define GRAIN 4                     /* 不超过该长度的区间直接插入排序 */
+
+int n = N;
+int *a;
+int *buffer;
+int nextWorker = 1;                 /* 0 号工作者为主线程 */
+pthread_mutex_t lock = PTHREAD_MUTEX_INITIALIZER;
+
+/* 多个线程同时输出时加锁，保证每条事件完整占一行；基准版本与 TRACE 一样不输出，也不加锁 */
+void event(const char *format, ...) {
+#ifdef VISUAL_BENCH
+    (void)format;
+#else
+    va_list args;
+    va_start(args, format);
+    pthread_mutex_lock(&lock);
+    vprintf(format, args);
+    fflush(stdout);
+    pthread_mutex_unlock(&lock);
+    va_end(args);
+#endif
+}
+
+typedef struct {
+    int lo, hi, depth, worker;
+} Task;
+
+void mergeSort(int lo, int hi, int depth, int worker);
+
+void *runTask(void *arg) {
+    Task *task = (Task *)arg;
+    mergeSort(task->lo, task->hi, task->depth, task->worker);
+    return NULL;
+}
+
+/* 对 a[lo, hi) 排序：depth > 0 时左半边交给新线程，右半边由当前线程继续 */
+void mergeSort(int lo, int hi, int depth, int worker) {
+    event("PAR_TASK %d %d %d\n", worker, lo, hi);
+
+    if (hi - lo <= GRAIN) {
+        for (int i = lo + 1; i < hi; i++) {
+            int v = a[i], j = i - 1;
+            while (j >= lo && a[j] > v) {
+                a[j + 1] = a[j];
+                j--;
+            }
+            a[j + 1] = v;
+        }
+        for (int i = lo; i < hi; i++)
+            event("PAR_WRITE %d %d %d\n", i, a[i], worker);
+        event("PAR_IDLE %d\n", worker);
+        return;
+    }
+
+    int mid = lo + (hi - lo) / 2;
+    if (depth > 0) {
+        pthread_t thread;
+        Task left = {lo, mid, depth - 1, 0};
+        pthread_mutex_lock(&lock);
+        left.worker = nextWorker++;
+        pthread_mutex_unlock(&lock);
+        pthread_create(&thread, NULL, runTask, &left);
+        mergeSort(mid, hi, depth - 1, worker);
+
+        /* 等待左半边：等待期间记为空闲 */
+        event("PAR_IDLE %d\n", worker);
+        pthread_join(thread, NULL);
+        event("PAR_TASK %d %d %d\n", worker, lo, hi);
+    } else {
+        mergeSort(lo, mid, 0, worker);
+        mergeSort(mid, hi, 0, worker);
+        event("PAR_TASK %d %d %d\n", worker, lo, hi);
+    }
+
+    /* 合并到缓冲区后写回 */
+    int i = lo, j = mid, k = lo;
+    while (i < mid && j < hi)
+        buffer[k++] = a[i] <= a[j] ? a[i++] : a[j++];
+    while (i < mid)
+        buffer[k++] = a[i++];
+    while (j < hi)
+        buffer[k++] = a[j++];
+    for (k = lo; k < hi; k++) {
+        a[k] = buffer[k];
+        event("PAR_WRITE %d %d %d\n", k, a[k], worker);
+    }
+    event("PAR_IDLE %d\n", worker);
+}
+
+/* 不带参数时排序演示数组；规模测试以 argv[1] 传入 n，排序 n 个伪随机数（n = 0 只测启动开销），
+   结果未排好序时退出码为 1 */
+int main(int argc, char **argv) {
+    int demo[N] = {38, 27, 43, 3, 9, 82, 10, 55, 17, 64, 3, 91, 26, 48, 72, 5,
+                   33, 60, 21, 14, 87, 42, 7, 69, 50, 12, 95, 30, 1, 77, 58, 24};
+    a = demo;
+    if (argc >= 2) {
+        n = atoi(argv[1]);
+        if (n <= 0) return 0;
+        a = malloc(n * sizeof(int));
+        unsigned seed = 1;
+        for (int i = 0; i < n; i++) {
+            seed = seed * 1103515245u + 12345u;
+            a[i] = (int)(seed >> 1);
+        }
+    }
+    buffer = malloc(n * sizeof(int));
+    for (int i = 0; i < n; i++)
+        TRACE("INSERT %d\n", a[i]);
+    TRACE("PAR_INIT %d %d\n", WORKERS, n);
+
+    int depth = 0;                  /* log2(WORKERS) 层派生恰好得到 WORKERS 个线程 */
+    while ((1 << depth) < WORKERS)
+        depth++;
+    mergeSort(0, n, depth, 0);
+    TRACE("SORT_FINISHED\n");
+
+    int unsorted = 0;
+    for (int i = 0; i < n; i++) {
+        TRACE("%d ", a[i]);
+        if (i > 0 && a[i - 1] > a[i]) unsorted = 1;
+    }
+    TRACE("\n");
+    free(buffer);
+    if (a != demo) free(a);
+    return unsorted;
+}
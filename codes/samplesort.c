@@ -0,0 +1,166 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdarg.h>
+#include <pthread.h>
+
+#define N 32                        /* 演示数组的长度；规模测试时由 argv[1] 指定 n */
+#define WORKERS 4                   /* 工作者个数，同时也是块数与桶数 */
+#define OVERSAMPLE 3                /* 每个桶抽取的样本数 */
+#define GRAIN 32                    /* 不超过该长度的桶直接插入排序，更大的桶用 qsort */
+
+int n = N;
+int *a;
+int *buffer;
+int splitters[WORKERS - 1];
+int counts[WORKERS][WORKERS];       /* [块][桶] 计数 */
+int offsets[WORKERS][WORKERS];      /* [块][桶] 散射起点 */
+int bucketStart[WORKERS + 1];
+pthread_mutex_t lock = PTHREAD_MUTEX_INITIALIZER;
+
+/* 多个线程同时输出时加锁，保证每条事件完整占一行；基准版本与 TRACE 一样不输出，也不加锁 */
+void event(const char *format, ...) {
+#ifdef VISUAL_BENCH
+    (void)format;
+#else
+    va_list args;
+    va_start(args, format);
+    pthread_mutex_lock(&lock);
+    vprintf(format, args);
+    fflush(stdout);
+    pthread_mutex_unlock(&lock);
+    va_end(args);
+#endif
+}
+
+void insertionSort(int *v, int length) {
+    for (int i = 1; i < length; i++) {
+        int x = v[i], j = i - 1;
+        while (j >= 0 && v[j] > x) {
+            v[j + 1] = v[j];
+            j--;
+        }
+        v[j + 1] = x;
+    }
+}
+
+int compareInts(const void *x, const void *y) {
+    int u = *(const int *)x, v = *(const int *)y;
+    return (u > v) - (u < v);
+}
+
+/* 元素所属的桶：大于前 b 个分隔值 */
+int bucketOf(int value) {
+    int b = 0;
+    while (b < WORKERS - 1 && value >= splitters[b])
+        b++;
+    return b;
+}
+
+int blockLo(int w) { return w * n / WORKERS; }
+int blockHi(int w) { return (w + 1) * n / WORKERS; }
+
+/* 第一阶段：统计本块落入各桶的元素数 */
+void *classify(void *arg) {
+    int w = *(int *)arg;
+    event("PAR_TASK %d %d %d\n", w, blockLo(w), blockHi(w));
+    for (int i = blockLo(w); i < blockHi(w); i++)
+        counts[w][bucketOf(a[i])]++;
+    event("PAR_IDLE %d\n", w);
+    return NULL;
+}
+
+/* 第二阶段：按前缀和把本块元素散射到缓冲区 */
+void *scatter(void *arg) {
+    int w = *(int *)arg;
+    event("PAR_TASK %d %d %d\n", w, blockLo(w), blockHi(w));
+    for (int i = blockLo(w); i < blockHi(w); i++)
+        buffer[offsets[w][bucketOf(a[i])]++] = a[i];
+    event("PAR_IDLE %d\n", w);
+    return NULL;
+}
+
+/* 第三阶段：排序一个桶并写回原数组 */
+void *sortBucket(void *arg) {
+    int w = *(int *)arg;
+    int lo = bucketStart[w], hi = bucketStart[w + 1];
+    event("PAR_TASK %d %d %d\n", w, lo, hi);
+    if (hi - lo <= GRAIN)
+        insertionSort(buffer + lo, hi - lo);
+    else
+        qsort(buffer + lo, hi - lo, sizeof(int), compareInts);
+    for (int i = lo; i < hi; i++) {
+        a[i] = buffer[i];
+        event("PAR_WRITE %d %d %d\n", i, a[i], w);
+    }
+    event("PAR_IDLE %d\n", w);
+    return NULL;
+}
+
+/* 每个阶段为每个工作者启动一个线程，全部结束后才进入下一阶段 */
+void runPhase(void *(*phase)(void *)) {
+    pthread_t threads[WORKERS];
+    int ids[WORKERS];
+    for (int w = 0; w < WORKERS; w++) {
+        ids[w] = w;
+        pthread_create(&threads[w], NULL, phase, &ids[w]);
+    }
+    for (int w = 0; w < WORKERS; w++)
+        pthread_join(threads[w], NULL);
+}
+
+/* 不带参数时排序演示数组；规模测试以 argv[1] 传入 n，排序 n 个伪随机数（n = 0 只测启动开销），
+   结果未排好序时退出码为 1 */
+int main(int argc, char **argv) {
+    int demo[N] = {38, 27, 43, 3, 9, 82, 10, 55, 17, 64, 3, 91, 26, 48, 72, 5,
+                   33, 60, 21, 14, 87, 42, 7, 69, 50, 12, 95, 30, 1, 77, 58, 24};
+    a = demo;
+    if (argc >= 2) {
+        n = atoi(argv[1]);
+        if (n <= 0) return 0;
+        a = malloc(n * sizeof(int));
+        unsigned seed = 1;
+        for (int i = 0; i < n; i++) {
+            seed = seed * 1103515245u + 12345u;
+            a[i] = (int)(seed >> 1);
+        }
+    }
+    buffer = malloc(n * sizeof(int));
+    for (int i = 0; i < n; i++)
+        TRACE("INSERT %d\n", a[i]);
+    TRACE("PAR_INIT %d %d\n", WORKERS, n);
+
+    /* 等距抽样并排序，每 OVERSAMPLE 个样本取一个分隔值 */
+    int sample[WORKERS * OVERSAMPLE];
+    for (int s = 0; s < WORKERS * OVERSAMPLE; s++)
+        sample[s] = a[s * n / (WORKERS * OVERSAMPLE)];
+    insertionSort(sample, WORKERS * OVERSAMPLE);
+    for (int b = 1; b < WORKERS; b++)
+        splitters[b - 1] = sample[b * OVERSAMPLE];
+
+    runPhase(classify);
+
+    /* 前缀和：桶优先、块其次，同一桶内保持块的先后顺序 */
+    int offset = 0;
+    for (int b = 0; b < WORKERS; b++) {
+        bucketStart[b] = offset;
+        for (int w = 0; w < WORKERS; w++) {
+            offsets[w][b] = offset;
+            offset += counts[w][b];
+        }
+    }
+    bucketStart[WORKERS] = offset;
+
+    runPhase(scatter);
+    runPhase(sortBucket);
+    TRACE("SORT_FINISHED\n");
+
+    int unsorted = 0;
+    for (int i = 0; i < n; i++) {
+        TRACE("%d ", a[i]);
+        if (i > 0 && a[i - 1] > a[i]) unsorted = 1;
+    }
+    TRACE("\n");
+    free(buffer);
+    if (a != demo) free(a);
+    return unsorted;
+}
@@ -0,0 +1,191 @@
+#include "counterpanel.h"
+#include <QFile>
+#include <QFileDialog>
+#include <QMessageBox>
+#include <QTextStream>
+#include <QDateTime>
+
+static const int kSampleIntervalMs = 100;   // 采样周期
+static const int kMaxSamples = 2048;        // 单次运行保留的最大采样数，超过后隔点抽稀
+
+CounterChart::CounterChart(QWidget* parent)
+    : QWidget(parent), m_run(nullptr) {
+    setMinimumHeight(60);
+}
+
+void CounterChart::setRun(const CounterRun* run) {
+    m_run = run;
+    update();
+}
+
+void CounterChart::paintEvent(QPaintEvent* event) {
+    Q_UNUSED(event);
+    QPainter painter(this);
+    painter.setRenderHint(QPainter::Antialiasing);
+
+    const QRectF area = QRectF(rect()).adjusted(8, 8, -8, -8);
+    painter.setPen(QPen(QColor("#555555"), 1));
+    painter.drawLine(area.bottomLeft(), area.bottomRight());
+    painter.drawLine(area.bottomLeft(), area.topLeft());
+
+    if (!m_run || m_run->samples.size() < 2) return;
+    const QVector<CounterSample>& samples = m_run->samples;
+
+    // 所有计数共用纵轴，按本次运行的最大值归一化；横轴为运行时间
+    quint64 maxCount = 1;
+    for (int k = 0; k < OpCounter::KindCount; ++k)
+        maxCount = qMax(maxCount, samples.last().counts[k]);
+    const qreal maxTime = qMax<qint64>(1, samples.last().elapsedMs);
+
+    QVector<QPointF> points(samples.size());
+    for (int k = 0; k < OpCounter::KindCount; ++k) {
+        if (samples.last().counts[k] == 0) continue;
+        for (int i = 0; i < samples.size(); ++i) {
+            points[i] = QPointF(area.left() + area.width() * samples[i].elapsedMs / maxTime,
+                                area.bottom() - area.height() * samples[i].counts[k] / maxCount);
+        }
+        painter.setPen(QPen(CounterPanel::kindColor(static_cast<OpCounter::Kind>(k)), 2));
+        painter.drawPolyline(points.constData(), points.size());
+    }
+
+    painter.setPen(QColor("#ABB2BF"));
+    painter.setFont(QFont("Segoe UI", 8));
+    painter.drawText(area.adjusted(4, 0, 0, 0), Qt::AlignLeft | Qt::AlignTop, QString::number(maxCount));
+    painter.drawText(area, Qt::AlignRight | Qt::AlignBottom, QString("%1 ms").arg(samples.last().elapsedMs));
+}
+
+CounterPanel::CounterPanel(QWidget* parent)
+    : QWidget(parent), m_running(false) {
+    setStyleSheet("background-color:#333333; color:#ABB2BF; border-radius:10px;");
+    setMinimumWidth(220);
+
+    QVBoxLayout* layout = new QVBoxLayout(this);
+    layout->setContentsMargins(10, 8, 10, 8);
+    layout->setSpacing(6);
+
+    m_titleLabel = new QLabel("操作计数");
+    m_titleLabel->setStyleSheet("font-weight:bold;");
+    layout->addWidget(m_titleLabel);
+
+    QGridLayout* grid = new QGridLayout;
+    grid->setHorizontalSpacing(12);
+    grid->setVerticalSpacing(2);
+    for (int k = 0; k < OpCounter::KindCount; ++k) {
+        OpCounter::Kind kind = static_cast<OpCounter::Kind>(k);
+        QLabel* name = new QLabel(OpCounter::name(kind));
+        name->setStyleSheet(QString("color:%1;").arg(kindColor(kind).name()));
+        m_valueLabels[k] = new QLabel("0");
+        m_valueLabels[k]->setAlignment(Qt::AlignRight | Qt::AlignVCenter);
+        grid->addWidget(name, k / 2, (k % 2) * 2);
+        grid->addWidget(m_valueLabels[k], k / 2, (k % 2) * 2 + 1);
+    }
+    layout->addLayout(grid);
+
+    m_chart = new CounterChart;
+    layout->addWidget(m_chart, 1);
+
+    m_exportButton = new QToolButton;
+    m_exportButton->setText("导出 CSV");
+    m_exportButton->setToolTip("导出本次会话中每次运行的计数曲线");
+    m_exportButton->setStyleSheet(
+        "QToolButton { background-color: transparent; border: none; padding: 3px; color:#ABB2BF; font-weight:bold; }"
+        "QToolButton:hover { background-color: rgba(255, 255, 255, 30); }");
+    m_exportButton->setEnabled(false);
+    layout->addWidget(m_exportButton, 0, Qt::AlignRight);
+
+    m_sampleTimer.setInterval(kSampleIntervalMs);
+    connect(&m_sampleTimer, &QTimer::timeout, this, &CounterPanel::sample);
+    connect(m_exportButton, &QToolButton::clicked, this, &CounterPanel::onExportClicked);
+}
+
+QColor CounterPanel::kindColor(OpCounter::Kind kind) {
+    switch (kind) {
+    case OpCounter::Comparisons: return QColor("#E5C07B");
+    case OpCounter::Swaps:       return QColor("#E06C75");
+    case OpCounter::Rotations:   return QColor("#C678DD");
+    case OpCounter::Splits:      return QColor("#61AFEF");
+    case OpCounter::Merges:      return QColor("#56B6C2");
+    case OpCounter::Borrows:     return QColor("#D19A66");
+    case OpCounter::Relaxations: return QColor("#98C379");
+    default:                     return QColor("#ABB2BF");
+    }
+}
+
+void CounterPanel::beginRun(const QString& title) {
+    if (m_running) endRun();
+
+    OpCounter::reset();
+    m_runs.append(CounterRun{title, QVector<CounterSample>()});
+    m_titleLabel->setText("操作计数 - " + title);
+    m_chart->setRun(&m_runs.last());
+    m_running = true;
+    m_clock.start();
+    sample();
+    m_sampleTimer.start();
+}
+
+void CounterPanel::endRun() {
+    if (!m_running) return;
+    sample();
+    m_sampleTimer.stop();
+    m_running = false;
+    m_exportButton->setEnabled(true);
+}
+
+void CounterPanel::sample() {
+    if (m_runs.isEmpty()) return;
+    CounterRun& run = m_runs.last();
+
+    CounterSample current;
+    current.elapsedMs = m_clock.elapsed();
+    bool changed = run.samples.isEmpty();
+    for (int k = 0; k < OpCounter::KindCount; ++k) {
+        current.counts[k] = OpCounter::value(static_cast<OpCounter::Kind>(k));
+        if (!changed && current.counts[k] != run.samples.last().counts[k])
+            changed = true;
+        m_valueLabels[k]->setText(QString::number(current.counts[k]));
+    }
+    if (!changed) return;
+
+    // 长时间运行时隔点抽稀，保持首尾采样
+    if (run.samples.size() >= kMaxSamples) {
+        QVector<CounterSample> thinned;
+        thinned.reserve(kMaxSamples / 2 + 1);
+        for (int i = 0; i < run.samples.size(); i += 2)
+            thinned.append(run.samples[i]);
+        run.samples = thinned;
+    }
+    run.samples.append(current);
+    m_chart->update();
+}
+
+bool CounterPanel::exportCsv(const QString& path) const {
+    QFile file(path);
+    if (!file.open(QIODevice::WriteOnly | QIODevice::Text))
+        return false;
+
+    QTextStream out(&file);
+    out << "run,algorithm,elapsed_ms";
+    for (int k = 0; k < OpCounter::KindCount; ++k)
+        out << "," << OpCounter::key(static_cast<OpCounter::Kind>(k));
+    out << "\n";
+
+    for (int r = 0; r < m_runs.size(); ++r) {
+        for (const CounterSample& s : m_runs[r].samples) {
+            out << r + 1 << "," << m_runs[r].title << "," << s.elapsedMs;
+            for (int k = 0; k < OpCounter::KindCount; ++k)
+                out << "," << s.counts[k];
+            out << "\n";
+        }
+    }
+    out.flush();
+    return out.status() == QTextStream::Ok && file.error() == QFileDevice::NoError;   // 磁盘写满等写入失败
+}
+
+void CounterPanel::onExportClicked() {
+    QString defaultName = QString("counters_%1.csv").arg(QDateTime::currentDateTime().toString("yyyyMMdd_HHmmss"));
+    QString path = QFileDialog::getSaveFileName(this, "导出计数", defaultName, "CSV 文件 (*.csv)");
+    if (path.isEmpty()) return;
+    if (!exportCsv(path))
+        QMessageBox::warning(this, "错误", "无法导出文件：" + path);
+}
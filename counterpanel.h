@@ -0,0 +1,72 @@
+#ifndef COUNTERPANEL_H
+#define COUNTERPANEL_H
+
+#include "opcounter.h"
+#include <QWidget>
+#include <QLabel>
+#include <QToolButton>
+#include <QGridLayout>
+#include <QVBoxLayout>
+#include <QPainter>
+#include <QPaintEvent>
+#include <QElapsedTimer>
+#include <QTimer>
+#include <QVector>
+#include <QColor>
+
+// 某一时刻的累计计数快照
+struct CounterSample {
+    qint64 elapsedMs;
+    quint64 counts[OpCounter::KindCount];
+};
+
+// 一次运行的完整记录，用于导出
+struct CounterRun {
+    QString title;
+    QVector<CounterSample> samples;
+};
+
+// 累计计数曲线，自绘
+class CounterChart : public QWidget {
+    Q_OBJECT
+
+public:
+    explicit CounterChart(QWidget* parent = nullptr);
+    void setRun(const CounterRun* run);
+
+protected:
+    void paintEvent(QPaintEvent* event) override;
+
+private:
+    const CounterRun* m_run;
+};
+
+// 日志区旁的计数面板：实时显示各项计数与累计曲线，并按运行导出 CSV
+class CounterPanel : public QWidget {
+    Q_OBJECT
+
+public:
+    explicit CounterPanel(QWidget* parent = nullptr);
+
+    void beginRun(const QString& title);   // 清零计数并开始采样
+    void endRun();                         // 记录最终计数，停止采样
+    bool exportCsv(const QString& path) const;
+
+    static QColor kindColor(OpCounter::Kind kind);
+
+private:
+    void sample();
+    void onExportClicked();
+
+    QLabel* m_titleLabel;
+    QLabel* m_valueLabels[OpCounter::KindCount];
+    CounterChart* m_chart;
+    QToolButton* m_exportButton;
+
+    QVector<CounterRun> m_runs;
+    bool m_running;
+    QElapsedTimer m_clock;
+    QTimer m_sampleTimer;
+};
+
+#endif // COUNTERPANEL_H
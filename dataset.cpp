@@ -0,0 +1,155 @@
+#include "dataset.h"
+#include <QFile>
+#include <QFileInfo>
+#include <QtEndian>
+#include <algorithm>
+#include <climits>
+#include <functional>
+#include <random>
+
+static const int kFewUniqueCount = 8;      // 少量重复分布的不同取值个数
+static const int kZipfMaxRank = 100000;    // Zipf 分布的最大秩，限制累积分布表大小
+
+const int Dataset::MinSize;
+const int Dataset::MaxSize;
+
+QString Dataset::distributionName(Distribution distribution) {
+    switch (distribution) {
+    case Random:    return "随机";
+    case Sorted:    return "有序";
+    case Reversed:  return "逆序";
+    case FewUnique: return "少量重复";
+    case OrganPipe: return "风琴管";
+    case Zipfian:   return "Zipf";
+    }
+    return QString();
+}
+
+QVector<int> Dataset::generate(Distribution distribution, int n, quint32 seed) {
+    n = qBound(0, n, MaxSize);
+    QVector<int> values(n);
+    const int maxValue = qMax(99, n);
+    std::mt19937 rng(seed);
+
+    switch (distribution) {
+    case Random:
+    case Sorted:
+    case Reversed:
+    case OrganPipe: {
+        std::uniform_int_distribution<int> dist(1, maxValue);
+        for (int& v : values)
+            v = dist(rng);
+        if (distribution == Sorted)
+            std::sort(values.begin(), values.end());
+        else if (distribution == Reversed)
+            std::sort(values.begin(), values.end(), std::greater<int>());
+        else if (distribution == OrganPipe) {
+            // 有序序列交替放到左右两端，得到先升后降的形状
+            QVector<int> sorted = values;
+            std::sort(sorted.begin(), sorted.end());
+            for (int k = 0; k < n; ++k)
+                values[(k % 2 == 0) ? k / 2 : n - 1 - k / 2] = sorted[k];
+        }
+        break;
+    }
+    case FewUnique: {
+        std::uniform_int_distribution<int> dist(1, maxValue);
+        int pool[kFewUniqueCount];
+        for (int& p : pool)
+            p = dist(rng);
+        std::uniform_int_distribution<int> pick(0, kFewUniqueCount - 1);
+        for (int& v : values)
+            v = pool[pick(rng)];
+        break;
+    }
+    case Zipfian: {
+        // 秩 k 的概率与 1/k 成正比，按累积分布表逆变换采样
+        const int ranks = qMin(maxValue, kZipfMaxRank);
+        QVector<double> cdf(ranks);
+        double sum = 0;
+        for (int k = 0; k < ranks; ++k) {
+            sum += 1.0 / (k + 1);
+            cdf[k] = sum;
+        }
+        std::uniform_real_distribution<double> dist(0, sum);
+        for (int& v : values)
+            v = static_cast<int>(std::lower_bound(cdf.begin(), cdf.end(), dist(rng)) - cdf.begin()) + 1;
+        break;
+    }
+    }
+    return values;
+}
+
+bool Dataset::load(const QString& path, QVector<int>* values, QString* error) {
+    values->clear();
+
+    QFile file(path);
+    if (!file.open(QIODevice::ReadOnly)) {
+        *error = "无法打开文件：" + path;
+        return false;
+    }
+
+    const qint64 size = file.size();
+    if (size == 0) {
+        *error = "文件为空：" + path;
+        return false;
+    }
+
+    const QString suffix = QFileInfo(path).suffix().toLower();
+    const bool binary = suffix == "bin" || suffix == "i32" || suffix == "dat";
+    if (binary && size % 4 != 0) {
+        *error = "二进制文件长度不是 4 的倍数：" + path;
+        return false;
+    }
+
+    // 优先内存映射，映射失败（如特殊文件系统）时退回一次性读取
+    QByteArray buffer;
+    const uchar* data = file.map(0, size);
+    if (!data) {
+        buffer = file.readAll();
+        data = reinterpret_cast<const uchar*>(buffer.constData());
+    }
+
+    if (binary)
+        parseBinary(data, size, values);
+    else
+        parseText(reinterpret_cast<const char*>(data), size, values);
+
+    if (values->isEmpty()) {
+        *error = "文件中没有可解析的整数：" + path;
+        return false;
+    }
+    return true;
+}
+
+void Dataset::parseText(const char* data, qint64 size, QVector<int>* values) {
+    values->reserve(static_cast<int>(qMin<qint64>(size / 2 + 1, MaxSize)));
+
+    qint64 i = 0;
+    while (i < size && values->size() < MaxSize) {
+        // 跳过分隔符，识别可选负号
+        while (i < size && !(data[i] >= '0' && data[i] <= '9') && data[i] != '-')
+            ++i;
+        bool negative = false;
+        if (i < size && data[i] == '-') {
+            negative = true;
+            ++i;
+        }
+        if (i >= size || !(data[i] >= '0' && data[i] <= '9'))
+            continue;
+
+        qint64 v = 0;
+        while (i < size && data[i] >= '0' && data[i] <= '9') {
+            v = qMin<qint64>(v * 10 + (data[i] - '0'), INT_MAX);
+            ++i;
+        }
+        values->append(static_cast<int>(negative ? -v : v));
+    }
+}
+
+void Dataset::parseBinary(const uchar* data, qint64 size, QVector<int>* values) {
+    const int count = static_cast<int>(qMin<qint64>(size / 4, MaxSize));
+    values->resize(count);
+    for (int i = 0; i < count; ++i)
+        (*values)[i] = qFromLittleEndian<qint32>(data + i * 4);
+}
@@ -0,0 +1,34 @@
+#ifndef DATASET_H
+#define DATASET_H
+
+#include <QString>
+#include <QVector>
+
+// 排序与查找的输入数据集：按分布生成（mt19937 固定种子可复现），或从 CSV / int32 二进制文件载入
+class Dataset {
+public:
+    enum Distribution {
+        Random,      // 均匀随机
+        Sorted,      // 升序
+        Reversed,    // 降序
+        FewUnique,   // 少量不同取值，大量重复
+        OrganPipe,   // 先升后降
+        Zipfian      // Zipf 分布（s = 1），少数取值频繁出现
+    };
+
+    static const int MinSize = 10;
+    static const int MaxSize = 10000000;
+
+    static QString distributionName(Distribution distribution);
+    static QVector<int> generate(Distribution distribution, int n, quint32 seed);
+
+    // 载入文件：.bin/.i32/.dat 按小端 int32 解析，其余按文本解析（逗号、空白或换行分隔）
+    // 文件通过 QFile::map 内存映射读取，超过 MaxSize 的部分被截断
+    static bool load(const QString& path, QVector<int>* values, QString* error);
+
+private:
+    static void parseText(const char* data, qint64 size, QVector<int>* values);
+    static void parseBinary(const uchar* data, qint64 size, QVector<int>* values);
+};
+
+#endif // DATASET_H
@@ -0,0 +1,168 @@
+#include "distancematrixitem.h"
+
+static const int kFadeDurationMs = 1200;   // 高亮淡出时长
+static const int kGlyphCacheLimit = 4096;  // 排版缓存上限，超出后整体清空
+
+DistanceMatrixItem::DistanceMatrixItem(int size, int infinity, QGraphicsItem* parent)
+    : QGraphicsObject(parent), m_size(size), m_infinity(infinity),
+      m_values(size * size, infinity), m_highlight(size * size, 0.0f),
+      m_infGlyph("∞"), m_font("Segoe UI", 10, QFont::Bold) {
+    // 顶点较多时缩小单元格，保证整体尺寸可控
+    m_cellSize = size <= 12 ? 50 : qMax<qreal>(24, 600.0 / size);
+
+    for (int i = 0; i < size; ++i)
+        m_values[i * size + i] = 0;
+
+    m_infGlyph.prepare(QTransform(), m_font);
+    for (int i = 0; i < size; ++i) {
+        QStaticText header(QString("V%1").arg(i));
+        header.prepare(QTransform(), m_font);
+        m_headers.append(header);
+    }
+
+    // 需要 exposedRect 只绘制可见单元格
+    setFlag(QGraphicsItem::ItemUsesExtendedStyleOption, true);
+
+    m_fadeTimer.setInterval(30);
+    connect(&m_fadeTimer, &QTimer::timeout, this, &DistanceMatrixItem::onFadeTick);
+}
+
+void DistanceMatrixItem::setMatrix(const QVector<QVector<int>>& matrix) {
+    for (int i = 0; i < m_size && i < matrix.size(); ++i)
+        for (int j = 0; j < m_size && j < matrix[i].size(); ++j)
+            m_values[i * m_size + j] = matrix[i][j];
+    update();
+}
+
+void DistanceMatrixItem::setValue(int row, int col, int value) {
+    if (row < 0 || col < 0 || row >= m_size || col >= m_size) return;
+
+    int idx = row * m_size + col;
+    m_values[idx] = value;
+    if (m_highlight[idx] <= 0.0f)
+        m_fading.append(idx);
+    m_highlight[idx] = 1.0f;
+    update(cellRect(row, col));
+
+    if (!m_fadeTimer.isActive()) {
+        m_fadeClock.start();
+        m_fadeTimer.start();
+    }
+}
+
+int DistanceMatrixItem::value(int row, int col) const {
+    return m_values[row * m_size + col];
+}
+
+qreal DistanceMatrixItem::cellSize() const {
+    return m_cellSize;
+}
+
+QRectF DistanceMatrixItem::cellRect(int row, int col) const {
+    return QRectF(col * m_cellSize, row * m_cellSize, m_cellSize, m_cellSize);
+}
+
+QRectF DistanceMatrixItem::boundingRect() const {
+    // 左侧与上方各留一格绘制编号
+    return QRectF(-m_cellSize, -m_cellSize, (m_size + 1) * m_cellSize, (m_size + 1) * m_cellSize);
+}
+
+void DistanceMatrixItem::onFadeTick() {
+    float step = static_cast<float>(m_fadeClock.restart()) / kFadeDurationMs;
+
+    for (int k = m_fading.size() - 1; k >= 0; --k) {
+        int idx = m_fading[k];
+        m_highlight[idx] = qMax(0.0f, m_highlight[idx] - step);
+        update(cellRect(idx / m_size, idx % m_size));
+        if (m_highlight[idx] <= 0.0f) {
+            m_fading[k] = m_fading.last();
+            m_fading.removeLast();
+        }
+    }
+
+    if (m_fading.isEmpty())
+        m_fadeTimer.stop();
+}
+
+const QStaticText& DistanceMatrixItem::glyph(int value) {
+    if (value == m_infinity) return m_infGlyph;
+
+    auto it = m_glyphCache.find(value);
+    if (it != m_glyphCache.end()) return it.value();
+
+    if (m_glyphCache.size() >= kGlyphCacheLimit)
+        m_glyphCache.clear();
+
+    QStaticText text(QString::number(value));
+    text.prepare(QTransform(), m_font);
+    return m_glyphCache.insert(value, text).value();
+}
+
+void DistanceMatrixItem::paint(QPainter* painter, const QStyleOptionGraphicsItem* option, QWidget* widget) {
+    Q_UNUSED(widget);
+
+    const QRectF matrixRect(0, 0, m_size * m_cellSize, m_size * m_cellSize);
+    const QRectF exposed = option->exposedRect;
+
+    // 只遍历与暴露区域相交的行列
+    int firstCol = qMax(0, static_cast<int>(exposed.left() / m_cellSize));
+    int lastCol = qMin(m_size - 1, static_cast<int>(exposed.right() / m_cellSize));
+    int firstRow = qMax(0, static_cast<int>(exposed.top() / m_cellSize));
+    int lastRow = qMin(m_size - 1, static_cast<int>(exposed.bottom() / m_cellSize));
+
+    painter->setPen(QPen(Qt::black));
+    painter->setBrush(QColor("#282C34"));
+    painter->drawRect(matrixRect.intersected(exposed.adjusted(-1, -1, 1, 1)));
+
+    // 缩放过小时文字不可读，只绘制背景与高亮
+    const qreal lod = QStyleOptionGraphicsItem::levelOfDetailFromTransform(painter->worldTransform());
+    const bool drawText = lod * m_cellSize >= 14;
+
+    const QColor highlightColor("#E06C75");
+    painter->setFont(m_font);
+
+    for (int row = firstRow; row <= lastRow; ++row) {
+        for (int col = firstCol; col <= lastCol; ++col) {
+            int idx = row * m_size + col;
+            float h = m_highlight[idx];
+            QRectF rect = cellRect(row, col);
+
+            if (h > 0.0f) {
+                QColor tint = highlightColor;
+                tint.setAlphaF(0.25 * h);
+                painter->fillRect(rect, tint);
+            }
+            if (!drawText) continue;
+
+            // 文字颜色从高亮色渐变回白色
+            QColor color(qRound(255 + (highlightColor.red() - 255) * h),
+                         qRound(255 + (highlightColor.green() - 255) * h),
+                         qRound(255 + (highlightColor.blue() - 255) * h));
+            painter->setPen(color);
+
+            const QStaticText& text = glyph(m_values[idx]);
+            QSizeF size = text.size();
+            painter->drawStaticText(QPointF(rect.center().x() - size.width() / 2,
+                                            rect.center().y() - size.height() / 2), text);
+        }
+    }
+
+    if (!drawText) return;
+
+    // 行列编号
+    painter->setPen(QColor("#61AFEF"));
+    for (int i = firstCol; i <= lastCol; ++i) {
+        QSizeF size = m_headers[i].size();
+        QRectF rect = cellRect(-1, i);
+        if (rect.intersects(exposed))
+            painter->drawStaticText(QPointF(rect.center().x() - size.width() / 2,
+                                            rect.center().y() - size.height() / 2), m_headers[i]);
+    }
+    for (int i = firstRow; i <= lastRow; ++i) {
+        QSizeF size = m_headers[i].size();
+        QRectF rect = cellRect(i, -1);
+        if (rect.intersects(exposed))
+            painter->drawStaticText(QPointF(rect.center().x() - size.width() / 2,
+                                            rect.center().y() - size.height() / 2), m_headers[i]);
+    }
+}
@@ -0,0 +1,50 @@
+#ifndef DISTANCEMATRIXITEM_H
+#define DISTANCEMATRIXITEM_H
+
+#include <QGraphicsObject>
+#include <QStyleOptionGraphicsItem>
+#include <QPainter>
+#include <QStaticText>
+#include <QTimer>
+#include <QElapsedTimer>
+#include <QVector>
+#include <QHash>
+#include <QFont>
+
+// Floyd 距离矩阵：单个图元从 int 缓冲区直接绘制全部单元格
+// 数值更新只刷新对应单元格的矩形区域，高亮淡出由平铺数组记录，不再为每个单元创建动画
+class DistanceMatrixItem : public QGraphicsObject {
+    Q_OBJECT
+
+public:
+    DistanceMatrixItem(int size, int infinity, QGraphicsItem* parent = nullptr);
+
+    void setMatrix(const QVector<QVector<int>>& matrix); // 整体载入（不高亮）
+    void setValue(int row, int col, int value);          // 更新单元格并触发高亮淡出
+    int value(int row, int col) const;
+    qreal cellSize() const;
+
+    QRectF boundingRect() const override;
+    void paint(QPainter* painter, const QStyleOptionGraphicsItem* option, QWidget* widget = nullptr) override;
+
+private:
+    void onFadeTick();
+    QRectF cellRect(int row, int col) const;
+    const QStaticText& glyph(int value);                  // 数值文本的排版缓存
+
+    int m_size;
+    int m_infinity;
+    qreal m_cellSize;
+    QVector<int> m_values;          // 距离，行优先平铺 size * size
+    QVector<float> m_highlight;     // 高亮强度 1 → 0
+    QVector<int> m_fading;          // 正在淡出的单元格下标
+    QVector<QStaticText> m_headers; // 行列编号 V0..Vn-1
+
+    QHash<int, QStaticText> m_glyphCache;
+    QStaticText m_infGlyph;
+    QFont m_font;
+    QTimer m_fadeTimer;
+    QElapsedTimer m_fadeClock;
+};
+
+#endif // DISTANCEMATRIXITEM_H
@@ -0,0 +1,232 @@
+#include "forcelayout.h"
+#include <QVarLengthArray>
+#include <QtMath>
+
+static const qreal kTheta = 0.8;           // Barnes–Hut 开角阈值
+static const qreal kCooling = 0.95;        // 每轮降温系数
+static const qreal kMinTemperature = 0.5;  // 低于该温度视为收敛
+static const qreal kGravity = 0.02;        // 指向中心的弱引力，防止不连通分量飘散
+static const int kFrameBudgetMs = 8;       // 每帧迭代时间片
+static const int kMaxDepth = 24;           // 四叉树最大深度，防止重合顶点无限细分
+
+ForceLayout::ForceLayout(QRectF bounds, QObject* parent)
+    : QObject(parent), m_bounds(bounds), m_k(1), m_temperature(0), m_initialTemperature(0) {
+    m_timer.setInterval(16);
+    connect(&m_timer, &QTimer::timeout, this, &ForceLayout::onTick);
+}
+
+void ForceLayout::reset(const QVector<QPointF>& initialPositions) {
+    m_timer.stop();
+    m_pos = initialPositions;
+    m_disp.fill(QPointF(0, 0), m_pos.size());
+    m_edges.clear();
+
+    int n = qMax(1, m_pos.size());
+    m_k = qSqrt(m_bounds.width() * m_bounds.height() / n);
+    m_initialTemperature = m_bounds.width() / 10;
+    m_temperature = m_initialTemperature;
+}
+
+void ForceLayout::addEdge(int src, int dest) {
+    if (src < 0 || dest < 0 || src >= m_pos.size() || dest >= m_pos.size() || src == dest) return;
+    m_edges.append(qMakePair(src, dest));
+
+    // 新边打破平衡，适当升温后继续迭代
+    m_temperature = qMax(m_temperature, m_initialTemperature * 0.3);
+    start();
+}
+
+void ForceLayout::removeEdge(int src, int dest) {
+    for (int i = 0; i < m_edges.size(); ++i) {
+        const auto& edge = m_edges[i];
+        if ((edge.first == src && edge.second == dest) || (edge.first == dest && edge.second == src)) {
+            m_edges[i] = m_edges.last();
+            m_edges.removeLast();
+            m_temperature = qMax(m_temperature, m_initialTemperature * 0.3);
+            start();
+            return;
+        }
+    }
+}
+
+void ForceLayout::start() {
+    if (!m_pos.isEmpty() && !m_timer.isActive())
+        m_timer.start();
+}
+
+void ForceLayout::stop() {
+    m_timer.stop();
+}
+
+bool ForceLayout::isRunning() const {
+    return m_timer.isActive();
+}
+
+const QVector<QPointF>& ForceLayout::positions() const {
+    return m_pos;
+}
+
+void ForceLayout::onTick() {
+    QElapsedTimer elapsed;
+    elapsed.start();
+    do {
+        step();
+    } while (elapsed.elapsed() < kFrameBudgetMs && m_temperature > kMinTemperature);
+
+    emit positionsUpdated();
+
+    if (m_temperature <= kMinTemperature)
+        m_timer.stop();
+}
+
+void ForceLayout::step() {
+    const int n = m_pos.size();
+    if (n == 0) return;
+
+    // 斥力：Barnes–Hut 近似
+    buildQuadTree();
+    for (int i = 0; i < n; ++i)
+        m_disp[i] = repulsion(i);
+
+    // 引力：沿边作用 d²/k
+    for (const auto& edge : m_edges) {
+        QPointF delta = m_pos[edge.first] - m_pos[edge.second];
+        qreal d = qMax<qreal>(0.01, qSqrt(QPointF::dotProduct(delta, delta)));
+        QPointF f = delta / d * (d * d / m_k);
+        m_disp[edge.first] -= f;
+        m_disp[edge.second] += f;
+    }
+
+    // 位移受温度限制，并限制在布局区域内
+    const QPointF center = m_bounds.center();
+    for (int i = 0; i < n; ++i) {
+        QPointF disp = m_disp[i] + (center - m_pos[i]) * kGravity;
+        qreal len = qSqrt(QPointF::dotProduct(disp, disp));
+        if (len > 0)
+            m_pos[i] += disp / len * qMin(len, m_temperature);
+        m_pos[i].setX(qBound(m_bounds.left(), m_pos[i].x(), m_bounds.right()));
+        m_pos[i].setY(qBound(m_bounds.top(), m_pos[i].y(), m_bounds.bottom()));
+    }
+
+    m_temperature = qMax(kMinTemperature, m_temperature * kCooling);
+}
+
+void ForceLayout::buildQuadTree() {
+    // 根单元取所有顶点的外接正方形
+    qreal minX = m_pos[0].x(), maxX = minX, minY = m_pos[0].y(), maxY = minY;
+    for (const QPointF& p : m_pos) {
+        minX = qMin(minX, p.x()); maxX = qMax(maxX, p.x());
+        minY = qMin(minY, p.y()); maxY = qMax(maxY, p.y());
+    }
+    qreal size = qMax(maxX - minX, maxY - minY) + 1;
+
+    m_cells.clear();
+    m_cells.reserve(m_pos.size() * 2);
+    m_cells.append(QuadCell{minX, minY, size, 0, 0, 0, -1, -1});
+
+    for (int i = 0; i < m_pos.size(); ++i)
+        insertBody(i);
+
+    for (QuadCell& cell : m_cells) {
+        if (cell.mass > 0) {
+            cell.massX /= cell.mass;
+            cell.massY /= cell.mass;
+        }
+    }
+}
+
+void ForceLayout::insertBody(int body) {
+    const QPointF p = m_pos[body];
+    int cell = 0;
+    int depth = 0;
+
+    while (true) {
+        m_cells[cell].massX += p.x();
+        m_cells[cell].massY += p.y();
+        m_cells[cell].mass++;
+
+        if (m_cells[cell].firstChild >= 0) {
+            cell = m_cells[cell].firstChild + childIndexFor(cell, p);
+            ++depth;
+            continue;
+        }
+        if (m_cells[cell].mass == 1) {
+            m_cells[cell].body = body;
+            return;
+        }
+        if (depth >= kMaxDepth) return; // 重合顶点只累计质量
+
+        // 叶子已有顶点：细分后把原顶点下放到子单元
+        int old = m_cells[cell].body;
+        subdivide(cell);
+        m_cells[cell].body = -1;
+        if (old >= 0) {
+            QuadCell& oldCell = m_cells[m_cells[cell].firstChild + childIndexFor(cell, m_pos[old])];
+            oldCell.massX = m_pos[old].x();
+            oldCell.massY = m_pos[old].y();
+            oldCell.mass = 1;
+            oldCell.body = old;
+        }
+        cell = m_cells[cell].firstChild + childIndexFor(cell, p);
+        ++depth;
+    }
+}
+
+void ForceLayout::subdivide(int cell) {
+    const qreal half = m_cells[cell].size / 2;
+    const qreal x = m_cells[cell].x;
+    const qreal y = m_cells[cell].y;
+    m_cells[cell].firstChild = m_cells.size();
+    m_cells.append(QuadCell{x, y, half, 0, 0, 0, -1, -1});
+    m_cells.append(QuadCell{x + half, y, half, 0, 0, 0, -1, -1});
+    m_cells.append(QuadCell{x, y + half, half, 0, 0, 0, -1, -1});
+    m_cells.append(QuadCell{x + half, y + half, half, 0, 0, 0, -1, -1});
+}
+
+int ForceLayout::childIndexFor(int cell, QPointF p) const {
+    const QuadCell& c = m_cells[cell];
+    const qreal half = c.size / 2;
+    int ix = p.x() >= c.x + half ? 1 : 0;
+    int iy = p.y() >= c.y + half ? 1 : 0;
+    return iy * 2 + ix;
+}
+
+QPointF ForceLayout::repulsion(int body) const {
+    const QPointF p = m_pos[body];
+    const qreal k2 = m_k * m_k;
+    QPointF force(0, 0);
+
+    QVarLengthArray<int, 128> stack;
+    stack.append(0);
+    while (!stack.isEmpty()) {
+        const QuadCell& c = m_cells[stack.last()];
+        stack.removeLast();
+        if (c.mass == 0) continue;
+
+        qreal dx = p.x() - c.massX;
+        qreal dy = p.y() - c.massY;
+        int mass = c.mass;
+
+        if (c.firstChild < 0) {
+            if (c.body == body) mass -= 1; // 排除自身，剩余的是重合顶点
+            if (mass == 0) continue;
+        } else if (c.size * c.size >= kTheta * kTheta * (dx * dx + dy * dy)) {
+            // 单元离得太近，展开子单元
+            for (int i = 0; i < 4; ++i)
+                stack.append(c.firstChild + i);
+            continue;
+        }
+
+        qreal d2 = dx * dx + dy * dy;
+        if (d2 < 1e-4) {
+            // 重合时按编号给出确定的微小扰动方向
+            qreal angle = body * 2.399963;
+            dx = qCos(angle) * 0.01;
+            dy = qSin(angle) * 0.01;
+            d2 = 1e-4;
+        }
+        // f = k²/d，方向为单位向量 (dx, dy)/d
+        force += QPointF(dx, dy) * (k2 * mass / d2);
+    }
+    return force;
+}
@@ -0,0 +1,61 @@
+#ifndef FORCELAYOUT_H
+#define FORCELAYOUT_H
+
+#include <QObject>
+#include <QTimer>
+#include <QElapsedTimer>
+#include <QRectF>
+#include <QPointF>
+#include <QVector>
+#include <QPair>
+
+// Fruchterman–Reingold 力导向布局，斥力部分使用 Barnes–Hut 四叉树近似（每轮 O(n log n)）
+// 布局按帧增量迭代：每次定时器触发只消耗一小段时间片，新边到来时重新“升温”
+class ForceLayout : public QObject {
+    Q_OBJECT
+
+public:
+    explicit ForceLayout(QRectF bounds, QObject* parent = nullptr);
+
+    void reset(const QVector<QPointF>& initialPositions); // 重新开始布局
+    void addEdge(int src, int dest);                       // 添加边并继续迭代
+    void removeEdge(int src, int dest);
+    void start();                                          // 启动（或继续）按帧迭代
+    void stop();
+    bool isRunning() const;
+
+    const QVector<QPointF>& positions() const;
+
+signals:
+    void positionsUpdated();                               // 每帧迭代后通知刷新图元
+
+private:
+    struct QuadCell {
+        qreal x, y, size;     // 单元左上角与边长
+        qreal massX, massY;   // 质心（累计坐标，构建完成后归一化）
+        int mass;             // 单元内顶点数
+        int body;             // 叶子中的顶点编号，-1 表示空
+        int firstChild;       // 四个子单元的起始下标，-1 表示叶子
+    };
+
+    void onTick();
+    void step();                                           // 执行一轮迭代
+    void buildQuadTree();
+    void insertBody(int body);
+    void subdivide(int cell);
+    int childIndexFor(int cell, QPointF p) const;
+    QPointF repulsion(int body) const;
+
+    QRectF m_bounds;
+    QVector<QPointF> m_pos;
+    QVector<QPointF> m_disp;
+    QVector<QPair<int, int>> m_edges;
+    QVector<QuadCell> m_cells;
+
+    QTimer m_timer;
+    qreal m_k;               // 理想边长
+    qreal m_temperature;     // 当前最大位移
+    qreal m_initialTemperature;
+};
+
+#endif // FORCELAYOUT_H
@@ -13,6 +13,15 @@ GraphicsView::GraphicsView(QWidget *parent)
 
     // 鼠标拖动画布功能
     setDragMode(QGraphicsView::NoDrag);
+
+    // 大场景绘制优化：各图元自行恢复画笔状态，按需局部刷新
+    setOptimizationFlags(QGraphicsView::DontSavePainterState | QGraphicsView::DontAdjustForAntialiasing);
+    setViewportUpdateMode(QGraphicsView::SmartViewportUpdate);
+}
+
+void GraphicsView::updateRenderQuality() {
+    // 缩小到细节阈值以下时图元只画色块，关闭抗锯齿减少开销
+    setRenderHint(QPainter::Antialiasing, transform().m11() >= Lod::DetailThreshold);
 }
 
 void GraphicsView::wheelEvent(QWheelEvent *event) {
@@ -28,6 +37,14 @@ void GraphicsView::wheelEvent(QWheelEvent *event) {
     }
 }
 
+void GraphicsView::drawBackground(QPainter *painter, const QRectF &rect) {
+    // 滚轮之外 fitInView、resetTransform 也会改变缩放，每帧绘制前重新判断；
+    // 视图的设置要到下一帧才生效，本帧直接改画笔（DontSavePainterState 下会沿用到各图元）
+    updateRenderQuality();
+    painter->setRenderHint(QPainter::Antialiasing, renderHints().testFlag(QPainter::Antialiasing));
+    QGraphicsView::drawBackground(painter, rect);
+}
+
 void GraphicsView::mousePressEvent(QMouseEvent *event) {
     if (event->button() == Qt::LeftButton) {
         isPanning = true;
@@ -4,6 +4,7 @@
 #include <QGraphicsView>
 #include <QWheelEvent>
 #include <QMouseEvent>
+#include "loditems.h"
 
 class GraphicsView : public QGraphicsView {
     Q_OBJECT
@@ -16,8 +17,11 @@ protected:
     void mousePressEvent(QMouseEvent *event) override;
     void mouseMoveEvent(QMouseEvent *event) override;
     void mouseReleaseEvent(QMouseEvent *event) override;
+    void drawBackground(QPainter *painter, const QRectF &rect) override;
 
 private:
+    void updateRenderQuality();   // 根据缩放切换抗锯齿
+
     bool isPanning = false;
     QPoint panStart;
 };
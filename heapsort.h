@@ -0,0 +1,200 @@
+#ifndef HEAPSORT_H
+#define HEAPSORT_H
+
+#include "sorttrace.h"
+#include <QString>
+#include <QVector>
+#include <algorithm>
+
+// d 叉堆排序：下标 i 的孩子为 d·i + 1 … d·i + d，父节点为 (i - 1) / d
+// 更宽的堆层数约为 log_d n，下沉时每层比较 d 次但访问的孩子在内存中连续（8 个 int 恰好半条缓存行）
+// 建堆可选逐个插入（自顶向下上浮，O(n log n)）或 Floyd 自底向上下沉（O(n)）；下沉可选标准方式或自底向上方式
+// 与 RadixSort 一样以模板接收记录器，计时时传入 NullRecorder；叉数作为模板参数，孩子循环可被完全展开
+namespace HeapSort {
+
+const int DefaultArity = 2;
+
+enum Build {
+    TopDown,        // 逐个插入：每个新元素上浮到位
+    Floyd           // 从最后一个内部节点起逐个下沉
+};
+
+enum Sift {
+    Standard,       // 每层先选出最大孩子，再与下沉元素比较
+    BottomUp        // 先沿最大孩子走到叶子（不与下沉元素比较），再自叶子回溯找到落点
+};
+
+struct Options {
+    int arity = DefaultArity;
+    Build build = Floyd;
+    Sift sift = Standard;
+};
+
+inline bool isSupportedArity(int arity) {
+    return arity == 2 || arity == 4 || arity == 8;
+}
+
+inline QString arityName(int arity) {
+    return arity == 2 ? QString("二叉堆") : QString("%1 叉堆").arg(arity);
+}
+
+inline QString buildName(Build build) {
+    switch (build) {
+    case TopDown: return "逐个插入建堆";
+    case Floyd:   return "Floyd 建堆";
+    }
+    return QString();
+}
+
+inline QString siftName(Sift sift) {
+    switch (sift) {
+    case Standard: return "标准下沉";
+    case BottomUp: return "自底向上下沉";
+    }
+    return QString();
+}
+
+// 轨迹生成接口只有一个整数参数，选项按位打包（与 IntroSort::encode 相同的做法）
+inline int encode(const Options& options) {
+    return options.arity | (options.build << 4) | (options.sift << 8);
+}
+
+inline Options decode(int parameter) {
+    Options options;
+    options.arity = isSupportedArity(parameter & 0xF) ? parameter & 0xF : DefaultArity;
+    options.build = static_cast<Build>(qBound(0, (parameter >> 4) & 0xF, static_cast<int>(Floyd)));
+    options.sift = static_cast<Sift>(qBound(0, (parameter >> 8) & 0xF, static_cast<int>(BottomUp)));
+    return options;
+}
+
+inline int parentOf(int index, int arity) {
+    return (index - 1) / arity;
+}
+
+// n 个元素的 d 叉完全堆的层数
+inline int levels(int n, int arity) {
+    int count = 0;
+    for (qint64 levelStart = 0, width = 1; levelStart < n; levelStart += width, width *= arity)
+        ++count;
+    return count;
+}
+
+template <int Arity, class Recorder>
+class Sorter {
+public:
+    Sorter(QVector<int>& a, const Options& options, Recorder& rec)
+        : m_a(a), m_options(options), m_rec(rec) {}
+
+    void run() {
+        const int n = m_a.size();
+        m_rec.record(TraceEvent::Heapify, m_options.build, n);
+        if (m_options.build == TopDown) {
+            for (int i = 1; i < n; ++i)
+                siftUp(i);
+        } else {
+            for (int i = (n - 2) / Arity; i >= 0 && n > 1; --i)
+                siftDown(i, n);
+        }
+
+        for (int last = n - 1; last > 0 && !m_rec.truncated(); --last) {
+            std::swap(m_a[0], m_a[last]);
+            m_rec.record(TraceEvent::ExtractMax, last);
+            siftDown(0, last);
+        }
+        m_rec.record(TraceEvent::SortFinished);
+    }
+
+private:
+    // 连续的 d 个孩子中的最大者，比较 d - 1 次；没有孩子时返回 -1
+    int largestChild(int index, int size) {
+        const int first = Arity * index + 1;
+        if (first >= size) return -1;
+        int largest = first;
+        const int end = std::min(first + Arity, size);
+        for (int child = first + 1; child < end; ++child) {
+            m_rec.record(TraceEvent::Compare, largest, child);
+            if (m_a[child] > m_a[largest]) largest = child;
+        }
+        return largest;
+    }
+
+    void siftUp(int index) {
+        m_rec.record(TraceEvent::SiftUp, index);
+        while (index > 0) {
+            const int parent = (index - 1) / Arity;
+            m_rec.record(TraceEvent::Compare, parent, index);
+            if (m_a[index] <= m_a[parent]) return;
+            std::swap(m_a[parent], m_a[index]);
+            m_rec.record(TraceEvent::Swap, parent, index);
+            index = parent;
+        }
+    }
+
+    void siftDown(int root, int size) {
+        m_rec.record(TraceEvent::SiftDown, root, size);
+        if (m_options.sift == BottomUp)
+            siftDownBottomUp(root, size);
+        else
+            siftDownStandard(root, size);
+    }
+
+    void siftDownStandard(int root, int size) {
+        while (true) {
+            const int largest = largestChild(root, size);
+            if (largest < 0) return;
+            m_rec.record(TraceEvent::Compare, root, largest);
+            if (m_a[largest] <= m_a[root]) return;
+
+            std::swap(m_a[root], m_a[largest]);
+            m_rec.record(TraceEvent::Swap, root, largest);
+            root = largest;
+        }
+    }
+
+    // 排序阶段换到堆顶的是原来的叶子，几乎总要沉到底层；
+    // 先不比较下沉元素、直接走到叶子，再向上回溯少量几步，每层省去一次比较
+    void siftDownBottomUp(int root, int size) {
+        int leaf = root;
+        for (int child; (child = largestChild(leaf, size)) >= 0; )
+            leaf = child;
+
+        const int value = m_a[root];
+        int target = leaf;
+        while (target != root) {
+            m_rec.record(TraceEvent::Compare, root, target);
+            if (m_a[target] >= value) break;
+            target = (target - 1) / Arity;
+        }
+        if (target == root) return;
+
+        // 路径 root → target 上的元素各上移一层、下沉元素落到 target；记录为自上而下的逐层交换
+        int path[32];
+        int depth = 0;
+        for (int i = target; i != root; i = (i - 1) / Arity)
+            path[depth++] = i;
+        while (depth > 0) {
+            const int child = path[--depth];
+            const int parent = (child - 1) / Arity;
+            std::swap(m_a[parent], m_a[child]);
+            m_rec.record(TraceEvent::Swap, parent, child);
+        }
+    }
+
+    QVector<int>& m_a;
+    Options m_options;
+    Recorder& m_rec;
+};
+
+// 不支持的叉数按二叉堆处理
+template <class Recorder>
+void sort(QVector<int>& a, const Options& options, Recorder& rec) {
+    switch (options.arity) {
+    case 4:  Sorter<4, Recorder>(a, options, rec).run(); break;
+    case 8:  Sorter<8, Recorder>(a, options, rec).run(); break;
+    default: Sorter<2, Recorder>(a, options, rec).run(); break;
+    }
+}
+
+}
+
+#endif // HEAPSORT_H
@@ -0,0 +1,229 @@
+#include "histogramitem.h"
+
+static const qreal kSideMargin = 40;     // 左右留白
+static const qreal kBottomMargin = 50;   // 柱子底边到区域底部的距离
+static const qreal kTopMargin = 90;      // 最高柱子上方留白
+static const qreal kMinLabelSlot = 24;   // 槽宽不小于该值时才绘制数值
+
+HistogramItem::HistogramItem(QSizeF areaSize, QGraphicsItem* parent)
+    : QGraphicsItem(parent), m_areaSize(areaSize), m_maxValue(1), m_bandFirst(0), m_bandLast(-1) {
+    setFlag(QGraphicsItem::ItemUsesExtendedStyleOption, true);
+}
+
+int HistogramItem::append(int value) {
+    m_values.append(value);
+    m_states.append(Normal);
+    if (!m_owners.isEmpty())
+        m_owners.append(-1);
+    // 元素个数变化会改变所有柱子的宽度
+    updateMaxValue(value);
+    update();
+    return m_values.size() - 1;
+}
+
+void HistogramItem::setValues(const QVector<int>& values) {
+    m_values = values;
+    m_states.fill(Normal, values.size());
+    m_owners.clear();
+    m_maxValue = 1;
+    for (int v : values)
+        m_maxValue = qMax(m_maxValue, v);
+    update();
+}
+
+void HistogramItem::swapValues(int i, int j) {
+    if (i < 0 || j < 0 || i >= m_values.size() || j >= m_values.size() || i == j) return;
+    std::swap(m_values[i], m_values[j]);
+    update(columnRect(qMin(i, j), qMax(i, j)));
+}
+
+void HistogramItem::setValue(int index, int value) {
+    if (index < 0 || index >= m_values.size()) return;
+    m_values[index] = value;
+    if (value > m_maxValue) {
+        updateMaxValue(value);
+        update();
+    } else {
+        update(columnRect(index, index));
+    }
+}
+
+void HistogramItem::setState(int index, BarState state) {
+    if (index < 0 || index >= m_states.size() || m_states[index] == state) return;
+    m_states[index] = state;
+    update(columnRect(index, index));
+}
+
+void HistogramItem::setAllStates(BarState state) {
+    m_states.fill(state);
+    update();
+}
+
+void HistogramItem::setOwner(int index, int owner) {
+    if (index < 0 || index >= m_values.size()) return;
+    if (m_owners.size() != m_values.size())
+        m_owners.fill(-1, m_values.size());
+    if (m_owners[index] == owner) return;
+    m_owners[index] = static_cast<qint16>(owner);
+    update(columnRect(index, index));
+}
+
+void HistogramItem::setBand(int first, int last) {
+    if (first == m_bandFirst && last == m_bandLast) return;
+    m_bandFirst = first;
+    m_bandLast = last;
+    update();
+}
+
+void HistogramItem::clear() {
+    m_values.clear();
+    m_states.clear();
+    m_owners.clear();
+    m_maxValue = 1;
+    m_bandFirst = 0;
+    m_bandLast = -1;
+    update();
+}
+
+int HistogramItem::count() const {
+    return m_values.size();
+}
+
+int HistogramItem::value(int index) const {
+    return m_values[index];
+}
+
+HistogramItem::BarState HistogramItem::state(int index) const {
+    return static_cast<BarState>(m_states[index]);
+}
+
+const QVector<int>& HistogramItem::values() const {
+    return m_values;
+}
+
+void HistogramItem::updateMaxValue(int value) {
+    m_maxValue = qMax(m_maxValue, value);
+}
+
+qreal HistogramItem::slotWidth() const {
+    return (m_areaSize.width() - 2 * kSideMargin) / qMax(1, m_values.size());
+}
+
+qreal HistogramItem::barHeight(int value) const {
+    qreal maxHeight = m_areaSize.height() - kBottomMargin - kTopMargin;
+    return qMax<qreal>(1, maxHeight * qMax(0, value) / m_maxValue);
+}
+
+QRectF HistogramItem::columnRect(int first, int last) const {
+    qreal slot = slotWidth();
+    return QRectF(kSideMargin + first * slot - 1, 0, (last - first + 1) * slot + 2, m_areaSize.height());
+}
+
+QRectF HistogramItem::boundingRect() const {
+    return QRectF(0, 0, m_areaSize.width(), m_areaSize.height());
+}
+
+QColor HistogramItem::stateColor(BarState state) {
+    switch (state) {
+    case Compare: return QColor("#E5C07B");
+    case Swap:    return QColor("#E06C75");
+    case Pivot:   return QColor("#C678DD");
+    case Sorted:  return QColor("#98C379");
+    default:      return QColor("#707070");
+    }
+}
+
+QColor HistogramItem::ownerColor(int owner) {
+    static const QColor palette[] = {QColor("#61AFEF"), QColor("#E5C07B"), QColor("#C678DD"), QColor("#56B6C2"),
+                                     QColor("#E06C75"), QColor("#98C379"), QColor("#D19A66"), QColor("#BE5046")};
+    if (owner < 0) return stateColor(Normal);
+    if (owner < 8) return palette[owner];
+    // 超出调色板时按黄金角在色环上取色，相邻编号的颜色仍然容易区分
+    return QColor::fromHsv((owner * 137) % 360, 150, 225);
+}
+
+QColor HistogramItem::barColor(int index, const QColor* colors) const {
+    if (m_owners.size() == m_values.size() && m_states[index] == Normal && m_owners[index] >= 0)
+        return ownerColor(m_owners[index]);
+    return colors[m_states[index]];
+}
+
+// 每个像素列画一根柱子：高度取列内最高者，颜色取列内最后一个非普通状态的柱子（没有时取最高者），
+// 使正在比较或刚找到的单个元素在百万元素中仍然可见
+void HistogramItem::paintColumns(QPainter* painter, int first, int last, const QColor* colors) {
+    const qreal slot = slotWidth();
+    const qreal baseline = m_areaSize.height() - kBottomMargin;
+    painter->setPen(Qt::NoPen);
+
+    int column = static_cast<int>(first * slot);
+    int tallest = first;
+    int marked = -1;
+    auto flush = [&]() {
+        const qreal h = barHeight(m_values[tallest]);
+        painter->setBrush(barColor(marked >= 0 ? marked : tallest, colors));
+        painter->drawRect(QRectF(kSideMargin + column, baseline - h, 1, h));
+    };
+    for (int i = first; i <= last; ++i) {
+        const int x = static_cast<int>(i * slot);
+        if (x != column) {
+            flush();
+            column = x;
+            tallest = i;
+            marked = -1;
+        }
+        if (m_values[i] > m_values[tallest]) tallest = i;
+        if (m_states[i] != Normal) marked = i;
+    }
+    flush();
+}
+
+void HistogramItem::paint(QPainter* painter, const QStyleOptionGraphicsItem* option, QWidget* widget) {
+    Q_UNUSED(widget);
+    if (m_values.isEmpty()) return;
+
+    const qreal slot = slotWidth();
+    const QRectF exposed = option->exposedRect;
+    const int first = qMax(0, static_cast<int>((exposed.left() - kSideMargin) / slot));
+    const int last = qMin(m_values.size() - 1, static_cast<int>((exposed.right() - kSideMargin) / slot));
+    if (first > last) return;
+
+    // 区间阴影画在柱子之下，再窄也至少两个像素宽
+    if (m_bandFirst <= m_bandLast) {
+        const qreal left = kSideMargin + m_bandFirst * slot;
+        const qreal width = qMax<qreal>(2, (m_bandLast - m_bandFirst + 1) * slot);
+        painter->setPen(Qt::NoPen);
+        painter->setBrush(QColor(97, 175, 239, 45));
+        painter->drawRect(QRectF(left, kTopMargin / 2, width, m_areaSize.height() - kBottomMargin - kTopMargin / 2));
+    }
+
+    // 柱子足够宽时留出间隔并描边，过窄时相邻柱子连成一片
+    const bool wide = slot >= 6;
+    const qreal barWidth = wide ? slot * 0.7 : slot;
+    const qreal baseline = m_areaSize.height() - kBottomMargin;
+
+    QColor colors[Sorted + 1];
+    for (int s = Normal; s <= Sorted; ++s)
+        colors[s] = stateColor(static_cast<BarState>(s));
+
+    if (slot < 1) {
+        paintColumns(painter, first, last, colors);
+        return;
+    }
+
+    painter->setPen(wide ? QPen(QColor("#E0E0E0"), 2) : QPen(Qt::NoPen));
+    for (int i = first; i <= last; ++i) {
+        qreal h = barHeight(m_values[i]);
+        QRectF bar(kSideMargin + i * slot + (slot - barWidth) / 2, baseline - h, barWidth, h);
+        painter->setBrush(barColor(i, colors));
+        painter->drawRect(bar);
+    }
+
+    if (slot < kMinLabelSlot) return;
+
+    painter->setPen(QColor("#ABB2BF"));
+    painter->setFont(QFont("Segoe UI", 12, QFont::Bold));
+    for (int i = first; i <= last; ++i) {
+        QRectF labelRect(kSideMargin + i * slot, baseline + 5, slot, 30);
+        painter->drawText(labelRect, Qt::AlignHCenter | Qt::AlignTop, QString::number(m_values[i]));
+    }
+}
@@ -0,0 +1,64 @@
+#ifndef HISTOGRAMITEM_H
+#define HISTOGRAMITEM_H
+
+#include <QGraphicsItem>
+#include <QStyleOptionGraphicsItem>
+#include <QPainter>
+#include <QVector>
+#include <QSizeF>
+#include <QColor>
+
+// 排序与查找可视化的柱状图：单个图元按连续的 values[] / states[] 数组绘制全部柱子
+// 柱宽随元素个数自动缩放以适应视图，交换只修改两个槽位并标记一块脏区域；
+// 柱子窄于一个像素时每个像素列只画一根，百万元素也只需绘制视图宽度那么多个矩形
+class HistogramItem : public QGraphicsItem {
+public:
+    enum BarState : quint8 {
+        Normal,     // 普通
+        Compare,    // 正在比较
+        Swap,       // 刚刚交换
+        Pivot,      // 主元
+        Sorted      // 已排序
+    };
+
+    explicit HistogramItem(QSizeF areaSize, QGraphicsItem* parent = nullptr);
+
+    int append(int value);                       // 追加元素，返回下标
+    void setValues(const QVector<int>& values);  // 整体载入
+    void swapValues(int i, int j);
+    void setValue(int index, int value);
+    void setState(int index, BarState state);
+    void setAllStates(BarState state);
+    void setOwner(int index, int owner);         // 并行排序：普通状态的柱子按所属工作者着色，-1 取消
+    void setBand(int first, int last);           // 以阴影标出区间 [first, last]，first > last 时取消
+    void clear();
+
+    int count() const;
+    int value(int index) const;
+    BarState state(int index) const;
+    const QVector<int>& values() const;
+    QRectF columnRect(int first, int last) const; // 覆盖 [first, last] 柱子及标签的区域
+
+    QRectF boundingRect() const override;
+    void paint(QPainter* painter, const QStyleOptionGraphicsItem* option, QWidget* widget = nullptr) override;
+
+    static QColor stateColor(BarState state);
+    static QColor ownerColor(int owner);
+
+private:
+    qreal slotWidth() const;
+    qreal barHeight(int value) const;
+    QColor barColor(int index, const QColor* colors) const;
+    void paintColumns(QPainter* painter, int first, int last, const QColor* colors);
+    void updateMaxValue(int value);
+
+    QSizeF m_areaSize;
+    QVector<int> m_values;
+    QVector<quint8> m_states;
+    QVector<qint16> m_owners;                    // 未设置过所属工作者时为空
+    int m_maxValue;
+    int m_bandFirst;
+    int m_bandLast;
+};
+
+#endif // HISTOGRAMITEM_H
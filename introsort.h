@@ -0,0 +1,344 @@
+#ifndef INTROSORT_H
+#define INTROSORT_H
+
+#include "sorttrace.h"
+#include <QString>
+#include <QVector>
+#include <algorithm>
+
+// 内省排序 / pdqsort：快速排序 + 小区间插入排序 + 深度超限时回退堆排序
+// 划分方式与主元选取可选；与 RadixSort 一样以模板接收记录器，计时时传入 NullRecorder
+namespace IntroSort {
+
+enum Partition {
+    Lomuto,         // 单向扫描
+    Hoare,          // 双向扫描（与 codes/quicksort.c 相同的 COMPARE_A / COMPARE_B 协议）
+    Block,          // 块划分：先批量记录错位下标再成对交换，比较不产生分支
+    ThreeWay        // 三路划分（荷兰国旗），大量重复值时等值区间一次归位
+};
+
+enum PivotRule {
+    First,          // 首元素
+    MedianOf3,      // 首、中、尾三数取中
+    Ninther         // 九数取中（区间较大时）
+};
+
+struct Options {
+    Partition partition = Hoare;
+    PivotRule pivot = MedianOf3;
+    bool patternDefeating = false;  // pdqsort：只对不平衡的划分计数，并打乱元素破坏输入模式
+};
+
+const int InsertionThreshold = 16;   // 不超过该长度的区间直接插入排序
+const int NintherThreshold = 128;    // 超过该长度才使用九数取中
+const int BlockSize = 64;            // 块划分每块的元素个数
+
+inline QString partitionName(Partition partition) {
+    switch (partition) {
+    case Lomuto:   return "Lomuto";
+    case Hoare:    return "Hoare";
+    case Block:    return "块划分";
+    case ThreeWay: return "三路划分";
+    }
+    return QString();
+}
+
+inline QString pivotName(PivotRule pivot) {
+    switch (pivot) {
+    case First:     return "首元素";
+    case MedianOf3: return "三数取中";
+    case Ninther:   return "九数取中";
+    }
+    return QString();
+}
+
+// 轨迹生成接口只有一个整数参数，选项按位打包
+inline int encode(const Options& options) {
+    return options.partition | (options.pivot << 4) | (options.patternDefeating ? 1 << 8 : 0);
+}
+
+inline Options decode(int parameter) {
+    Options options;
+    options.partition = static_cast<Partition>(qBound(0, parameter & 0xF, static_cast<int>(ThreeWay)));
+    options.pivot = static_cast<PivotRule>(qBound(0, (parameter >> 4) & 0xF, static_cast<int>(Ninther)));
+    options.patternDefeating = (parameter >> 8) & 1;
+    return options;
+}
+
+template <class Recorder>
+class Sorter {
+public:
+    Sorter(QVector<int>& a, const Options& options, Recorder& rec)
+        : m_a(a), m_options(options), m_rec(rec) {}
+
+    void run() {
+        const int n = m_a.size();
+        int log2n = 0;
+        while ((2 << log2n) <= n)
+            ++log2n;
+
+        // 内省排序按递归深度限制（2·log n）；pdqsort 只对不平衡划分计数（log n）
+        struct Range { int lo, hi, budget; };
+        QVector<Range> stack;
+        stack.append(Range{0, n - 1, m_options.patternDefeating ? log2n : 2 * log2n});
+
+        while (!stack.isEmpty() && !m_rec.truncated()) {
+            const Range range = stack.last();
+            stack.removeLast();
+            const int lo = range.lo;
+            const int hi = range.hi;
+            const int size = hi - lo + 1;
+            if (size <= 0) continue;
+
+            if (size <= InsertionThreshold) {
+                insertionSort(lo, hi);
+                markSorted(lo, hi);
+                continue;
+            }
+            if (range.budget <= 0) {
+                m_rec.record(TraceEvent::HeapFallback, lo, hi);
+                heapSort(lo, hi);
+                markSorted(lo, hi);
+                continue;
+            }
+
+            choosePivot(lo, hi);
+            m_rec.record(TraceEvent::Pivot, lo, m_a[lo]);
+
+            int leftHi, rightLo;
+            if (m_options.partition == ThreeWay) {
+                int lt, gt;
+                partitionThreeWay(lo, hi, &lt, &gt);
+                markSorted(lt, gt);
+                leftHi = lt - 1;
+                rightLo = gt + 1;
+            } else {
+                int p = m_options.partition == Lomuto ? partitionLomuto(lo, hi)
+                      : m_options.partition == Block  ? partitionBlock(lo, hi)
+                                                      : partitionHoare(lo, hi);
+                markSorted(p, p);
+                leftHi = p - 1;
+                rightLo = p + 1;
+            }
+
+            int budget = range.budget - 1;
+            if (m_options.patternDefeating) {
+                const int leftSize = leftHi - lo + 1;
+                const int rightSize = hi - rightLo + 1;
+                if (qMin(leftSize, rightSize) < size / 8) {
+                    breakPatterns(lo, leftHi);
+                    breakPatterns(rightLo, hi);
+                } else {
+                    budget = range.budget;
+                }
+            }
+
+            // 先处理左侧，显式栈保证从左到右推进
+            stack.append(Range{rightLo, hi, budget});
+            stack.append(Range{lo, leftHi, budget});
+        }
+    }
+
+private:
+    bool less(int i, int j) {
+        m_rec.record(TraceEvent::Compare, i, j);
+        return m_a[i] < m_a[j];
+    }
+
+    void swap(int i, int j) {
+        if (i == j) return;
+        std::swap(m_a[i], m_a[j]);
+        m_rec.record(TraceEvent::Swap, i, j);
+    }
+
+    void markSorted(int lo, int hi) {
+        for (int i = lo; i <= hi; ++i)
+            m_rec.record(TraceEvent::MarkSorted, i);
+    }
+
+    void sort3(int i, int j, int k) {
+        if (less(j, i)) swap(i, j);
+        if (less(k, j)) {
+            swap(j, k);
+            if (less(j, i)) swap(i, j);
+        }
+    }
+
+    // 选出的主元交换到 lo
+    void choosePivot(int lo, int hi) {
+        const int size = hi - lo + 1;
+        const int mid = lo + size / 2;
+        if (m_options.pivot == First) return;
+        if (m_options.pivot == Ninther && size > NintherThreshold) {
+            sort3(lo, mid, hi);
+            sort3(lo + 1, mid - 1, hi - 1);
+            sort3(lo + 2, mid + 1, hi - 2);
+            sort3(mid - 1, mid, mid + 1);
+        } else {
+            sort3(lo, mid, hi);
+        }
+        swap(lo, mid);
+    }
+
+    void insertionSort(int lo, int hi) {
+        for (int i = lo + 1; i <= hi; ++i) {
+            for (int j = i; j > lo && less(j, j - 1); --j)
+                swap(j, j - 1);
+        }
+    }
+
+    void siftDown(int lo, int root, int size) {
+        while (true) {
+            int largest = root;
+            int left = 2 * root + 1;
+            int right = left + 1;
+            if (left < size && less(lo + largest, lo + left)) largest = left;
+            if (right < size && less(lo + largest, lo + right)) largest = right;
+            if (largest == root) return;
+            swap(lo + root, lo + largest);
+            root = largest;
+        }
+    }
+
+    void heapSort(int lo, int hi) {
+        const int size = hi - lo + 1;
+        for (int i = size / 2 - 1; i >= 0; --i)
+            siftDown(lo, i, size);
+        for (int last = size - 1; last > 0 && !m_rec.truncated(); --last) {
+            swap(lo, lo + last);
+            siftDown(lo, 0, last);
+        }
+    }
+
+    // 划分出现严重不平衡时交换几个位置，避免对同一种输入模式反复选到坏主元
+    void breakPatterns(int lo, int hi) {
+        const int size = hi - lo + 1;
+        if (size < InsertionThreshold) return;
+        swap(lo, lo + size / 4);
+        swap(hi, hi - size / 4);
+        if (size > NintherThreshold) {
+            swap(lo + 1, lo + size / 4 + 1);
+            swap(lo + 2, lo + size / 4 + 2);
+            swap(hi - 1, hi - size / 4 - 1);
+            swap(hi - 2, hi - size / 4 - 2);
+        }
+    }
+
+    // 以下各划分的主元都在 lo；返回主元最终位置
+    int partitionLomuto(int lo, int hi) {
+        int store = lo;
+        for (int i = lo + 1; i <= hi; ++i) {
+            if (less(i, lo))
+                swap(++store, i);
+        }
+        swap(lo, store);
+        return store;
+    }
+
+    int partitionHoare(int lo, int hi) {
+        const int pivot = m_a[lo];
+        int i = lo + 1;
+        int j = hi;
+        while (true) {
+            while (i <= j) {
+                m_rec.record(TraceEvent::CompareA, i, lo);
+                if (m_a[i] > pivot) break;
+                ++i;
+            }
+            while (i <= j) {
+                m_rec.record(TraceEvent::CompareB, j, lo);
+                if (m_a[j] <= pivot) break;
+                --j;
+            }
+            if (i >= j) break;
+            swap(i, j);
+            ++i;
+            --j;
+        }
+        swap(lo, j);
+        return j;
+    }
+
+    // 左块记录不小于主元的偏移，右块记录小于主元的偏移，再成对交换；
+    // 比较结果直接累加到计数上，内层循环没有依赖数据的分支。剩余不足两块时按普通双向扫描收尾
+    int partitionBlock(int lo, int hi) {
+        const int pivot = m_a[lo];
+        int offsetsL[BlockSize];
+        int offsetsR[BlockSize];
+        int numL = 0, numR = 0, startL = 0, startR = 0;
+        int l = lo + 1;
+        int r = hi;
+
+        while (r - l + 1 > 2 * BlockSize) {
+            if (numL == 0) {
+                startL = 0;
+                for (int k = 0; k < BlockSize; ++k) {
+                    m_rec.record(TraceEvent::Compare, l + k, lo);
+                    offsetsL[numL] = k;
+                    numL += !(m_a[l + k] < pivot);
+                }
+            }
+            if (numR == 0) {
+                startR = 0;
+                for (int k = 0; k < BlockSize; ++k) {
+                    m_rec.record(TraceEvent::Compare, r - k, lo);
+                    offsetsR[numR] = k;
+                    numR += m_a[r - k] < pivot;
+                }
+            }
+            const int num = qMin(numL, numR);
+            for (int k = 0; k < num; ++k)
+                swap(l + offsetsL[startL + k], r - offsetsR[startR + k]);
+            numL -= num;
+            numR -= num;
+            startL += num;
+            startR += num;
+            if (numL == 0) l += BlockSize;
+            if (numR == 0) r -= BlockSize;
+        }
+
+        // [lo+1, l) 均小于主元，(r, hi] 均不小于主元；剩余区间逐个扫描
+        while (true) {
+            while (l <= r && less(l, lo)) ++l;
+            while (l <= r && !less(r, lo)) --r;
+            if (l >= r) break;
+            swap(l, r);
+            ++l;
+            --r;
+        }
+        swap(lo, l - 1);
+        return l - 1;
+    }
+
+    // 结束后 [lo, lt) < 主元，[lt, gt] == 主元，(gt, hi] > 主元
+    void partitionThreeWay(int lo, int hi, int* lt, int* gt) {
+        // a[lower] 始终是一个等于主元的元素，用作比较基准
+        int lower = lo;
+        int i = lo + 1;
+        int upper = hi;
+        while (i <= upper) {
+            if (less(i, lower)) {
+                swap(lower++, i++);
+            } else if (less(lower, i)) {
+                swap(i, upper--);
+            } else {
+                ++i;
+            }
+        }
+        *lt = lower;
+        *gt = upper;
+    }
+
+    QVector<int>& m_a;
+    Options m_options;
+    Recorder& m_rec;
+};
+
+template <class Recorder>
+void sort(QVector<int>& a, const Options& options, Recorder& rec) {
+    Sorter<Recorder>(a, options, rec).run();
+}
+
+}
+
+#endif // INTROSORT_H
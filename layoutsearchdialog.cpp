@@ -0,0 +1,221 @@
+#include "layoutsearchdialog.h"
+#include <QHBoxLayout>
+#include <QVBoxLayout>
+#include <QCloseEvent>
+#include <QtMath>
+
+static const qreal kChartMargin = 44;
+
+LayoutSearchChart::LayoutSearchChart(QWidget* parent)
+    : QWidget(parent), m_maxBytes(LayoutSearchWorker::MinBytes * 4) {
+    setMinimumSize(480, 300);
+}
+
+void LayoutSearchChart::setPoints(const QVector<QVector<QPointF>>& points, qint64 maxBytes) {
+    m_points = points;
+    m_maxBytes = qMax(LayoutSearchWorker::MinBytes * 4, maxBytes);
+    update();
+}
+
+QColor LayoutSearchChart::kindColor(int kind) {
+    switch (kind) {
+    case SearchLayout::Sorted:    return QColor("#E06C75");
+    case SearchLayout::Eytzinger: return QColor("#E5C07B");
+    default:                      return QColor("#61AFEF");
+    }
+}
+
+void LayoutSearchChart::paintEvent(QPaintEvent* event) {
+    Q_UNUSED(event);
+    QPainter painter(this);
+    painter.setRenderHint(QPainter::Antialiasing);
+    painter.setFont(QFont("Segoe UI", 8));
+
+    const QRectF area = QRectF(rect()).adjusted(kChartMargin, 10, -10, -kChartMargin);
+    painter.setPen(QPen(QColor("#555555"), 1));
+    painter.drawLine(area.bottomLeft(), area.bottomRight());
+    painter.drawLine(area.bottomLeft(), area.topLeft());
+
+    double maxNanos = 1;
+    for (const QVector<QPointF>& series : m_points)
+        for (const QPointF& p : series)
+            maxNanos = qMax(maxNanos, p.y());
+    maxNanos *= 1.1;
+
+    const double logSpan = qLn(static_cast<double>(m_maxBytes) / LayoutSearchWorker::MinBytes);
+    auto toPoint = [&](double bytes, double nanos) {
+        return QPointF(area.left() + area.width() * qLn(bytes / LayoutSearchWorker::MinBytes) / logSpan,
+                       area.bottom() - area.height() * nanos / maxNanos);
+    };
+
+    // 横轴刻度与典型缓存容量（实际容量因处理器而异）
+    painter.setPen(QColor("#ABB2BF"));
+    for (qint64 bytes : LayoutSearchWorker::sizes(m_maxBytes)) {
+        QPointF p = toPoint(bytes, 0);
+        painter.drawText(QRectF(p.x() - 24, area.bottom() + 4, 48, 14), Qt::AlignCenter, LayoutSearchWorker::bytesName(bytes));
+    }
+    painter.drawText(QRectF(area.left(), area.bottom() + 20, area.width(), 14), Qt::AlignCenter, "数组大小");
+    const QPair<qint64, QString> caches[] = {
+        qMakePair(qint64(32) << 10, QString("L1")),
+        qMakePair(qint64(1) << 20, QString("L2")),
+        qMakePair(qint64(32) << 20, QString("L3"))
+    };
+    for (const auto& cache : caches) {
+        if (cache.first > m_maxBytes) continue;
+        QPointF p = toPoint(cache.first, 0);
+        painter.setPen(QPen(QColor("#444444"), 1, Qt::DotLine));
+        painter.drawLine(QPointF(p.x(), area.top()), QPointF(p.x(), area.bottom()));
+        painter.setPen(QColor("#777777"));
+        painter.drawText(QPointF(p.x() + 3, area.top() + 12), cache.second);
+    }
+
+    painter.setPen(QColor("#ABB2BF"));
+    for (int i = 0; i <= 4; ++i) {
+        const double nanos = maxNanos * i / 4;
+        QPointF q = toPoint(LayoutSearchWorker::MinBytes, nanos);
+        painter.drawText(QRectF(0, q.y() - 7, area.left() - 4, 14), Qt::AlignRight | Qt::AlignVCenter,
+                         QString("%1 ns").arg(qRound(nanos)));
+    }
+
+    for (int kind = 0; kind < m_points.size(); ++kind) {
+        QVector<QPointF> line;
+        for (const QPointF& p : m_points[kind])
+            line.append(toPoint(p.x(), p.y()));
+        const QColor color = kindColor(kind);
+        painter.setPen(QPen(color, 2));
+        painter.drawPolyline(line.constData(), line.size());
+        painter.setBrush(color);
+        for (const QPointF& p : line)
+            painter.drawEllipse(p, 3, 3);
+        painter.setBrush(Qt::NoBrush);
+
+        const qreal y = area.top() + 10 + kind * 16;
+        painter.drawLine(QPointF(area.left() + 10, y), QPointF(area.left() + 30, y));
+        painter.setPen(QColor("#ABB2BF"));
+        painter.drawText(QPointF(area.left() + 36, y + 4), SearchLayout::kindName(static_cast<SearchLayout::Kind>(kind)));
+    }
+}
+
+LayoutSearchDialog::LayoutSearchDialog(QWidget* parent)
+    : QDialog(parent), m_thread(nullptr), m_worker(nullptr) {
+    setWindowTitle("查找布局：有序数组 / Eytzinger / B 树分块");
+    setStyleSheet("background-color:#333333; color:#ABB2BF;");
+
+    QString buttonStyle =
+        "QToolButton { background-color: transparent; border: none; padding: 3px; color:#ABB2BF; font-weight:bold; }"
+        "QToolButton:hover { background-color: rgba(255, 255, 255, 30); }"
+        "QToolButton:disabled { color:#666666; }";
+
+    QLabel* maxBytesLabel = new QLabel("数组上限");
+    m_maxBytesCombo = new QComboBox;
+    for (qint64 bytes : {qint64(1) << 20, qint64(16) << 20, qint64(256) << 20, qint64(1) << 30})
+        m_maxBytesCombo->addItem(LayoutSearchWorker::bytesName(bytes), bytes);
+    m_maxBytesCombo->setCurrentIndex(2);
+    m_maxBytesCombo->setToolTip("构建布局时峰值内存约为数组大小的两倍");
+
+    QLabel* lookupsLabel = new QLabel("查找次数");
+    m_lookupsSpinBox = new QSpinBox;
+    m_lookupsSpinBox->setRange(10000, 10000000);
+    m_lookupsSpinBox->setSingleStep(100000);
+    m_lookupsSpinBox->setValue(1000000);
+    m_lookupsSpinBox->setToolTip("每种布局、每个数组大小的随机查找次数");
+
+    m_startButton = new QToolButton;
+    m_startButton->setText("开始");
+    m_startButton->setStyleSheet(buttonStyle);
+    m_stopButton = new QToolButton;
+    m_stopButton->setText("停止");
+    m_stopButton->setStyleSheet(buttonStyle);
+    m_stopButton->setEnabled(false);
+
+    QHBoxLayout* controls = new QHBoxLayout;
+    controls->addWidget(maxBytesLabel);
+    controls->addWidget(m_maxBytesCombo);
+    controls->addWidget(lookupsLabel);
+    controls->addWidget(m_lookupsSpinBox);
+    controls->addStretch();
+    controls->addWidget(m_startButton);
+    controls->addWidget(m_stopButton);
+
+    m_chart = new LayoutSearchChart;
+    m_resultLabel = new QLabel("数组超出缓存后，有序数组每次折半都可能缺失一次缓存；其余两种布局把相邻几层放进同一条缓存行");
+
+    QVBoxLayout* layout = new QVBoxLayout(this);
+    layout->addLayout(controls);
+    layout->addWidget(m_chart, 1);
+    layout->addWidget(m_resultLabel);
+
+    connect(m_startButton, &QToolButton::clicked, this, &LayoutSearchDialog::start);
+    connect(m_stopButton, &QToolButton::clicked, this, &LayoutSearchDialog::stop);
+}
+
+LayoutSearchDialog::~LayoutSearchDialog() {
+    stop();
+}
+
+void LayoutSearchDialog::closeEvent(QCloseEvent* event) {
+    stop();
+    QDialog::closeEvent(event);
+}
+
+void LayoutSearchDialog::start() {
+    if (m_thread) return;
+
+    const qint64 maxBytes = m_maxBytesCombo->currentData().toLongLong();
+    m_points = QVector<QVector<QPointF>>(SearchLayout::KindCount);
+    m_chart->setPoints(m_points, maxBytes);
+    m_resultLabel->setText("测量中……");
+    m_startButton->setEnabled(false);
+    m_stopButton->setEnabled(true);
+    m_maxBytesCombo->setEnabled(false);
+    m_lookupsSpinBox->setEnabled(false);
+
+    // 工作对象没有父对象，随线程结束一起释放
+    m_thread = new QThread;
+    m_worker = new LayoutSearchWorker(maxBytes, m_lookupsSpinBox->value());
+    m_worker->moveToThread(m_thread);
+    connect(m_thread, &QThread::started, m_worker, &LayoutSearchWorker::run);
+    connect(m_worker, &LayoutSearchWorker::finished, m_thread, &QThread::quit);
+    connect(m_thread, &QThread::finished, m_worker, &QObject::deleteLater);
+    connect(m_thread, &QThread::finished, m_thread, &QObject::deleteLater);
+    connect(m_worker, &LayoutSearchWorker::measured, this, &LayoutSearchDialog::onMeasured);
+    connect(m_worker, &LayoutSearchWorker::failed, this, &LayoutSearchDialog::onFailed);
+    connect(m_worker, &LayoutSearchWorker::finished, this, &LayoutSearchDialog::onFinished);
+    m_thread->start();
+}
+
+void LayoutSearchDialog::stop() {
+    if (!m_thread) return;
+    m_worker->cancel();
+    m_thread->quit();
+    m_thread->wait();
+    // 线程已退出，deleteLater 由 finished 信号排入主线程事件队列
+    m_thread = nullptr;
+    m_worker = nullptr;
+    m_startButton->setEnabled(true);
+    m_stopButton->setEnabled(false);
+    m_maxBytesCombo->setEnabled(true);
+    m_lookupsSpinBox->setEnabled(true);
+}
+
+void LayoutSearchDialog::onMeasured(qint64 bytes, int kind, double nanos) {
+    if (kind < 0 || kind >= m_points.size()) return;
+    m_points[kind].append(QPointF(bytes, nanos));
+    m_chart->setPoints(m_points, m_maxBytesCombo->currentData().toLongLong());
+
+    // 同一大小的三种布局都测完后汇总一行
+    if (kind != SearchLayout::KindCount - 1) return;
+    QStringList parts;
+    for (int k = 0; k < SearchLayout::KindCount; ++k)
+        parts << QString("%1 %2 ns").arg(SearchLayout::kindName(static_cast<SearchLayout::Kind>(k)))
+                                    .arg(m_points[k].last().y(), 0, 'f', 1);
+    m_resultLabel->setText(LayoutSearchWorker::bytesName(bytes) + "：" + parts.join(" · "));
+}
+
+void LayoutSearchDialog::onFailed(const QString& message) {
+    m_resultLabel->setText(message);
+}
+
+void LayoutSearchDialog::onFinished() {
+    stop();
+}
@@ -0,0 +1,66 @@
+#ifndef LAYOUTSEARCHDIALOG_H
+#define LAYOUTSEARCHDIALOG_H
+
+#include "benchmark.h"
+#include <QDialog>
+#include <QWidget>
+#include <QSpinBox>
+#include <QComboBox>
+#include <QLabel>
+#include <QToolButton>
+#include <QThread>
+#include <QPainter>
+#include <QPaintEvent>
+#include <QPointF>
+#include <QVector>
+
+// 数组大小-单次查找耗时曲线，横轴为对数刻度，标出典型的 L1 / L2 / L3 容量
+class LayoutSearchChart : public QWidget {
+    Q_OBJECT
+
+public:
+    explicit LayoutSearchChart(QWidget* parent = nullptr);
+    // points[kind] 为该布局的 (字节数, 纳秒) 序列
+    void setPoints(const QVector<QVector<QPointF>>& points, qint64 maxBytes);
+
+    static QColor kindColor(int kind);
+
+protected:
+    void paintEvent(QPaintEvent* event) override;
+
+private:
+    QVector<QVector<QPointF>> m_points;
+    qint64 m_maxBytes;
+};
+
+// 查找布局对话框：在 1 KB 到所选上限的数组上比较有序数组、Eytzinger、B 树分块三种布局的随机查找耗时
+class LayoutSearchDialog : public QDialog {
+    Q_OBJECT
+
+public:
+    explicit LayoutSearchDialog(QWidget* parent = nullptr);
+    ~LayoutSearchDialog();
+
+protected:
+    void closeEvent(QCloseEvent* event) override;
+
+private:
+    void start();
+    void stop();                                   // 取消测量并等待工作线程退出
+    void onMeasured(qint64 bytes, int kind, double nanos);
+    void onFailed(const QString& message);
+    void onFinished();
+
+    QComboBox* m_maxBytesCombo;
+    QSpinBox* m_lookupsSpinBox;
+    QToolButton* m_startButton;
+    QToolButton* m_stopButton;
+    QLabel* m_resultLabel;
+    LayoutSearchChart* m_chart;
+
+    QThread* m_thread;
+    LayoutSearchWorker* m_worker;
+    QVector<QVector<QPointF>> m_points;
+};
+
+#endif // LAYOUTSEARCHDIALOG_H
@@ -0,0 +1,55 @@
+#include "loditems.h"
+
+qreal Lod::levelOf(const QPainter* painter) {
+    return QStyleOptionGraphicsItem::levelOfDetailFromTransform(painter->worldTransform());
+}
+
+// 简化绘制：用填充色画一个色块（抗锯齿由 GraphicsView 按缩放统一关闭）
+static void paintSimplified(QPainter* painter, const QRectF& rect, const QBrush& brush) {
+    painter->fillRect(rect, brush.color());
+}
+
+LodEllipseItem::LodEllipseItem(qreal x, qreal y, qreal w, qreal h, QGraphicsItem* parent)
+    : QGraphicsEllipseItem(x, y, w, h, parent) {}
+
+void LodEllipseItem::paint(QPainter* painter, const QStyleOptionGraphicsItem* option, QWidget* widget) {
+    const qreal lod = Lod::levelOf(painter);
+    if (lod * rect().width() < 1) return;   // 不足一个像素
+    if (lod < Lod::DetailThreshold) {
+        paintSimplified(painter, rect(), brush());
+        return;
+    }
+    QGraphicsEllipseItem::paint(painter, option, widget);
+}
+
+LodRectItem::LodRectItem(qreal x, qreal y, qreal w, qreal h, QGraphicsItem* parent)
+    : QGraphicsRectItem(x, y, w, h, parent) {}
+
+void LodRectItem::paint(QPainter* painter, const QStyleOptionGraphicsItem* option, QWidget* widget) {
+    const qreal lod = Lod::levelOf(painter);
+    if (lod * qMax(rect().width(), rect().height()) < 1) return;
+    if (lod < Lod::DetailThreshold) {
+        paintSimplified(painter, rect(), brush());
+        return;
+    }
+    QGraphicsRectItem::paint(painter, option, widget);
+}
+
+LodTextItem::LodTextItem(const QString& text, QGraphicsItem* parent)
+    : QGraphicsTextItem(text, parent) {}
+
+void LodTextItem::paint(QPainter* painter, const QStyleOptionGraphicsItem* option, QWidget* widget) {
+    if (Lod::levelOf(painter) < Lod::DetailThreshold) return; // 文字此时已无法辨认
+    QGraphicsTextItem::paint(painter, option, widget);
+}
+
+LodShadowEffect::LodShadowEffect(QObject* parent)
+    : QGraphicsDropShadowEffect(parent) {}
+
+void LodShadowEffect::draw(QPainter* painter) {
+    if (Lod::levelOf(painter) < Lod::DetailThreshold) {
+        drawSource(painter);
+        return;
+    }
+    QGraphicsDropShadowEffect::draw(painter);
+}
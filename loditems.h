@@ -0,0 +1,46 @@
+#ifndef LODITEMS_H
+#define LODITEMS_H
+
+#include <QGraphicsEllipseItem>
+#include <QGraphicsRectItem>
+#include <QGraphicsTextItem>
+#include <QGraphicsDropShadowEffect>
+#include <QStyleOptionGraphicsItem>
+#include <QPainter>
+
+// 细节层次（LOD）：依据 QStyleOptionGraphicsItem::levelOfDetailFromTransform 决定绘制精度
+// 缩放低于阈值时省略文字与阴影、节点退化为单色色块；屏幕上不足 1 像素的图元直接剔除
+namespace Lod {
+    const qreal DetailThreshold = 0.4;       // 低于该缩放只绘制简化图形
+
+    qreal levelOf(const QPainter* painter);  // 当前绘制变换下的细节层次
+}
+
+class LodEllipseItem : public QGraphicsEllipseItem {
+public:
+    LodEllipseItem(qreal x, qreal y, qreal w, qreal h, QGraphicsItem* parent = nullptr);
+    void paint(QPainter* painter, const QStyleOptionGraphicsItem* option, QWidget* widget = nullptr) override;
+};
+
+class LodRectItem : public QGraphicsRectItem {
+public:
+    LodRectItem(qreal x, qreal y, qreal w, qreal h, QGraphicsItem* parent = nullptr);
+    void paint(QPainter* painter, const QStyleOptionGraphicsItem* option, QWidget* widget = nullptr) override;
+};
+
+class LodTextItem : public QGraphicsTextItem {
+public:
+    explicit LodTextItem(const QString& text, QGraphicsItem* parent = nullptr);
+    void paint(QPainter* painter, const QStyleOptionGraphicsItem* option, QWidget* widget = nullptr) override;
+};
+
+// 缩小后只绘制图元本身，不再做阴影模糊
+class LodShadowEffect : public QGraphicsDropShadowEffect {
+public:
+    explicit LodShadowEffect(QObject* parent = nullptr);
+
+protected:
+    void draw(QPainter* painter) override;
+};
+
+#endif // LODITEMS_H
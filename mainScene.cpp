@@ -23,6 +23,15 @@ Widget::Widget(QWidget *parent)
         if (gdbProcess && gdbProcess->state() == QProcess::Running)
             gdbProcess->write("step\n");
     });
+    connect(loadDatasetButton, &QToolButton::clicked, this, &Widget::loadDataset);
+    connect(nativeRunButton, &QToolButton::clicked, this, &Widget::startNativeTrace);
+    connect(benchmarkButton, &QToolButton::clicked, this, &Widget::openBenchmark);
+    connect(speedupButton, &QToolButton::clicked, this, &Widget::openSpeedup);
+    connect(layoutBenchmarkButton, &QToolButton::clicked, this, &Widget::openLayoutBenchmark);
+    connect(searchBatchButton, &QToolButton::clicked, this, &Widget::runSearchBatch);
+    connect(btreeOrderButton, &QToolButton::clicked, this, &Widget::openBTreeOrderBenchmark);
+    connect(btreeBulkButton, &QToolButton::clicked, this, &Widget::runBTreeBulkLoad);
+    connect(bstBuildButton, &QToolButton::clicked, this, &Widget::runBSTBuild);
 
 }
 
@@ -98,8 +107,9 @@ void Widget::createTreeWidget()
     QStringList linearList = {" 链表", " 栈", " 队列"};
     QStringList treeList = {" 先序遍历", " 中序遍历", " 后序遍历", " 平衡二叉树", " B树"};
     QStringList graphList = {" 深度优先搜索", " 宽度优先搜索", " Dijkstra", " Floyd"};
-    QStringList searchList = {" 折半查找"};
-    QStringList sortList = {" 冒泡排序", " 快速排序", " 堆排序", " 桶排序"};
+    QStringList searchList = {" 折半查找", " 插值查找", " 指数查找", " 斐波那契查找", " 缓存友好查找"};
+    QStringList sortList = {" 冒泡排序", " 快速排序", " 内省排序", " 堆排序", " 桶排序", " LSD基数排序", " MSD基数排序",
+                            " 并行归并排序", " 并行样本排序"};
 
     // 创建父节点并设置不可选中
     QTreeWidgetItem *item1 = new QTreeWidgetItem(treeWidget, QStringList(categories[0]));
@@ -145,9 +155,17 @@ void Widget::createVisualizationArea()
     logArea->setStyleSheet(
         "background-color:#333333; color:#ffffff; border-radius:10px; margin:5px; padding:5px;");
 
+    // 日志区右侧为操作计数面板
+    counterPanel = new CounterPanel;
+    QSplitter *bottomSplitter = new QSplitter(Qt::Horizontal);
+    bottomSplitter->addWidget(logArea);
+    bottomSplitter->addWidget(counterPanel);
+    bottomSplitter->setStretchFactor(0, 3);
+    bottomSplitter->setStretchFactor(1, 2);
+
     verticalSplitter = new QSplitter(Qt::Vertical);
     verticalSplitter->addWidget(visualAreaView);
-    verticalSplitter->addWidget(logArea);
+    verticalSplitter->addWidget(bottomSplitter);
     verticalSplitter->setStretchFactor(0, 3);
     verticalSplitter->setStretchFactor(1, 1);
     verticalSplitter->setSizes({600, 200});
@@ -270,6 +288,7 @@ void Widget::createCodeAndButtonArea()
             int interval = speedToInterval(value);
             autoStepTimer->start(interval);
         }
+        tracePlayer->setSpeed(value);
     });
 
     // 将按钮添加到控制面板布局
@@ -283,11 +302,266 @@ void Widget::createCodeAndButtonArea()
     controlLayout->addWidget(speedSlider);
     controlLayout->addStretch();
 
+    // 数据集与原生运行区（元素个数、输入分布、随机种子）
+    QWidget *tracePanel = new QWidget;
+    tracePanel->setFixedHeight(50);
+    tracePanel->setMaximumWidth(550);
+    tracePanel->setStyleSheet("background-color:#333333; border-radius:10px; padding:5px; color:#ABB2BF;");
+
+    QHBoxLayout *traceLayout = new QHBoxLayout(tracePanel);
+    traceLayout->setSpacing(10);
+    traceLayout->setContentsMargins(10, 5, 10, 5);
+
+    QLabel *sizeLabel = new QLabel("N");
+    sizeSpinBox = new QSpinBox;
+    sizeSpinBox->setRange(Dataset::MinSize, Dataset::MaxSize);
+    sizeSpinBox->setValue(Dataset::MinSize);
+    sizeSpinBox->setToolTip("元素个数");
+
+    distributionCombo = new QComboBox;
+    for (int d = Dataset::Random; d <= Dataset::Zipfian; ++d)
+        distributionCombo->addItem(Dataset::distributionName(static_cast<Dataset::Distribution>(d)), d);
+    distributionCombo->setToolTip("输入分布");
+
+    QLabel *seedLabel = new QLabel("种子");
+    seedSpinBox = new QSpinBox;
+    seedSpinBox->setRange(0, INT_MAX);
+    seedSpinBox->setValue(1);
+    seedSpinBox->setToolTip("相同种子生成相同的数据集");
+
+    // 堆排序选项：叉数、建堆方式、下沉方式均为单选组，菜单结构与内省排序选项相同
+    heapOptionsButton = new QToolButton;
+    heapOptionsButton->setStyleSheet(buttonStyle + "QToolButton { color:#ABB2BF; font-weight:bold; }");
+    heapOptionsButton->setPopupMode(QToolButton::InstantPopup);
+    heapOptionsButton->setToolTip("堆的叉数（越宽层数越少，下沉时访问的孩子在内存中连续）、建堆与下沉方式");
+    heapOptionsButton->setVisible(false);
+    auto updateHeapText = [=]() {
+        heapOptionsButton->setText(HeapSort::arityName(heapOptions.arity) + " · "
+                                   + HeapSort::buildName(heapOptions.build) + " · "
+                                   + HeapSort::siftName(heapOptions.sift));
+    };
+
+    QMenu *heapMenu = new QMenu(heapOptionsButton);
+    QActionGroup *arityGroup = new QActionGroup(heapMenu);
+    for (int arity : {2, 4, 8}) {
+        QAction *action = heapMenu->addAction(HeapSort::arityName(arity));
+        action->setCheckable(true);
+        action->setChecked(arity == heapOptions.arity);
+        arityGroup->addAction(action);
+        connect(action, &QAction::triggered, [=]() {
+            heapOptions.arity = arity;
+            updateHeapText();
+        });
+    }
+    heapMenu->addSeparator();
+    QActionGroup *buildGroup = new QActionGroup(heapMenu);
+    for (int b = HeapSort::TopDown; b <= HeapSort::Floyd; ++b) {
+        QAction *action = heapMenu->addAction(HeapSort::buildName(static_cast<HeapSort::Build>(b)));
+        action->setCheckable(true);
+        action->setChecked(b == heapOptions.build);
+        buildGroup->addAction(action);
+        connect(action, &QAction::triggered, [=]() {
+            heapOptions.build = static_cast<HeapSort::Build>(b);
+            updateHeapText();
+        });
+    }
+    heapMenu->addSeparator();
+    QActionGroup *siftGroup = new QActionGroup(heapMenu);
+    for (int s = HeapSort::Standard; s <= HeapSort::BottomUp; ++s) {
+        QAction *action = heapMenu->addAction(HeapSort::siftName(static_cast<HeapSort::Sift>(s)));
+        action->setCheckable(true);
+        action->setChecked(s == heapOptions.sift);
+        siftGroup->addAction(action);
+        connect(action, &QAction::triggered, [=]() {
+            heapOptions.sift = static_cast<HeapSort::Sift>(s);
+            updateHeapText();
+        });
+    }
+    heapOptionsButton->setMenu(heapMenu);
+    updateHeapText();
+
+    radixBitsSpinBox = new QSpinBox;
+    radixBitsSpinBox->setRange(RadixSort::MinBits, RadixSort::MaxBits);
+    radixBitsSpinBox->setValue(8);
+    radixBitsSpinBox->setPrefix("2^");
+    radixBitsSpinBox->setToolTip("基数排序的基数（每趟处理的位数）");
+    radixBitsSpinBox->setVisible(false);
+
+    // 内省排序选项：划分方式、主元选取为单选组，pdq 模式可叠加
+    introOptionsButton = new QToolButton;
+    introOptionsButton->setStyleSheet(buttonStyle + "QToolButton { color:#ABB2BF; font-weight:bold; }");
+    introOptionsButton->setPopupMode(QToolButton::InstantPopup);
+    introOptionsButton->setToolTip("划分方式与主元选取");
+    introOptionsButton->setVisible(false);
+    auto updateIntroText = [=]() {
+        introOptionsButton->setText(IntroSort::partitionName(introOptions.partition) + " · "
+                                    + IntroSort::pivotName(introOptions.pivot)
+                                    + (introOptions.patternDefeating ? " · pdq" : ""));
+    };
+
+    QMenu *introMenu = new QMenu(introOptionsButton);
+    QActionGroup *partitionGroup = new QActionGroup(introMenu);
+    for (int p = IntroSort::Lomuto; p <= IntroSort::ThreeWay; ++p) {
+        QAction *action = introMenu->addAction(IntroSort::partitionName(static_cast<IntroSort::Partition>(p)));
+        action->setCheckable(true);
+        action->setChecked(p == introOptions.partition);
+        partitionGroup->addAction(action);
+        connect(action, &QAction::triggered, [=]() {
+            introOptions.partition = static_cast<IntroSort::Partition>(p);
+            updateIntroText();
+        });
+    }
+    introMenu->addSeparator();
+    QActionGroup *pivotGroup = new QActionGroup(introMenu);
+    for (int p = IntroSort::First; p <= IntroSort::Ninther; ++p) {
+        QAction *action = introMenu->addAction(IntroSort::pivotName(static_cast<IntroSort::PivotRule>(p)));
+        action->setCheckable(true);
+        action->setChecked(p == introOptions.pivot);
+        pivotGroup->addAction(action);
+        connect(action, &QAction::triggered, [=]() {
+            introOptions.pivot = static_cast<IntroSort::PivotRule>(p);
+            updateIntroText();
+        });
+    }
+    introMenu->addSeparator();
+    QAction *pdqAction = introMenu->addAction("pdq 模式（只对不平衡划分计数并打乱模式）");
+    pdqAction->setCheckable(true);
+    connect(pdqAction, &QAction::toggled, [=](bool checked) {
+        introOptions.patternDefeating = checked;
+        updateIntroText();
+    });
+    introOptionsButton->setMenu(introMenu);
+    updateIntroText();
+
+    workersSpinBox = new QSpinBox;
+    workersSpinBox->setRange(1, ParallelSort::MaxWorkers);
+    workersSpinBox->setValue(qMin(4, WorkStealingPool::maxWorkers()));
+    workersSpinBox->setPrefix("线程 ");
+    workersSpinBox->setToolTip(QString("并行排序的工作者个数（本机硬件线程 %1）").arg(WorkStealingPool::maxWorkers()));
+    workersSpinBox->setVisible(false);
+
+    loadDatasetButton = new QToolButton;
+    loadDatasetButton->setText("载入");
+    loadDatasetButton->setStyleSheet(buttonStyle + "QToolButton { color:#ABB2BF; font-weight:bold; }");
+    loadDatasetButton->setToolTip("从 CSV 或 int32 二进制文件载入数据集");
+
+    nativeRunButton = new QToolButton;
+    nativeRunButton->setText("原生运行");
+    nativeRunButton->setStyleSheet(buttonStyle + "QToolButton { color:#ABB2BF; font-weight:bold; }");
+    nativeRunButton->setToolTip("在程序内直接生成排序轨迹并播放");
+    nativeRunButton->setEnabled(false);
+
+    benchmarkButton = new QToolButton;
+    benchmarkButton->setText("规模测试");
+    benchmarkButton->setStyleSheet(buttonStyle + "QToolButton { color:#ABB2BF; font-weight:bold; }");
+    benchmarkButton->setToolTip("以几何增长的规模计时，估计经验复杂度");
+
+    speedupButton = new QToolButton;
+    speedupButton->setText("加速比");
+    speedupButton->setStyleSheet(buttonStyle + "QToolButton { color:#ABB2BF; font-weight:bold; }");
+    speedupButton->setToolTip("在当前数据集（不截断）上以 1…P 个工作者计时");
+    speedupButton->setVisible(false);
+
+    layoutBenchmarkButton = new QToolButton;
+    layoutBenchmarkButton->setText("布局测试");
+    layoutBenchmarkButton->setStyleSheet(buttonStyle + "QToolButton { color:#ABB2BF; font-weight:bold; }");
+    layoutBenchmarkButton->setToolTip("在 1 KB 到 1 GB 的数组上比较三种布局的随机查找耗时");
+    layoutBenchmarkButton->setVisible(false);
+
+    // 可视化只提供结点能完整显示的小阶数；更大的阶数见阶数测试
+    btreeDegreeCombo = new QComboBox;
+    for (int degree : AnyBTree::supportedDegrees()) {
+        if (degree > 8) break;
+        btreeDegreeCombo->addItem(QString("t = %1").arg(degree), degree);
+    }
+    btreeDegreeCombo->setToolTip("B 树的最小度数 t：每个结点 t - 1 … 2t - 1 个关键字（根除外），下次运行时生效");
+    btreeDegreeCombo->setVisible(false);
+
+    btreeOrderButton = new QToolButton;
+    btreeOrderButton->setText("阶数测试");
+    btreeOrderButton->setStyleSheet(buttonStyle + "QToolButton { color:#ABB2BF; font-weight:bold; }");
+    btreeOrderButton->setToolTip("在随机键上比较 t = 2 … 256 的 B 树插入与查找耗时");
+    btreeOrderButton->setVisible(false);
+
+    btreeFillSpinBox = new QSpinBox;
+    btreeFillSpinBox->setRange(50, 100);
+    btreeFillSpinBox->setValue(100);
+    btreeFillSpinBox->setSuffix("%");
+    btreeFillSpinBox->setToolTip("批量构建时每个结点装填 2t - 1 个关键字的比例（不少于 t - 1 个）；留出空位可减少之后插入的分裂");
+    btreeFillSpinBox->setVisible(false);
+
+    btreeBulkButton = new QToolButton;
+    btreeBulkButton->setText("批量构建");
+    btreeBulkButton->setStyleSheet(buttonStyle + "QToolButton { color:#ABB2BF; font-weight:bold; }");
+    btreeBulkButton->setToolTip(QString("将当前数据集排序后自底向上逐层构建 B 树，并与逐个插入比较耗时；不超过 %1 个键时逐层显示构建过程")
+                                .arg(VisualBTree::MaxBulkKeys));
+    btreeBulkButton->setVisible(false);
+
+    bstBuildCombo = new QComboBox;
+    bstBuildCombo->addItem("逐个插入", BSTInsert);
+    bstBuildCombo->addItem("平衡保护插入", BSTGuardedInsert);
+    bstBuildCombo->addItem("有序构建", BSTBalancedBuild);
+    bstBuildCombo->setToolTip("由数据集构建二叉排序树的方式：有序数据逐个插入会退化为单链，平衡保护与有序构建使树高保持 O(log n)");
+    bstBuildCombo->setVisible(false);
+
+    bstBuildButton = new QToolButton;
+    bstBuildButton->setText("数据集构建");
+    bstBuildButton->setStyleSheet(buttonStyle + "QToolButton { color:#ABB2BF; font-weight:bold; }");
+    bstBuildButton->setToolTip(QString("由当前数据集（至多 %1 个元素）构建二叉排序树并绘制").arg(VisualTree::MaxNodes));
+    bstBuildButton->setVisible(false);
+
+    searchBatchButton = new QToolButton;
+    searchBatchButton->setText("批量查询");
+    searchBatchButton->setStyleSheet(buttonStyle + "QToolButton { color:#ABB2BF; font-weight:bold; }");
+    searchBatchButton->setToolTip(QString("在当前数据集（不截断）上执行 %1 次查询，比较四种查找的平均探查次数").arg(Search::BatchQueries));
+    searchBatchButton->setVisible(false);
+
+    traceLayout->addWidget(sizeLabel);
+    traceLayout->addWidget(sizeSpinBox);
+    traceLayout->addWidget(distributionCombo);
+    traceLayout->addWidget(seedLabel);
+    traceLayout->addWidget(seedSpinBox);
+    traceLayout->addWidget(heapOptionsButton);
+    traceLayout->addWidget(radixBitsSpinBox);
+    traceLayout->addWidget(introOptionsButton);
+    traceLayout->addWidget(workersSpinBox);
+    traceLayout->addWidget(btreeDegreeCombo);
+    traceLayout->addWidget(btreeFillSpinBox);
+    traceLayout->addWidget(bstBuildCombo);
+    traceLayout->addWidget(loadDatasetButton);
+    traceLayout->addStretch();
+    traceLayout->addWidget(nativeRunButton);
+    traceLayout->addWidget(benchmarkButton);
+    traceLayout->addWidget(speedupButton);
+    traceLayout->addWidget(layoutBenchmarkButton);
+    traceLayout->addWidget(searchBatchButton);
+    traceLayout->addWidget(btreeOrderButton);
+    traceLayout->addWidget(btreeBulkButton);
+    traceLayout->addWidget(bstBuildButton);
+
+    tracePlayer = new TracePlayer(this);
+    nativeTraceActive = false;
+    bulkThread = nullptr;
+    bulkWorker = nullptr;
+    btree = nullptr;
+    visualbtree = nullptr;
+    connect(tracePlayer, &TracePlayer::eventReady, [=](const TraceEvent& event, bool verbose) {
+        if (verbose)
+            logArea->appendPlainText(event.toString());
+        applyTraceEvent(event);
+    });
+    connect(tracePlayer, &TracePlayer::finished, [=]() {
+        logArea->appendPlainText(QString(" 原生轨迹播放完毕，共 %1 个事件。").arg(tracePlayer->size()));
+        stopNativeTrace();
+    });
+
     // 右侧代码区域布局
     codeLayout->addWidget(controlPanel);
+    codeLayout->addWidget(tracePanel);
     codeLayout->addWidget(codeArea);
     codeLayout->setStretchFactor(codeArea, 3);
     codeLayout->setStretchFactor(controlPanel, 1);
+    codeLayout->setStretchFactor(tracePanel, 1);
 }
 
 void Widget::setupLayout()
@@ -341,6 +615,7 @@ void Widget::onTreeItemClicked(QTreeWidgetItem *item, int column)
 {
     if (item->childCount() > 0) return; // 父目录不执行任何操作
 
+    stopNativeTrace();
     visualAreaView->resetTransform();
     visualAreaScene->clear();
     logArea->clear();
@@ -369,11 +644,20 @@ void Widget::onTreeItemClicked(QTreeWidgetItem *item, int column)
         {"Dijkstra", ":/codes/dijkstra.c"},
         {"Floyd", ":/codes/floyd.c"},
         {"折半查找", ":/codes/binarysearch.c"},
+        {"插值查找", ":/codes/interpolationsearch.c"},
+        {"指数查找", ":/codes/exponentialsearch.c"},
+        {"斐波那契查找", ":/codes/fibonaccisearch.c"},
+        {"缓存友好查找", ":/codes/layoutsearch.c"},
         {"B树", ":/codes/btree.c"},
         {"冒泡排序", ":/codes/bubblesort.c"},
         {"快速排序", ":/codes/quicksort.c"},
+        {"内省排序", ":/codes/introsort.c"},
         {"堆排序", ":/codes/heapsort.c"},
-        {"桶排序", ":/codes/bucketsort.c"}
+        {"桶排序", ":/codes/bucketsort.c"},
+        {"LSD基数排序", ":/codes/lsdradixsort.c"},
+        {"MSD基数排序", ":/codes/msdradixsort.c"},
+        {"并行归并排序", ":/codes/parallelmergesort.c"},
+        {"并行样本排序", ":/codes/samplesort.c"}
     };
 
     // 检查是否存在对应的 .c 资源文件
@@ -395,6 +679,26 @@ void Widget::onTreeItemClicked(QTreeWidgetItem *item, int column)
         // 加载到 codeArea
         codeArea->setPlainText(codeContent);
         highlighter = new CHighlighter(codeArea->document());
+
+        // 排序与折半查找支持原生运行
+        SortTrace::Algorithm algorithm;
+        bool native = SortTrace::algorithmForFile(filePath, &algorithm);
+        nativeRunButton->setEnabled(native);
+        heapOptionsButton->setVisible(native && algorithm == SortTrace::Heap);
+        radixBitsSpinBox->setVisible(native && (algorithm == SortTrace::RadixLSD || algorithm == SortTrace::RadixMSD));
+        introOptionsButton->setVisible(native && algorithm == SortTrace::Intro);
+        bool parallel = native && (algorithm == SortTrace::ParallelMerge || algorithm == SortTrace::SampleSort);
+        workersSpinBox->setVisible(parallel);
+        speedupButton->setVisible(parallel);
+        layoutBenchmarkButton->setVisible(native && algorithm == SortTrace::LayoutSearch);
+        searchBatchButton->setVisible(native && SortTrace::isSearch(algorithm));
+        btreeDegreeCombo->setVisible(filePath == ":/codes/btree.c");
+        btreeOrderButton->setVisible(filePath == ":/codes/btree.c");
+        btreeFillSpinBox->setVisible(filePath == ":/codes/btree.c");
+        btreeBulkButton->setVisible(filePath == ":/codes/btree.c");
+        bool bst = filePath == ":/codes/prebinarytree.c" || filePath == ":/codes/inbinarytree.c" || filePath == ":/codes/postbinarytree.c";
+        bstBuildCombo->setVisible(bst);
+        bstBuildButton->setVisible(bst);
     } else {
         QMessageBox::warning(this, "提示", "没有找到对应的代码文件");
     }
@@ -420,9 +724,35 @@ void Widget::compileCode()
     out << code;
     file.close();
 
+    // 轨迹开关头文件：两个版本都强制包含。TRACE 是唯一在基准版本中被编译掉的宏，
+    // 自带示例的事件输出都经由它；printf 等标准库函数不做重定义，照常输出
+    QString tracePath = QDir::currentPath() + "/visual_trace.h";
+    QFile traceFile(tracePath);
+    if (!traceFile.open(QIODevice::WriteOnly | QIODevice::Text)) {
+        logArea->appendPlainText(" 无法保存 visual_trace.h！");
+        return;
+    }
+    QTextStream traceOut(&traceFile);
+    traceOut << "#ifndef VISUAL_TRACE_H\n"
+                "#define VISUAL_TRACE_H\n"
+                "#include <stdio.h>\n"
+                "/* 轨迹事件请用 TRACE(...) 输出：调试版本中等同 printf，基准版本（VISUAL_BENCH）中整条编译掉，\n"
+                "   参数不求值但仍做格式检查；直接调用的 printf / puts 等在两个版本中都照常输出 */\n"
+                "#ifdef VISUAL_BENCH\n"
+                "#define TRACE(...) ((void)(0 && printf(__VA_ARGS__)))\n"
+                "#else\n"
+                "#define TRACE(...) printf(__VA_ARGS__)\n"
+                "#endif\n"
+                "#endif\n";
+    traceFile.close();
+
+    // 旧的基准版本与当前代码不一致，先删除
+    QFile::remove("temp_code_bench.exe");
+
     // 生成输出文件 `temp_code.exe`
     QString outputFile = "temp_code.exe";
-    QString compileCommand = QString("gcc \"%1\" -o \"%2\" -g -Wall -Wextra -std=c99").arg(filePath, outputFile);
+    QString compileCommand = QString("gcc \"%1\" -o \"%2\" -g -Wall -Wextra -std=c99 -pthread -include \"%3\"")
+                                 .arg(filePath, outputFile, tracePath);
 
     // 创建编译进程
     compilerProcess = new QProcess(this);
@@ -436,6 +766,7 @@ void Widget::compileCode()
             [=](int exitCode, QProcess::ExitStatus status) {
                 if (status == QProcess::NormalExit && exitCode == 0) {
                     logArea->appendPlainText(" 编译成功！");
+                    compileBenchmarkBuild(filePath);
                 } else {
                     logArea->appendPlainText(" 编译失败，请检查错误！");
                 }
@@ -446,6 +777,29 @@ void Widget::compileCode()
     compilerProcess->start(compileCommand);
 }
 
+void Widget::compileBenchmarkBuild(const QString &sourcePath)
+{
+    // 与调试版本同源，开启优化并去掉轨迹输出，供规模测试计时
+    QString tracePath = QDir::currentPath() + "/visual_trace.h";
+    QString compileCommand = QString("gcc \"%1\" -o \"%2\" -O2 -march=native -std=c99 -pthread -DVISUAL_BENCH -include \"%3\"")
+                                 .arg(sourcePath, "temp_code_bench.exe", tracePath);
+
+    QProcess *benchProcess = new QProcess(this);
+    benchProcess->setProcessChannelMode(QProcess::MergedChannels);
+    connect(benchProcess, QOverload<int, QProcess::ExitStatus>::of(&QProcess::finished),
+            [=](int exitCode, QProcess::ExitStatus status) {
+                if (status == QProcess::NormalExit && exitCode == 0) {
+                    logArea->appendPlainText(" 基准版本编译成功（-O2 -march=native）。");
+                } else {
+                    // 调试版本不受影响，只是规模测试无法使用外部程序
+                    logArea->appendPlainText(" 基准版本编译失败：");
+                    logArea->appendPlainText(benchProcess->readAll());
+                }
+                benchProcess->deleteLater();
+    });
+    benchProcess->start(compileCommand);
+}
+
 void Widget::startGDBProcess()
 {
     // 初始化gdb进程
@@ -518,6 +872,7 @@ void Widget::onRunPauseButtonClicked()
         // 启动 GDB 或继续执行
         if (gdbProcess->state() != QProcess::Running) {
 
+            stopNativeTrace();
             visualAreaView->resetTransform();
             visualAreaScene->clear();
 
@@ -635,7 +990,7 @@ void Widget::doVisualWork(QString output)
             logArea->appendPlainText(match.captured(0));
 
             int value = match.captured(1).toInt();
-            avlTree->remove(value);
+            avlTree->erase(value);
             visualTree->rebuild(avlTree->getRoot());
         }
     }
@@ -794,6 +1149,7 @@ void Widget::doVisualWork(QString output)
         else if ((match = traverseRegex.match(output)).hasMatch()) {
             int src = match.captured(1).toInt();
             int dest = match.captured(2).toInt();
+            OpCounter::add(OpCounter::Relaxations);
             visualgraph->Dj_highlightEdge(src, dest);
             logArea->appendPlainText(match.captured(0));
         }
@@ -843,6 +1199,7 @@ void Widget::doVisualWork(QString output)
 
            distanceMatrix[src][dest] = newDist;
            distanceMatrix[dest][src] = newDist;
+           OpCounter::add(OpCounter::Relaxations);
            visualgraph->updateDistanceMatrix(src, dest, newDist);
 
            logArea->appendPlainText(
@@ -874,40 +1231,68 @@ void Widget::doVisualWork(QString output)
             int value = match.captured(1).toInt();
             logArea->appendPlainText(match.captured(0));
 
-            BTreeNode* result = btree->search(value);
-            if (result) {
+            if (btree->contains(value)) {
                 visualbtree->highlightNode(value);
             } else {
                 logArea->appendPlainText(QString("CAN NOT FIND %1").arg(value));
             }
         }
     }
-    else if (filePath == ":/codes/binarysearch.c") {
-
-
+    else if (filePath == ":/codes/binarysearch.c" || filePath == ":/codes/interpolationsearch.c"
+             || filePath == ":/codes/exponentialsearch.c" || filePath == ":/codes/fibonaccisearch.c") {
         QRegularExpression insertRegex(R"(INSERT (\d+))");
         QRegularExpression rangeCheckRegex(R"(RANGE (\d+) (\d+) (\d+))");
         QRegularExpression foundRegex(R"(FOUND_INDEX (\d+))");
         QRegularExpression notFoundRegex(R"(NOT_FOUND (\d+))");
 
         QRegularExpressionMatch match;
-        if ((match = insertRegex.match(output)).hasMatch()) {
-            int value = match.captured(1).toInt();
-            visualbinarysearch->insertValue(value);
-            logArea->appendPlainText(match.captured(0));
-        } else if ((match = rangeCheckRegex.match(output)).hasMatch()) {
-            int l = match.captured(1).toInt();
-            int r = match.captured(2).toInt();
-            int mid = match.captured(3).toInt();
-            visualbinarysearch->highlightCheck(l, r, mid);
-            logArea->appendPlainText(match.captured(0));
-        } else if ((match = foundRegex.match(output)).hasMatch()) {
-            int index = match.captured(1).toInt();
-            visualbinarysearch->highlightFound(index);
-            logArea->appendPlainText(match.captured(0));
-        } else if ((match = notFoundRegex.match(output)).hasMatch()) {
-            logArea->appendPlainText(match.captured(0));
-        }
+        TraceEvent event{TraceEvent::Insert, 0, 0, 0};
+
+        if ((match = insertRegex.match(output)).hasMatch())
+            event.op = TraceEvent::Insert;
+        else if ((match = rangeCheckRegex.match(output)).hasMatch())
+            event.op = TraceEvent::Range;
+        else if ((match = foundRegex.match(output)).hasMatch())
+            event.op = TraceEvent::FoundIndex;
+        else if ((match = notFoundRegex.match(output)).hasMatch())
+            event.op = TraceEvent::NotFound;
+        else
+            return;
+
+        event.a = match.captured(1).toInt();
+        event.b = match.captured(2).toInt();
+        event.c = match.captured(3).toInt();
+        applyTraceEvent(event);
+        logArea->appendPlainText(match.captured(0));
+    }
+    else if (filePath == ":/codes/layoutsearch.c") {
+        QRegularExpression insertRegex(R"(INSERT (-?\d+))");
+        QRegularExpression queryRegex(R"(LAYOUT_QUERY (-?\d+))");
+        QRegularExpression probeRegex(R"(LAYOUT_PROBE (\d+) (\d+))");
+        QRegularExpression resultRegex(R"(LAYOUT_RESULT (\d+) (-?\d+) (-?\d+))");
+        QRegularExpression finishRegex(R"(SORT_FINISHED)");
+
+        QRegularExpressionMatch match;
+        TraceEvent event{TraceEvent::Insert, 0, 0, 0};
+
+        if ((match = insertRegex.match(output)).hasMatch())
+            event.op = TraceEvent::Insert;
+        else if ((match = queryRegex.match(output)).hasMatch())
+            event.op = TraceEvent::LayoutQuery;
+        else if ((match = probeRegex.match(output)).hasMatch())
+            event.op = TraceEvent::LayoutProbe;
+        else if ((match = resultRegex.match(output)).hasMatch())
+            event.op = TraceEvent::LayoutResult;
+        else if ((match = finishRegex.match(output)).hasMatch())
+            event.op = TraceEvent::SortFinished;
+        else
+            return;
+
+        event.a = match.captured(1).toInt();
+        event.b = match.captured(2).toInt();
+        event.c = match.captured(3).toInt();
+        logArea->appendPlainText(match.captured(0));
+        applyTraceEvent(event);
     }
     else if (filePath == ":/codes/bubblesort.c") {
         QRegularExpression insertRegex(R"(INSERT (\d+))");
@@ -916,142 +1301,663 @@ void Widget::doVisualWork(QString output)
         QRegularExpression markRegex(R"(MARK_SORTED (\d+))");
 
         QRegularExpressionMatch match;
+        TraceEvent event{TraceEvent::Insert, 0, 0, 0};
+
+        if ((match = insertRegex.match(output)).hasMatch())
+            event.op = TraceEvent::Insert;
+        else if ((match = compareRegex.match(output)).hasMatch())
+            event.op = TraceEvent::Compare;
+        else if ((match = swapRegex.match(output)).hasMatch())
+            event.op = TraceEvent::Swap;
+        else if ((match = markRegex.match(output)).hasMatch())
+            event.op = TraceEvent::MarkSorted;
+        else
+            return;
 
-        if ((match = insertRegex.match(output)).hasMatch()) {
-            int value = match.captured(1).toInt();
-            logArea->appendPlainText(match.captured(0));
-            visualbubblesort->insertValue(value);
-        }
-        else if ((match = compareRegex.match(output)).hasMatch()) {
-            int i = match.captured(1).toInt();
-            int j = match.captured(2).toInt();
-            logArea->appendPlainText(match.captured(0));
-            visualbubblesort->compare(i, j);
-        }
-        else if ((match = swapRegex.match(output)).hasMatch()) {
-            int i = match.captured(1).toInt();
-            int j = match.captured(2).toInt();
-            logArea->appendPlainText(match.captured(0));
-            visualbubblesort->swap(i, j);
-        }
-        else if ((match = markRegex.match(output)).hasMatch()) {
-            int index = match.captured(1).toInt();
-            logArea->appendPlainText(match.captured(0));
-            visualbubblesort->markSorted(index);
-        }
+        event.a = match.captured(1).toInt();
+        event.b = match.captured(2).toInt();
+        logArea->appendPlainText(match.captured(0));
+        applyTraceEvent(event);
     }
-    else if (filePath == ":/codes/quicksort.c") {
+    else if (filePath == ":/codes/quicksort.c" || filePath == ":/codes/introsort.c") {
         QRegularExpression insertRegex(R"(INSERT (\d+))");
         QRegularExpression pivotRegex(R"(PIVOT (\d+) (\d+))");
         QRegularExpression compareARegex(R"(COMPARE_A (\d+) (\d+))");
         QRegularExpression compareBRegex(R"(COMPARE_B (\d+) (\d+))");
+        QRegularExpression compareRegex(R"(COMPARE (\d+) (\d+))");
         QRegularExpression swapRegex(R"(SWAP (\d+) (\d+))");
         QRegularExpression markSortedRegex(R"(MARK_SORTED (\d+))");
+        QRegularExpression fallbackRegex(R"(HEAP_FALLBACK (\d+) (\d+))");
 
         QRegularExpressionMatch match;
+        TraceEvent event{TraceEvent::Insert, 0, 0, 0};
+
+        if ((match = insertRegex.match(output)).hasMatch())
+            event.op = TraceEvent::Insert;
+        else if ((match = pivotRegex.match(output)).hasMatch())
+            event.op = TraceEvent::Pivot;
+        else if ((match = compareARegex.match(output)).hasMatch())
+            event.op = TraceEvent::CompareA;
+        else if ((match = compareBRegex.match(output)).hasMatch())
+            event.op = TraceEvent::CompareB;
+        else if ((match = compareRegex.match(output)).hasMatch())
+            event.op = TraceEvent::Compare;
+        else if ((match = swapRegex.match(output)).hasMatch())
+            event.op = TraceEvent::Swap;
+        else if ((match = markSortedRegex.match(output)).hasMatch())
+            event.op = TraceEvent::MarkSorted;
+        else if ((match = fallbackRegex.match(output)).hasMatch())
+            event.op = TraceEvent::HeapFallback;
+        else
+            return;
 
-        if ((match = insertRegex.match(output)).hasMatch()) {
-            int value = match.captured(1).toInt();
-            visualquicksort->insertValue(value);
-            logArea->appendPlainText(match.captured(0));
-        }
-        else if ((match = pivotRegex.match(output)).hasMatch()) {
-            int index = match.captured(1).toInt();
-            visualquicksort->setPivot(index);
-            logArea->appendPlainText(match.captured(0));
-        }
-        else if ((match = compareARegex.match(output)).hasMatch()) {
-            int index = match.captured(1).toInt();
-            int pivotVal = match.captured(2).toInt();
-            visualquicksort->compareA(index, pivotVal);
-            logArea->appendPlainText(match.captured(0));
-        }
-        else if ((match = compareBRegex.match(output)).hasMatch()) {
-            int index = match.captured(1).toInt();
-            int pivotVal = match.captured(2).toInt();
-            visualquicksort->compareB(index, pivotVal);
-            logArea->appendPlainText(match.captured(0));
-        }
-        else if ((match = swapRegex.match(output)).hasMatch()) {
-            int i = match.captured(1).toInt();
-            int j = match.captured(2).toInt();
-            visualquicksort->swap(i, j);
-            logArea->appendPlainText(match.captured(0));
-        }
-        else if ((match = markSortedRegex.match(output)).hasMatch()) {
-            int index = match.captured(1).toInt();
-            visualquicksort->markSorted(index);
-            logArea->appendPlainText(match.captured(0));
-        }
+        event.a = match.captured(1).toInt();
+        event.b = match.captured(2).toInt();
+        applyTraceEvent(event);
+        logArea->appendPlainText(match.captured(0));
     }
     else if (filePath == ":/codes/heapsort.c") {
         QRegularExpression insertRegex(R"(INSERT (\d+))");
         QRegularExpression swapRegex(R"(SWAP (\d+) (\d+))");
         QRegularExpression extractRegex(R"(EXTRACT_MAX (\d+))");
+        QRegularExpression heapifyRegex(R"(HEAPIFY (\d+) (\d+))");
+        QRegularExpression siftUpRegex(R"(SIFT_UP (\d+))");
+        QRegularExpression siftDownRegex(R"(SIFT_DOWN (\d+) (\d+))");
+        QRegularExpression compareRegex(R"(COMPARE (\d+) (\d+))");
         QRegularExpression finishRegex(R"(SORT_FINISHED)");
 
         QRegularExpressionMatch match;
         if ((match = insertRegex.match(output)).hasMatch()) {
-            int value = match.captured(1).toInt();
-            visualheap->insert(value);
+            applyTraceEvent(TraceEvent{TraceEvent::Insert, match.captured(1).toInt(), 0, 0});
             logArea->appendPlainText(match.captured(0));
         }
+        else if ((match = heapifyRegex.match(output)).hasMatch()) {
+            applyTraceEvent(TraceEvent{TraceEvent::Heapify, match.captured(1).toInt(), match.captured(2).toInt(), 0});
+            logArea->appendPlainText(match.captured(0));
+        }
+        else if ((match = siftUpRegex.match(output)).hasMatch()) {
+            applyTraceEvent(TraceEvent{TraceEvent::SiftUp, match.captured(1).toInt(), 0, 0});
+        }
+        else if ((match = siftDownRegex.match(output)).hasMatch()) {
+            applyTraceEvent(TraceEvent{TraceEvent::SiftDown, match.captured(1).toInt(), match.captured(2).toInt(), 0});
+        }
+        else if ((match = compareRegex.match(output)).hasMatch()) {
+            applyTraceEvent(TraceEvent{TraceEvent::Compare, match.captured(1).toInt(), match.captured(2).toInt(), 0});
+        }
         else if ((match = swapRegex.match(output)).hasMatch()) {
-            visualheap->swap(match.captured(1).toInt(), match.captured(2).toInt());
+            applyTraceEvent(TraceEvent{TraceEvent::Swap, match.captured(1).toInt(), match.captured(2).toInt(), 0});
         }
         else if ((match = extractRegex.match(output)).hasMatch()) {
-            int last_idx = match.captured(1).toInt();
-            visualheap->extractMax(last_idx);
+            applyTraceEvent(TraceEvent{TraceEvent::ExtractMax, match.captured(1).toInt(), 0, 0});
             logArea->appendPlainText(match.captured(0));
-        }else if((match = finishRegex.match(output)).hasMatch())
-        {
-            QStringList values;
-            for (auto* node : visualheap->m_nodes)
-                values << QString::number(node->value);
-            logArea->appendPlainText("Final Heap: [" + values.join(", ") + "]");
         }
+        else if ((match = finishRegex.match(output)).hasMatch()) {
+            applyTraceEvent(TraceEvent{TraceEvent::SortFinished, 0, 0, 0});
+        }
+    }
+    else if (filePath == ":/codes/lsdradixsort.c" || filePath == ":/codes/msdradixsort.c") {
+        QRegularExpression insertRegex(R"(INSERT (-?\d+))");
+        QRegularExpression rangeRegex(R"(RADIX_RANGE (\d+) (\d+))");
+        QRegularExpression passRegex(R"(RADIX_PASS (\d+) (\d+))");
+        QRegularExpression countRegex(R"(RADIX_COUNT (\d+) (\d+))");
+        QRegularExpression prefixRegex(R"(RADIX_PREFIX)");
+        QRegularExpression scatterRegex(R"(RADIX_SCATTER (\d+) (\d+) (\d+))");
+        QRegularExpression doneRegex(R"(RADIX_DONE)");
+        QRegularExpression finishRegex(R"(SORT_FINISHED)");
+
+        QRegularExpressionMatch match;
+        TraceEvent event{TraceEvent::Insert, 0, 0, 0};
+
+        if ((match = insertRegex.match(output)).hasMatch())
+            event.op = TraceEvent::Insert;
+        else if ((match = rangeRegex.match(output)).hasMatch())
+            event.op = TraceEvent::RadixRange;
+        else if ((match = passRegex.match(output)).hasMatch())
+            event.op = TraceEvent::RadixPass;
+        else if ((match = countRegex.match(output)).hasMatch())
+            event.op = TraceEvent::RadixCount;
+        else if ((match = prefixRegex.match(output)).hasMatch())
+            event.op = TraceEvent::RadixPrefix;
+        else if ((match = scatterRegex.match(output)).hasMatch())
+            event.op = TraceEvent::RadixScatter;
+        else if ((match = doneRegex.match(output)).hasMatch())
+            event.op = TraceEvent::RadixDone;
+        else if ((match = finishRegex.match(output)).hasMatch())
+            event.op = TraceEvent::SortFinished;
+        else
+            return;
+
+        event.a = match.captured(1).toInt();
+        event.b = match.captured(2).toInt();
+        event.c = match.captured(3).toInt();
+        logArea->appendPlainText(match.captured(0));
+        applyTraceEvent(event);
+    }
+    else if (filePath == ":/codes/parallelmergesort.c" || filePath == ":/codes/samplesort.c") {
+        QRegularExpression insertRegex(R"(INSERT (-?\d+))");
+        QRegularExpression initRegex(R"(PAR_INIT (\d+) (\d+))");
+        QRegularExpression taskRegex(R"(PAR_TASK (\d+) (\d+) (\d+))");
+        QRegularExpression idleRegex(R"(PAR_IDLE (\d+))");
+        QRegularExpression writeRegex(R"(PAR_WRITE (\d+) (-?\d+) (\d+))");
+        QRegularExpression finishRegex(R"(SORT_FINISHED)");
+
+        QRegularExpressionMatch match;
+        TraceEvent event{TraceEvent::Insert, 0, 0, 0};
+
+        if ((match = insertRegex.match(output)).hasMatch())
+            event.op = TraceEvent::Insert;
+        else if ((match = initRegex.match(output)).hasMatch())
+            event.op = TraceEvent::ParallelInit;
+        else if ((match = taskRegex.match(output)).hasMatch())
+            event.op = TraceEvent::ParallelTask;
+        else if ((match = idleRegex.match(output)).hasMatch())
+            event.op = TraceEvent::ParallelIdle;
+        else if ((match = writeRegex.match(output)).hasMatch())
+            event.op = TraceEvent::ParallelWrite;
+        else if ((match = finishRegex.match(output)).hasMatch())
+            event.op = TraceEvent::SortFinished;
+        else
+            return;
+
+        event.a = match.captured(1).toInt();
+        event.b = match.captured(2).toInt();
+        event.c = match.captured(3).toInt();
+        logArea->appendPlainText(match.captured(0));
+        applyTraceEvent(event);
     }
     else if (filePath == ":/codes/bucketsort.c") {
         QRegularExpression insertRegex(R"(INSERT (\d+))");
+        QRegularExpression initRegex(R"(BUCKET_INIT (\d+))");
+        QRegularExpression rangeRegex(R"(BUCKET_RANGE (\d+) (-?\d+) (-?\d+))");
         QRegularExpression assignRegex(R"(BUCKET_ASSIGN (\d+) (\d+))");
         QRegularExpression bucketSwapRegex(R"(SWAP (\d+) (\d+) (\d+))");
         QRegularExpression finalRegex(R"(FINAL_OUTPUT (\d+))");
 
         QRegularExpressionMatch match;
+        TraceEvent event{TraceEvent::Insert, 0, 0, 0};
+
+        if ((match = insertRegex.match(output)).hasMatch())
+            event.op = TraceEvent::Insert;
+        else if ((match = initRegex.match(output)).hasMatch())
+            event.op = TraceEvent::BucketInit;
+        else if ((match = rangeRegex.match(output)).hasMatch())
+            event.op = TraceEvent::BucketRange;
+        else if ((match = assignRegex.match(output)).hasMatch())
+            event.op = TraceEvent::BucketAssign;
+        else if ((match = finalRegex.match(output)).hasMatch())
+            event.op = TraceEvent::FinalOutput;
+        else if ((match = bucketSwapRegex.match(output)).hasMatch())
+            event.op = TraceEvent::BucketSwap;
+        else
+            return;
 
-        if ((match = insertRegex.match(output)).hasMatch()) {
-            int value = match.captured(1).toInt();
-            logArea->appendPlainText(match.captured(0));
-            visualbucketsort->insertValue(value);
-        }
-        else if ((match = assignRegex.match(output)).hasMatch()) {
-            int value = match.captured(1).toInt();
-            int bucket = match.captured(2).toInt();
-            logArea->appendPlainText(match.captured(0));
-            visualbucketsort->assignToBucket(value, bucket);
+        event.a = match.captured(1).toInt();
+        event.b = match.captured(2).toInt();
+        event.c = match.captured(3).toInt();
+        logArea->appendPlainText(match.captured(0));
+        applyTraceEvent(event);
+    }
+}
+
+void Widget::applyTraceEvent(const TraceEvent& event)
+{
+    SortTrace::Algorithm algorithm;
+    if (!SortTrace::algorithmForFile(filePath, &algorithm)) return;
+
+    switch (event.op) {
+    case TraceEvent::Compare:
+    case TraceEvent::CompareA:
+    case TraceEvent::CompareB:
+        OpCounter::add(OpCounter::Comparisons);
+        break;
+    case TraceEvent::Swap:
+    case TraceEvent::BucketSwap:
+    case TraceEvent::ExtractMax:
+        OpCounter::add(OpCounter::Swaps);
+        break;
+    default:
+        break;
+    }
+
+    // 内省排序复用快速排序的柱状图
+    const bool quick = algorithm == SortTrace::Quick || algorithm == SortTrace::Intro;
+
+    switch (event.op) {
+    case TraceEvent::Insert:
+        if (algorithm == SortTrace::Bubble)      visualbubblesort->insertValue(event.a);
+        else if (quick)                          visualquicksort->insertValue(event.a);
+        else if (algorithm == SortTrace::Heap)   visualheap->insert(event.a);
+        else if (algorithm == SortTrace::Bucket) visualbucketsort->insertValue(event.a);
+        else if (SortTrace::isSearch(algorithm)) visualbinarysearch->insertValue(event.a);
+        else if (algorithm == SortTrace::RadixLSD || algorithm == SortTrace::RadixMSD) visualradixsort->insertValue(event.a);
+        else if (algorithm == SortTrace::ParallelMerge || algorithm == SortTrace::SampleSort) visualparallelsort->insertValue(event.a);
+        else if (algorithm == SortTrace::LayoutSearch) visuallayoutsearch->insertValue(event.a);
+        break;
+    case TraceEvent::Compare:
+        if (algorithm == SortTrace::Bubble) visualbubblesort->compare(event.a, event.b);
+        else if (quick)                     visualquicksort->compare(event.a, event.b);
+        else if (algorithm == SortTrace::Heap) visualheap->compare(event.a, event.b);
+        break;
+    case TraceEvent::CompareA:
+        if (quick) visualquicksort->compareA(event.a, event.b);
+        break;
+    case TraceEvent::CompareB:
+        if (quick) visualquicksort->compareB(event.a, event.b);
+        break;
+    case TraceEvent::Pivot:
+        if (quick) visualquicksort->setPivot(event.a);
+        break;
+    case TraceEvent::Heapify:
+        if (algorithm == SortTrace::Heap) visualheap->heapify(event.a, event.b);
+        break;
+    case TraceEvent::SiftUp:
+        if (algorithm == SortTrace::Heap) visualheap->siftUp(event.a);
+        break;
+    case TraceEvent::SiftDown:
+        if (algorithm == SortTrace::Heap) visualheap->siftDown(event.a, event.b);
+        break;
+    case TraceEvent::HeapFallback:
+        logArea->appendPlainText(QString(" 递归深度超限，区间 [%1, %2] 改用堆排序。").arg(event.a).arg(event.b));
+        break;
+    case TraceEvent::Swap:
+        if (algorithm == SortTrace::Bubble)     visualbubblesort->swap(event.a, event.b);
+        else if (quick)                         visualquicksort->swap(event.a, event.b);
+        else if (algorithm == SortTrace::Heap)  visualheap->swap(event.a, event.b);
+        break;
+    case TraceEvent::MarkSorted:
+        if (algorithm == SortTrace::Bubble)     visualbubblesort->markSorted(event.a);
+        else if (quick)                         visualquicksort->markSorted(event.a);
+        break;
+    case TraceEvent::ExtractMax:
+        if (algorithm == SortTrace::Heap) visualheap->extractMax(event.a);
+        break;
+    case TraceEvent::SortFinished:
+        if (algorithm == SortTrace::RadixLSD || algorithm == SortTrace::RadixMSD)
+            visualradixsort->finish();
+        else if (algorithm == SortTrace::LayoutSearch) {
+            visuallayoutsearch->finish();
+            for (int k = 0; k < SearchLayout::KindCount; ++k)
+                logArea->appendPlainText(QString(" %1：%2 次查询平均触及 %3 条缓存行")
+                                         .arg(SearchLayout::kindName(static_cast<SearchLayout::Kind>(k)))
+                                         .arg(visuallayoutsearch->queryCount())
+                                         .arg(visuallayoutsearch->averageLines(k), 0, 'f', 2));
         }
-        else if ((match = finalRegex.match(output)).hasMatch()) {
-            int value = match.captured(1).toInt();
-            logArea->appendPlainText(match.captured(0));
-            visualbucketsort->markFinal(value);
+        else if (algorithm == SortTrace::ParallelMerge || algorithm == SortTrace::SampleSort) {
+            visualparallelsort->finish();
+            for (int w = 0; w < visualparallelsort->workerCount(); ++w)
+                logArea->appendPlainText(QString(" 工作者 %1：忙碌 %2%，窃取 %3 次")
+                                         .arg(w)
+                                         .arg(qRound(visualparallelsort->utilization(w) * 100))
+                                         .arg(visualparallelsort->stealCount(w)));
         }
-        else if ((match = bucketSwapRegex.match(output)).hasMatch()) {
-            int i = match.captured(1).toInt();
-            int j = match.captured(2).toInt();
-            int bucket = match.captured(3).toInt();
-            logArea->appendPlainText(match.captured(0));
-            visualbucketsort->swapInBucket(i, j, bucket);
+        else if (algorithm == SortTrace::Heap) {
+            QStringList values;
+            for (auto* node : visualheap->m_nodes)
+                values << QString::number(node->value);
+            logArea->appendPlainText("Final Heap: [" + values.join(", ") + "]");
+            visualheap->finish();
+            logArea->appendPlainText(QString(" 建堆：比较 %1 次，交换 %2 次；排序：比较 %3 次，交换 %4 次")
+                                     .arg(visualheap->comparisons(VisualHeap::Building))
+                                     .arg(visualheap->swaps(VisualHeap::Building))
+                                     .arg(visualheap->comparisons(VisualHeap::Sorting))
+                                     .arg(visualheap->swaps(VisualHeap::Sorting)));
+            if (visualheap->arity() != 2)
+                logArea->appendPlainText(QString(" %1：%2 层（同样元素的二叉堆为 %3 层）")
+                                         .arg(HeapSort::arityName(visualheap->arity()))
+                                         .arg(visualheap->levels())
+                                         .arg(HeapSort::levels(visualheap->m_nodes.size(), 2)));
         }
+        break;
+    case TraceEvent::BucketInit:
+        if (algorithm == SortTrace::Bucket) visualbucketsort->initBuckets(event.a);
+        break;
+    case TraceEvent::BucketRange:
+        if (algorithm == SortTrace::Bucket) visualbucketsort->setBucketRange(event.a, event.b, event.c);
+        break;
+    case TraceEvent::BucketAssign:
+        if (algorithm == SortTrace::Bucket) visualbucketsort->assignToBucket(event.a, event.b);
+        break;
+    case TraceEvent::BucketSwap:
+        if (algorithm == SortTrace::Bucket) visualbucketsort->swapInBucket(event.a, event.b, event.c);
+        break;
+    case TraceEvent::FinalOutput:
+        if (algorithm == SortTrace::Bucket) visualbucketsort->markFinal(event.a);
+        break;
+    case TraceEvent::Range:
+        if (SortTrace::isSearch(algorithm)) visualbinarysearch->highlightCheck(event.a, event.b, event.c);
+        break;
+    case TraceEvent::FoundIndex:
+    case TraceEvent::NotFound:
+        if (!SortTrace::isSearch(algorithm)) break;
+        if (event.op == TraceEvent::FoundIndex)
+            visualbinarysearch->highlightFound(event.a);
+        logArea->appendPlainText(QString(" 共探查 %1 次").arg(visualbinarysearch->probes()));
+        break;
+    case TraceEvent::RadixRange:
+        visualradixsort->setRange(event.a, event.b);
+        break;
+    case TraceEvent::RadixPass:
+        visualradixsort->beginPass(event.a, event.b);
+        break;
+    case TraceEvent::RadixCount:
+        visualradixsort->count(event.a, event.b);
+        break;
+    case TraceEvent::RadixPrefix:
+        visualradixsort->prefix();
+        break;
+    case TraceEvent::RadixScatter:
+        visualradixsort->scatter(event.a, event.b, event.c);
+        break;
+    case TraceEvent::RadixDone:
+        visualradixsort->endPass();
+        break;
+    case TraceEvent::ParallelInit:
+        visualparallelsort->init(event.a);
+        break;
+    case TraceEvent::ParallelTask:
+        visualparallelsort->beginTask(event.a, event.b, event.c);
+        break;
+    case TraceEvent::ParallelIdle:
+        visualparallelsort->idle(event.a);
+        break;
+    case TraceEvent::ParallelWrite:
+        visualparallelsort->write(event.a, event.b, event.c);
+        break;
+    case TraceEvent::ParallelSteal:
+        visualparallelsort->steal(event.a, event.b);
+        break;
+    case TraceEvent::LayoutQuery:
+        visuallayoutsearch->beginQuery(event.a);
+        break;
+    case TraceEvent::LayoutProbe:
+        visuallayoutsearch->probe(event.a, event.b);
+        break;
+    case TraceEvent::LayoutResult:
+        visuallayoutsearch->result(event.a, event.b, event.c);
+        break;
+    }
+}
+
+void Widget::loadDataset()
+{
+    QString path = QFileDialog::getOpenFileName(this, "载入数据集", QString(),
+                                                "数据文件 (*.csv *.txt *.bin *.i32 *.dat);;所有文件 (*)");
+    if (path.isEmpty()) return;
+
+    QVector<int> values;
+    QString error;
+    if (!Dataset::load(path, &values, &error)) {
+        logArea->appendPlainText(" " + error);
+        return;
+    }
+    loadedDataset = values;
+
+    // 文件数据集在分布下拉框中以 -1 标识，重复载入时替换
+    QString name = "文件：" + QFileInfo(path).fileName();
+    int index = distributionCombo->findData(-1);
+    if (index < 0) {
+        distributionCombo->addItem(name, -1);
+        index = distributionCombo->count() - 1;
+    } else {
+        distributionCombo->setItemText(index, name);
+    }
+    distributionCombo->setCurrentIndex(index);
+
+    logArea->appendPlainText(QString(" 已载入 %1 个元素：%2").arg(values.size()).arg(path));
+    if (values.size() == Dataset::MaxSize)
+        logArea->appendPlainText(QString(" 已达到数据集上限 %1 个元素，超出部分被截断。").arg(Dataset::MaxSize));
+}
+
+void Widget::startNativeTrace()
+{
+    SortTrace::Algorithm algorithm;
+    if (!SortTrace::algorithmForFile(filePath, &algorithm)) {
+        logArea->appendPlainText(" 当前算法不支持原生运行，请使用构建与运行。");
+        return;
+    }
+    if (gdbProcess->state() == QProcess::Running) {
+        logArea->appendPlainText(" 调试进程正在运行，请先结束当前运行！");
+        return;
+    }
+    stopNativeTrace();
+
+    quint32 seed = static_cast<quint32>(seedSpinBox->value());
+    QVector<int> input = currentDataset();
+
+    int maxElements = SortTrace::maxElements(algorithm);
+    if (input.size() > maxElements) {
+        logArea->appendPlainText(QString(" 当前可视化最多容纳 %1 个元素，仅使用数据集的前 %1 个。").arg(maxElements));
+        input.resize(maxElements);
+    }
+
+    // 查找的目标从数据集中按种子选取，少数情况下取一个不存在的值；基数排序取每趟位数
+    int parameter = 0;
+    if (SortTrace::isSearch(algorithm) && !input.isEmpty()) {
+        QRandomGenerator rng(seed);
+        int pick = rng.bounded(input.size() + input.size() / 4 + 1);
+        parameter = pick < input.size() ? input[pick] : *std::max_element(input.begin(), input.end()) + 1;
+    }
+    else if (algorithm == SortTrace::LayoutSearch) {
+        parameter = static_cast<int>(seed);
+    }
+    else if (algorithm == SortTrace::Heap) {
+        parameter = HeapSort::encode(heapOptions);
+        logArea->appendPlainText(" 堆排序：" + heapOptionsButton->text());
+    }
+    else if (algorithm == SortTrace::RadixLSD || algorithm == SortTrace::RadixMSD) {
+        parameter = radixBitsSpinBox->value();
+    }
+    else if (algorithm == SortTrace::Intro) {
+        parameter = IntroSort::encode(introOptions);
+        logArea->appendPlainText(" 内省排序：" + introOptionsButton->text());
+    }
+    else if (algorithm == SortTrace::ParallelMerge || algorithm == SortTrace::SampleSort) {
+        parameter = workersSpinBox->value();
+        logArea->appendPlainText(QString(" 并行排序：%1 个工作者，事件按各线程实际交错的顺序回放。").arg(parameter));
+    }
+
+    QVector<TraceEvent> events;
+    if (!SortTrace::generate(algorithm, input, &events, parameter))
+        logArea->appendPlainText(QString(" 事件数超过上限 %1，轨迹已截断。").arg(SortTrace::DefaultEventLimit));
+    logArea->appendPlainText(QString(" 原生运行：%1，N = %2，种子 %3，共 %4 个事件。")
+                             .arg(distributionCombo->currentText()).arg(input.size()).arg(seed).arg(events.size()));
+
+    visualAreaView->resetTransform();
+    visualAreaScene->clear();
+    activeVisualEntity();
+    if (algorithm == SortTrace::Heap)
+        visualheap->setArity(heapOptions.arity);
+    if (SortTrace::isSearch(algorithm)) {
+        std::sort(input.begin(), input.end());
+        visualbinarysearch->setValues(input);
+    }
+    nativeTraceActive = true;
+
+    tracePlayer->setSpeed(speedSlider->value());
+    tracePlayer->load(events);
+    tracePlayer->play();
+}
+
+void Widget::stopNativeTrace()
+{
+    if (!nativeTraceActive) return;
+    tracePlayer->stop();
+    nativeTraceActive = false;
+    deleteVisualEntity();
+}
+
+void Widget::openBenchmark()
+{
+    // 计时使用优化构建；对话框关闭时会取消并等待工作线程
+    // 先结束当前的计数记录，计时期间的操作不计入上一次运行
+    counterPanel->endRun();
+    BenchmarkDialog dialog(QDir::currentPath() + "/temp_code_bench.exe", this);
+    dialog.exec();
+}
+
+QVector<int> Widget::currentDataset() const
+{
+    // 数据集：按分布生成，或使用已载入的文件
+    int distribution = distributionCombo->currentData().toInt();
+    if (distribution < 0)
+        return loadedDataset;
+    return Dataset::generate(static_cast<Dataset::Distribution>(distribution), sizeSpinBox->value(),
+                             static_cast<quint32>(seedSpinBox->value()));
+}
+
+void Widget::openSpeedup()
+{
+    SortTrace::Algorithm algorithm;
+    if (!SortTrace::algorithmForFile(filePath, &algorithm)) return;
+    if (algorithm != SortTrace::ParallelMerge && algorithm != SortTrace::SampleSort) return;
+
+    // 计时使用完整数据集，不受可视化元素个数上限的限制
+    counterPanel->endRun();
+    SpeedupDialog dialog(algorithm == SortTrace::ParallelMerge ? ParallelSort::MergeSort : ParallelSort::SampleSort,
+                         currentDataset(), this);
+    dialog.exec();
+}
+
+void Widget::openLayoutBenchmark()
+{
+    // 计时数组由对话框按大小自行生成，与当前数据集无关
+    counterPanel->endRun();
+    LayoutSearchDialog dialog(this);
+    dialog.exec();
+}
+
+void Widget::openBTreeOrderBenchmark()
+{
+    // 计时用的键由对话框自行生成，与当前数据集无关
+    counterPanel->endRun();
+    BTreeOrderDialog dialog(this);
+    dialog.exec();
+}
+
+void Widget::runBTreeBulkLoad()
+{
+    if (gdbProcess->state() == QProcess::Running) {
+        logArea->appendPlainText(" 调试进程正在运行，请先结束当前运行！");
+        return;
+    }
+    if (bulkThread) return;   // 按钮在计时期间已禁用
+    stopNativeTrace();
+    counterPanel->endRun();
+
+    const QVector<int> input = currentDataset();
+    if (input.isEmpty()) return;
+    const int degree = btreeDegreeCombo->currentData().toInt();
+    const double fill = btreeFillSpinBox->value() / 100.0;
+    logArea->appendPlainText(QString(" B 树批量构建：%1，N = %2，t = %3，填充率 %4%")
+                             .arg(distributionCombo->currentText()).arg(input.size()).arg(degree).arg(btreeFillSpinBox->value()));
+
+    if (input.size() <= VisualBTree::MaxBulkKeys) {
+        // 可视化对象与原生运行共用同一释放路径：下次运行或切换算法时由 stopNativeTrace 释放
+        QVector<int> sorted = input;
+        std::sort(sorted.begin(), sorted.end());
+        visualAreaView->resetTransform();
+        visualAreaScene->clear();
+        activeVisualEntity();
+        btree->bulkLoad(sorted.constData(), sorted.size(), fill);
+        visualbtree->bulkLoadAnimated(sorted, fill);
+        nativeTraceActive = true;
+    } else {
+        logArea->appendPlainText(QString(" 超过 %1 个键，不显示构建过程。").arg(VisualBTree::MaxBulkKeys));
+    }
+
+    // 计时使用完整数据集，在工作线程中进行，计时用的树不写操作计数；工作对象没有父对象，随线程结束一起释放
+    btreeBulkButton->setEnabled(false);
+    bulkThread = new QThread;
+    bulkWorker = new BTreeBulkWorker(degree, input, fill);
+    bulkWorker->moveToThread(bulkThread);
+    connect(bulkThread, &QThread::started, bulkWorker, &BTreeBulkWorker::run);
+    connect(bulkWorker, &BTreeBulkWorker::finished, bulkThread, &QThread::quit);
+    connect(bulkThread, &QThread::finished, bulkWorker, &QObject::deleteLater);
+    connect(bulkThread, &QThread::finished, bulkThread, &QObject::deleteLater);
+    connect(bulkWorker, &BTreeBulkWorker::measured, this, [=](double bulkMs, int bulkHeight, double insertMs, int insertHeight) {
+        logArea->appendPlainText(QString(" 批量构建 %1 ms（不含排序），树高 %2；逐个插入 %3 ms，树高 %4")
+                                 .arg(bulkMs, 0, 'f', 2).arg(bulkHeight).arg(insertMs, 0, 'f', 2).arg(insertHeight));
+    });
+    connect(bulkWorker, &BTreeBulkWorker::failed, this, [=](const QString &message) {
+        logArea->appendPlainText(" " + message);
+    });
+    connect(bulkWorker, &BTreeBulkWorker::finished, this, [=]() {
+        bulkThread = nullptr;
+        bulkWorker = nullptr;
+        btreeBulkButton->setEnabled(true);
+    });
+    bulkThread->start();
+}
+
+void Widget::runBSTBuild()
+{
+    if (gdbProcess->state() == QProcess::Running) {
+        logArea->appendPlainText(" 调试进程正在运行，请先结束当前运行！");
+        return;
+    }
+    stopNativeTrace();
+
+    QVector<int> input = currentDataset();
+    if (input.isEmpty()) return;
+    if (input.size() > VisualTree::MaxNodes) {
+        logArea->appendPlainText(QString(" 当前可视化最多容纳 %1 个元素，仅使用数据集的前 %1 个。").arg(VisualTree::MaxNodes));
+        input.resize(VisualTree::MaxNodes);
+    }
+
+    // 可视化对象与原生运行共用同一释放路径：下次运行或切换算法时由 stopNativeTrace 释放
+    visualAreaView->resetTransform();
+    visualAreaScene->clear();
+    activeVisualEntity();
+    const int mode = bstBuildCombo->currentData().toInt();
+    if (mode == BSTBalancedBuild) {
+        std::sort(input.begin(), input.end());
+        bstTree->buildBalanced(input);
+    } else {
+        bstTree->setBalanceGuard(mode == BSTGuardedInsert);
+        for (int value : input)
+            bstTree->insert(value);
+    }
+    visualTree->rebuild(bstTree->getRoot());
+    nativeTraceActive = true;
+
+    logArea->appendPlainText(QString(" 二叉排序树（%1）：%2，N = %3，树高 %4")
+                             .arg(bstBuildCombo->currentText()).arg(distributionCombo->currentText())
+                             .arg(bstTree->size()).arg(bstTree->height()));
+}
+
+void Widget::runSearchBatch()
+{
+    QVector<int> sorted = currentDataset();
+    if (sorted.isEmpty()) return;
+    std::sort(sorted.begin(), sorted.end());
+
+    // 四种方法使用同一组查询；插值查找在偏斜数据上可能退化，超出探查预算时只统计已完成的部分
+    const QVector<int> queries = Search::batchQueries(sorted, Search::BatchQueries, static_cast<quint32>(seedSpinBox->value()));
+    logArea->appendPlainText(QString(" 批量查询：%1，N = %2，%3 次查询")
+                             .arg(distributionCombo->currentText()).arg(sorted.size()).arg(queries.size()));
+    for (int m = 0; m < Search::MethodCount; ++m) {
+        const Search::Method method = static_cast<Search::Method>(m);
+        const Search::BatchStats stats = Search::batch(sorted, queries, method);
+        QString line = QString(" %1：平均探查 %2 次，最多 %3 次，命中 %4 次")
+                       .arg(Search::methodName(method))
+                       .arg(stats.averageProbes(), 0, 'f', 2)
+                       .arg(stats.maxProbes)
+                       .arg(stats.found);
+        if (stats.queries < queries.size())
+            line += QString("（超出探查预算，仅完成 %1 次）").arg(stats.queries);
+        logArea->appendPlainText(line);
     }
 }
 
 void Widget::activeVisualEntity()
 {
+    counterPanel->beginRun(QFileInfo(filePath).baseName());
+
     if (filePath == ":/codes/prebinarytree.c" || filePath == ":/codes/inbinarytree.c" || filePath == ":/codes/postbinarytree.c") {
         bstTree = new BSTTree();
         visualTree = new VisualTree(visualAreaScene, visualAreaView, visualAreaView->viewport()->size());
     } else if (filePath == ":/codes/avltree.c") {
-        avlTree = new AVLTree();
+        avlTree = new AVLTree<int>();
         visualTree = new VisualTree(visualAreaScene, visualAreaView, visualAreaView->viewport()->size());
     }
     else if(filePath == ":/codes/singlylinkedlist.c")
@@ -1075,10 +1981,12 @@ void Widget::activeVisualEntity()
     }
     else if(filePath == ":/codes/btree.c")
     {
-        btree = new BTree;
-        visualbtree = new VisualBTree(visualAreaScene, visualAreaView->viewport()->size(), visualAreaView);
+        const int degree = btreeDegreeCombo->currentData().toInt();
+        btree = AnyBTree::create(degree);
+        visualbtree = new VisualBTree(visualAreaScene, visualAreaView->viewport()->size(), visualAreaView, degree);
     }
-    else if(filePath == ":/codes/binarysearch.c")
+    else if(filePath == ":/codes/binarysearch.c" || filePath == ":/codes/interpolationsearch.c"
+            || filePath == ":/codes/exponentialsearch.c" || filePath == ":/codes/fibonaccisearch.c")
     {
         visualbinarysearch = new VisualBinarySearch(visualAreaScene, visualAreaView->viewport()->size());
     }
@@ -1086,7 +1994,7 @@ void Widget::activeVisualEntity()
     {
         visualbubblesort = new VisualBubbleSort(visualAreaScene, visualAreaView->viewport()->size());
     }
-    else if(filePath == ":/codes/quicksort.c")
+    else if(filePath == ":/codes/quicksort.c" || filePath == ":/codes/introsort.c")
     {
         visualquicksort = new VisualQuickSort(visualAreaScene, visualAreaView->viewport()->size());
     }
@@ -1098,10 +2006,24 @@ void Widget::activeVisualEntity()
     {
         visualbucketsort = new VisualBucketSort(visualAreaScene, visualAreaView->viewport()->size());
     }
+    else if(filePath == ":/codes/lsdradixsort.c" || filePath == ":/codes/msdradixsort.c")
+    {
+        visualradixsort = new VisualRadixSort(visualAreaScene, visualAreaView->viewport()->size());
+    }
+    else if(filePath == ":/codes/parallelmergesort.c" || filePath == ":/codes/samplesort.c")
+    {
+        visualparallelsort = new VisualParallelSort(visualAreaScene, visualAreaView->viewport()->size());
+    }
+    else if(filePath == ":/codes/layoutsearch.c")
+    {
+        visuallayoutsearch = new VisualLayoutSearch(visualAreaScene, visualAreaView->viewport()->size());
+    }
 }
 
 void Widget::deleteVisualEntity()
 {
+    counterPanel->endRun();
+
     if(filePath == ":/codes/prebinarytree.c" || filePath == ":/codes/inbinarytree.c" || filePath == ":/codes/postbinarytree.c")
     {
         bstTree->clear();
@@ -1146,8 +2068,13 @@ void Widget::deleteVisualEntity()
     }
     else if(filePath == ":/codes/btree.c")
     {
+        delete btree;
+        delete visualbtree;
+        btree = nullptr;
+        visualbtree = nullptr;
     }
-    else if(filePath == ":/codes/binarysearch.c")
+    else if(filePath == ":/codes/binarysearch.c" || filePath == ":/codes/interpolationsearch.c"
+            || filePath == ":/codes/exponentialsearch.c" || filePath == ":/codes/fibonaccisearch.c")
     {
         visualbinarysearch->clear();
         delete visualbinarysearch;
@@ -1157,7 +2084,7 @@ void Widget::deleteVisualEntity()
         visualbubblesort->clear();
         delete visualbubblesort;
     }
-    else if(filePath == ":/codes/quicksort.c")
+    else if(filePath == ":/codes/quicksort.c" || filePath == ":/codes/introsort.c")
     {
         visualquicksort->clear();
         delete visualquicksort;
@@ -1172,10 +2099,32 @@ void Widget::deleteVisualEntity()
         visualbucketsort->clear();
         delete visualbucketsort;
     }
+    else if (filePath == ":/codes/lsdradixsort.c" || filePath == ":/codes/msdradixsort.c")
+    {
+        visualradixsort->clear();
+        delete visualradixsort;
+    }
+    else if (filePath == ":/codes/parallelmergesort.c" || filePath == ":/codes/samplesort.c")
+    {
+        visualparallelsort->clear();
+        delete visualparallelsort;
+    }
+    else if (filePath == ":/codes/layoutsearch.c")
+    {
+        visuallayoutsearch->clear();
+        delete visuallayoutsearch;
+    }
 }
 
 Widget::~Widget()
 {
+    // 批量构建计时尚未结束时取消并等待，插入循环会尽快退出
+    if (bulkThread) {
+        bulkWorker->cancel();
+        bulkThread->quit();
+        bulkThread->wait();
+    }
+
     if (gdbProcess) {
             gdbProcess->write("quit\n");
             gdbProcess->terminate();
@@ -1185,6 +2134,8 @@ Widget::~Widget()
     //删除构建时产生的临时文件
     QFile::remove(QDir::currentPath() + "/temp_code.c");
     QFile::remove(QDir::currentPath() + "/temp_code.exe");
+    QFile::remove(QDir::currentPath() + "/temp_code_bench.exe");
+    QFile::remove(QDir::currentPath() + "/visual_trace.h");
 
     delete ui;
 }
@@ -21,6 +21,22 @@
 #include "visualquicksort.h"
 #include "visualheap.h"
 #include "visualbucketsort.h"
+#include "visualradixsort.h"
+#include "visualparallelsort.h"
+#include "visuallayoutsearch.h"
+#include "dataset.h"
+#include "sorttrace.h"
+#include "radixsort.h"
+#include "introsort.h"
+#include "heapsort.h"
+#include "search.h"
+#include "traceplayer.h"
+#include "counterpanel.h"
+#include "benchmarkdialog.h"
+#include "speedupdialog.h"
+#include "layoutsearchdialog.h"
+#include "btreeorderdialog.h"
+#include "benchmark.h"
 #include <QWidget>
 #include <QMainWindow>
 #include <QApplication>
@@ -40,19 +56,27 @@
 #include <QPushButton>
 #include <QIcon>
 #include <QSlider>
+#include <QSpinBox>
+#include <QComboBox>
+#include <QMenu>
+#include <QActionGroup>
 #include <QToolTip>
 #include <QScreen>
 #include <QFileDialog>
+#include <QFileInfo>
 #include <QFileSystemWatcher>
 #include <QFont>
 #include <QTextStream>
 #include <QMessageBox>
 #include <QProcess>
 #include <QTimer>
+#include <QRandomGenerator>
 #include <QThread>
 #include <QGraphicsView>
 #include <QGraphicsScene>
 #include <QVector>
+#include <algorithm>
+#include <climits>
 
 QT_BEGIN_NAMESPACE
 namespace Ui { class Widget; }
@@ -77,6 +101,7 @@ public:
 
     void onTreeItemClicked(QTreeWidgetItem *item, int column); // 点击导航栏
     void compileCode();                                        // 代码构建
+    void compileBenchmarkBuild(const QString &sourcePath);     // 构建用于计时的优化版本
     void startGDBProcess();                                    // 配置和启动GDB进程
     void onRunPauseButtonClicked();                            // 执行代码
     void highlightLine(int lineNum);                           // 根据行号高亮 codeArea 中对应的行
@@ -85,6 +110,19 @@ public:
     void activeVisualEntity();               // 定义可视化对象
     void deleteVisualEntity();               // 释放可视化对象
     void doVisualWork(QString output);       // 执行可视化任务
+    void applyTraceEvent(const TraceEvent& event); // 将一条排序轨迹事件分发给可视化对象
+
+    void loadDataset();                      // 从 CSV / 二进制文件载入数据集
+    void startNativeTrace();                 // 进程内生成排序轨迹并播放（无需 gcc/gdb）
+    void stopNativeTrace();                  // 停止原生播放并释放可视化对象
+    void openBenchmark();                    // 打开规模测试对话框
+    void openSpeedup();                      // 打开并行排序的加速比对话框
+    void openLayoutBenchmark();              // 打开查找布局的缓存测试对话框
+    void openBTreeOrderBenchmark();          // 打开 B 树阶数测试对话框
+    void runBTreeBulkLoad();                 // 由当前数据集自底向上批量构建 B 树，与逐个插入比较耗时
+    void runBSTBuild();                      // 由当前数据集构建二叉排序树并绘制
+    void runSearchBatch();                   // 在完整数据集上批量查询，比较四种查找的平均探查次数
+    QVector<int> currentDataset() const;     // 按当前分布、规模与种子生成（或已载入）的数据集
 
     //解决Qt中QSlider与ToolTip 的“显示延迟同步”问题
     bool eventFilter(QObject *watched, QEvent *event) override;
@@ -105,12 +143,42 @@ private:
     QGraphicsScene *visualAreaScene;
     QSplitter *verticalSplitter;
     QPlainTextEdit *logArea;
+    CounterPanel *counterPanel;       // 操作计数面板
     QVBoxLayout *codeLayout;
     QTextEdit *codeArea;
     QToolButton *buildButton;
     QToolButton *runPauseButton;
     QToolButton *stepButton;
     QSlider *speedSlider;
+    QSpinBox *sizeSpinBox;            // 数据集元素个数
+    QComboBox *distributionCombo;     // 数据集分布（或已载入的文件）
+    QSpinBox *seedSpinBox;            // 数据集随机种子
+    QToolButton *heapOptionsButton;   // 堆排序的叉数、建堆与下沉方式
+    HeapSort::Options heapOptions;
+    QSpinBox *radixBitsSpinBox;       // 基数排序每趟位数
+    QToolButton *introOptionsButton;  // 内省排序的划分方式、主元选取
+    IntroSort::Options introOptions;
+    QSpinBox *workersSpinBox;         // 并行排序的工作者个数
+    QComboBox *btreeDegreeCombo;      // B 树的最小度数，下次运行时生效
+    QSpinBox *btreeFillSpinBox;       // B 树批量构建的结点填充率（%）
+    QToolButton *loadDatasetButton;   // 载入数据集文件
+    QToolButton *nativeRunButton;     // 原生运行
+    QToolButton *benchmarkButton;     // 规模测试
+    QToolButton *speedupButton;       // 并行排序加速比
+    QToolButton *layoutBenchmarkButton; // 查找布局缓存测试
+    QToolButton *searchBatchButton;   // 查找的批量查询
+    QToolButton *btreeOrderButton;    // B 树阶数测试
+    QToolButton *btreeBulkButton;     // B 树批量构建
+    enum BSTBuildMode {
+        BSTInsert,                    // 按数据集顺序逐个插入，有序输入退化为单链
+        BSTGuardedInsert,             // 逐个插入并开启平衡保护
+        BSTBalancedBuild              // 排序后一次构建完全平衡的树
+    };
+    QComboBox *bstBuildCombo;         // 由数据集构建二叉排序树的方式
+    QToolButton *bstBuildButton;      // 由数据集构建二叉排序树
+    QThread *bulkThread;              // 批量构建计时线程，未在计时时为空
+    BTreeBulkWorker *bulkWorker;
+    QVector<int> loadedDataset;       // 最近一次载入的文件数据
 
     bool executionRunning;     // 当前是否处于“运行”状态
     CHighlighter *highlighter; // 代码高亮
@@ -118,10 +186,12 @@ private:
     QProcess *gdbProcess;      // 运行C语言代码（调试模式）
     QTimer *autoStepTimer;     // 自动单步执行定时器(自动运行)
     QString filePath;          // 唯一标识可视化程序
+    TracePlayer *tracePlayer;  // 原生轨迹回放
+    bool nativeTraceActive;    // 原生轨迹是否占用可视化对象
 
     // 二叉树可视化
     BSTTree *bstTree;
-    AVLTree *avlTree;
+    AVLTree<int> *avlTree;
     VisualTree *visualTree;
 
     // 链表可视化
@@ -141,7 +211,7 @@ private:
     VisualGraph *visualgraph;
 
     // B树可视化
-    BTree *btree;
+    AnyBTree *btree;
     VisualBTree *visualbtree;
 
     // 折半查找可视化
@@ -159,5 +229,14 @@ private:
     // 桶排序可视化
     VisualBucketSort *visualbucketsort;
 
+    // 基数排序可视化（LSD、MSD）
+    VisualRadixSort *visualradixsort;
+
+    // 并行排序可视化（归并排序、样本排序）
+    VisualParallelSort *visualparallelsort;
+
+    // 缓存友好查找可视化（有序数组、Eytzinger、B 树分块）
+    VisualLayoutSearch *visuallayoutsearch;
+
 };
 #endif // WIDGET_H
@@ -0,0 +1,34 @@
+#include "opcounter.h"
+
+quint64 OpCounter::s_counts[OpCounter::KindCount] = {};
+
+void OpCounter::reset() {
+    for (quint64& count : s_counts)
+        count = 0;
+}
+
+QString OpCounter::name(Kind kind) {
+    switch (kind) {
+    case Comparisons: return "比较";
+    case Swaps:       return "交换";
+    case Rotations:   return "旋转";
+    case Splits:      return "分裂";
+    case Merges:      return "合并";
+    case Borrows:     return "借键";
+    case Relaxations: return "松弛";
+    default:          return QString();
+    }
+}
+
+QString OpCounter::key(Kind kind) {
+    switch (kind) {
+    case Comparisons: return "comparisons";
+    case Swaps:       return "swaps";
+    case Rotations:   return "rotations";
+    case Splits:      return "splits";
+    case Merges:      return "merges";
+    case Borrows:     return "borrows";
+    case Relaxations: return "relaxations";
+    default:          return QString();
+    }
+}
@@ -0,0 +1,39 @@
+#ifndef OPCOUNTER_H
+#define OPCOUNTER_H
+
+#include <QString>
+#include <QtGlobal>
+
+// 算法运行过程中的操作计数（比较、交换、旋转、分裂、合并、借键、松弛）
+// 计数为全局静态量：数据结构内部直接累加，每次运行开始时由 CounterPanel 清零
+// 计数与采样都只在界面线程进行；在工作线程中计时的实例化以 NullOpCounter 为计数策略
+class OpCounter {
+public:
+    enum Kind {
+        Comparisons,
+        Swaps,
+        Rotations,
+        Splits,
+        Merges,
+        Borrows,
+        Relaxations,
+        KindCount
+    };
+
+    static void add(Kind kind, quint64 n = 1) { s_counts[kind] += n; }
+    static quint64 value(Kind kind) { return s_counts[kind]; }
+    static void reset();
+
+    static QString name(Kind kind);      // 界面显示名
+    static QString key(Kind kind);       // CSV 列名
+
+private:
+    static quint64 s_counts[KindCount];
+};
+
+// 不计数的计数策略：累加调用被完全内联消除，既不写全局计数，也不计入计时
+struct NullOpCounter {
+    static void add(OpCounter::Kind, quint64 = 1) {}
+};
+
+#endif // OPCOUNTER_H
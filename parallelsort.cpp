@@ -0,0 +1,147 @@
+#include "parallelsort.h"
+#include "radixsort.h"
+#include <QElapsedTimer>
+#include <chrono>
+
+static const int kIdleWaitMs = 1;   // 空闲线程休眠上限，防止漏掉唤醒后一直沉睡
+
+static thread_local int t_worker = -1;
+
+WorkStealingPool::WorkStealingPool(int workers)
+    : m_queued(0), m_stop(false), m_steals(0) {
+    workers = qMax(1, workers);
+    for (int i = 0; i < workers; ++i)
+        m_queues.emplace_back(new Queue);
+    for (int i = 1; i < workers; ++i)
+        m_threads.emplace_back(&WorkStealingPool::workerLoop, this, i);
+}
+
+WorkStealingPool::~WorkStealingPool() {
+    m_stop = true;
+    m_wake.notify_all();
+    for (std::thread& thread : m_threads)
+        thread.join();
+}
+
+int WorkStealingPool::workerCount() const {
+    return static_cast<int>(m_queues.size());
+}
+
+int WorkStealingPool::currentWorker() {
+    return t_worker;
+}
+
+int WorkStealingPool::maxWorkers() {
+    return qMax(1, static_cast<int>(std::thread::hardware_concurrency()));
+}
+
+quint64 WorkStealingPool::stealCount() const {
+    return m_steals;
+}
+
+void WorkStealingPool::setStealObserver(std::function<void(int, int)> observer) {
+    m_stealObserver = observer;
+}
+
+void WorkStealingPool::run(const Task& root) {
+    // 调用线程临时成为 0 号工作者
+    int previousWorker = t_worker;
+    t_worker = 0;
+
+    Group group;
+    spawn(group, root);
+    wait(group);
+
+    t_worker = previousWorker;
+}
+
+void WorkStealingPool::spawn(Group& group, Task task) {
+    group.m_pending.fetch_add(1);
+    Queue& queue = *m_queues[t_worker];
+    {
+        std::lock_guard<std::mutex> lock(queue.mutex);
+        queue.tasks.emplace_back([&group, task]() {
+            task();
+            group.m_pending.fetch_sub(1);
+        });
+    }
+    m_queued.fetch_add(1);
+    m_wake.notify_one();
+}
+
+void WorkStealingPool::wait(Group& group) {
+    while (group.m_pending.load() > 0) {
+        if (!tryRunOne(t_worker))
+            std::this_thread::yield();
+    }
+}
+
+void WorkStealingPool::workerLoop(int id) {
+    t_worker = id;
+    while (!m_stop) {
+        if (tryRunOne(id)) continue;
+        std::unique_lock<std::mutex> lock(m_sleepMutex);
+        m_wake.wait_for(lock, std::chrono::milliseconds(kIdleWaitMs),
+                        [this]() { return m_stop || m_queued.load() > 0; });
+    }
+}
+
+bool WorkStealingPool::tryRunOne(int id) {
+    Task task;
+    if (!popLocal(id, &task) && !steal(id, &task))
+        return false;
+    m_queued.fetch_sub(1);
+    task();
+    return true;
+}
+
+bool WorkStealingPool::popLocal(int id, Task* task) {
+    Queue& queue = *m_queues[id];
+    std::lock_guard<std::mutex> lock(queue.mutex);
+    if (queue.tasks.empty()) return false;
+    *task = std::move(queue.tasks.back());
+    queue.tasks.pop_back();
+    return true;
+}
+
+bool WorkStealingPool::steal(int id, Task* task) {
+    const int n = workerCount();
+    for (int k = 1; k < n; ++k) {
+        const int victim = (id + k) % n;
+        Queue& queue = *m_queues[victim];
+        {
+            std::lock_guard<std::mutex> lock(queue.mutex);
+            if (queue.tasks.empty()) continue;
+            *task = std::move(queue.tasks.front());
+            queue.tasks.pop_front();
+        }
+        m_steals.fetch_add(1);
+        if (m_stealObserver)
+            m_stealObserver(id, victim);
+        return true;
+    }
+    return false;
+}
+
+namespace ParallelSort {
+
+double timeSort(Algorithm algorithm, const QVector<int>& input, int workers, int repeats) {
+    WorkStealingPool pool(workers);
+    RadixSort::NullRecorder rec;
+    const int grain = grainFor(input.size(), workers, BenchmarkGrain);
+
+    QVector<double> times;
+    for (int r = 0; r < qMax(1, repeats); ++r) {
+        // 拷贝在计时之外完成
+        QVector<int> a = input;
+        a.detach();
+        QElapsedTimer timer;
+        timer.start();
+        sort(algorithm, a, pool, rec, grain);
+        times.append(timer.nsecsElapsed() / 1e9);
+    }
+    std::sort(times.begin(), times.end());
+    return times[times.size() / 2];
+}
+
+}
@@ -0,0 +1,404 @@
+#ifndef PARALLELSORT_H
+#define PARALLELSORT_H
+
+#include "sorttrace.h"
+#include <QVector>
+#include <QtGlobal>
+#include <algorithm>
+#include <atomic>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <condition_variable>
+#include <thread>
+#include <vector>
+
+// 工作窃取线程池：每个工作者一个双端队列，自己从尾部取（LIFO，缓存友好），
+// 空闲时从其他工作者的头部窃取（FIFO，窃到的是较大的任务）
+// 调用 run() 的线程作为 0 号工作者参与计算，另起 workers - 1 个线程
+class WorkStealingPool {
+public:
+    typedef std::function<void()> Task;
+
+    // fork-join 任务组：组内任务全部完成前 wait() 不返回
+    class Group {
+    public:
+        Group() : m_pending(0) {}
+    private:
+        friend class WorkStealingPool;
+        std::atomic<int> m_pending;
+    };
+
+    explicit WorkStealingPool(int workers);
+    ~WorkStealingPool();
+
+    int workerCount() const;
+    static int currentWorker();                   // 当前线程的工作者编号，池外线程为 -1
+
+    void run(const Task& root);                   // 在当前线程上执行根任务直至其全部子任务完成
+    void spawn(Group& group, Task task);          // 压入当前工作者的队列，只能在池内任务中调用
+    void wait(Group& group);                      // 等待期间执行自己的或窃取来的任务
+
+    quint64 stealCount() const;
+    void setStealObserver(std::function<void(int thief, int victim)> observer);
+
+    static int maxWorkers();                      // 硬件线程数
+
+private:
+    struct Queue {
+        std::mutex mutex;
+        std::deque<Task> tasks;
+    };
+
+    void workerLoop(int id);
+    bool tryRunOne(int id);                       // 取一个任务执行，没有可做的任务时返回 false
+    bool popLocal(int id, Task* task);
+    bool steal(int id, Task* task);
+
+    std::vector<std::unique_ptr<Queue>> m_queues;
+    std::vector<std::thread> m_threads;
+    std::atomic<int> m_queued;                    // 所有队列中的任务数，供空闲线程判断是否休眠
+    std::atomic<bool> m_stop;
+    std::atomic<quint64> m_steals;
+    std::mutex m_sleepMutex;
+    std::condition_variable m_wake;
+    std::function<void(int, int)> m_stealObserver;
+};
+
+// 并行排序：基于任务的归并排序与样本排序
+// 与 RadixSort 一样以模板接收记录器；事件带有工作者编号（PAR_TASK / PAR_IDLE / PAR_WRITE），
+// 多个线程同时记录，生成轨迹时需用 LockedRecorder 包装
+namespace ParallelSort {
+
+const int MaxWorkers = 64;          // 轨迹允许超过硬件线程数，以便观察超额订阅
+const int MinGrain = 16;            // 轨迹模式的最小任务粒度
+const int BenchmarkGrain = 8192;    // 计时模式的最小任务粒度，过小时调度开销超过收益
+const int TasksPerWorker = 4;       // 每个工作者大约分到的叶子任务数，留出窃取余地
+const int Oversampling = 16;        // 样本排序每个桶抽取的样本数
+
+// 任务粒度：既要足够多的任务让工作者忙起来，又不能小到调度开销占主导
+inline int grainFor(int n, int workers, int minGrain) {
+    return qMax(minGrain, n / qMax(1, workers * TasksPerWorker * 2));
+}
+
+// 多线程共享的记录器：每次记录加锁，事件顺序即各线程实际交错的顺序
+template <class Inner>
+class LockedRecorder {
+public:
+    explicit LockedRecorder(Inner& inner) : m_inner(inner) {}
+
+    void record(TraceEvent::Op op, int a = 0, int b = 0, int c = 0) {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_inner.record(op, a, b, c);
+    }
+
+    bool truncated() {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        return m_inner.truncated();
+    }
+
+private:
+    Inner& m_inner;
+    std::mutex m_mutex;
+};
+
+// 区间 [lo, hi) 按粒度二分后并行执行 body(chunkLo, chunkHi)
+template <class Body>
+void parallelFor(WorkStealingPool& pool, int lo, int hi, int grain, const Body& body) {
+    if (hi - lo <= grain) {
+        body(lo, hi);
+        return;
+    }
+    int mid = lo + (hi - lo) / 2;
+    WorkStealingPool::Group group;
+    pool.spawn(group, [&pool, lo, mid, grain, &body]() { parallelFor(pool, lo, mid, grain, body); });
+    parallelFor(pool, mid, hi, grain, body);
+    pool.wait(group);
+}
+
+// 公共部分：任务开始/结束与等待时的记录
+template <class Recorder>
+class SorterBase {
+protected:
+    SorterBase(QVector<int>& a, WorkStealingPool& pool, Recorder& rec, int grain)
+        : m_a(a), m_buffer(a.size()), m_pool(pool), m_rec(rec), m_grain(grain) {
+        // 隐式共享的数组若在多个线程中首次写入时才分离，会发生竞争
+        m_a.detach();
+    }
+
+    void begin(int lo, int hi) {
+        m_rec.record(TraceEvent::ParallelTask, WorkStealingPool::currentWorker(), lo, hi);
+    }
+
+    void end() {
+        m_rec.record(TraceEvent::ParallelIdle, WorkStealingPool::currentWorker());
+    }
+
+    // 等待子任务：等待本身记为空闲，期间执行的其他任务会各自记录忙碌
+    void join(WorkStealingPool::Group& group, int lo, int hi) {
+        end();
+        m_pool.wait(group);
+        begin(lo, hi);
+    }
+
+    // 缓冲区 [lo, hi) 写回原数组，每次写入带上工作者编号
+    void copyBack(int lo, int hi) {
+        parallelFor(m_pool, lo, hi, m_grain, [this](int first, int last) {
+            begin(first, last);
+            const int worker = WorkStealingPool::currentWorker();
+            for (int i = first; i < last && !m_rec.truncated(); ++i) {
+                m_a[i] = m_buffer[i];
+                m_rec.record(TraceEvent::ParallelWrite, i, m_a[i], worker);
+            }
+            end();
+        });
+    }
+
+    void recordStart() {
+        m_rec.record(TraceEvent::ParallelInit, m_pool.workerCount(), m_a.size());
+        m_pool.setStealObserver([this](int thief, int victim) {
+            m_rec.record(TraceEvent::ParallelSteal, thief, victim);
+        });
+    }
+
+    void recordFinish() {
+        m_pool.setStealObserver(nullptr);
+        m_rec.record(TraceEvent::SortFinished);
+    }
+
+    QVector<int>& m_a;
+    QVector<int> m_buffer;
+    WorkStealingPool& m_pool;
+    Recorder& m_rec;
+    const int m_grain;
+};
+
+// 并行归并排序：左半边作为任务派出，右半边就地递归；
+// 合并按较长一侧的中位数切分（另一侧二分定位），两段合并再并行执行，最后并行写回
+template <class Recorder>
+class MergeSorter : private SorterBase<Recorder> {
+    typedef SorterBase<Recorder> Base;
+    using Base::m_a;
+    using Base::m_buffer;
+    using Base::m_pool;
+    using Base::m_rec;
+    using Base::m_grain;
+
+public:
+    MergeSorter(QVector<int>& a, WorkStealingPool& pool, Recorder& rec, int grain)
+        : Base(a, pool, rec, grain) {}
+
+    void run() {
+        Base::recordStart();
+        const int n = m_a.size();
+        m_pool.run([this, n]() { sort(0, n); });
+        Base::recordFinish();
+    }
+
+private:
+    void sort(int lo, int hi) {
+        if (m_rec.truncated()) return;
+        Base::begin(lo, hi);
+        if (hi - lo <= m_grain) {
+            const int worker = WorkStealingPool::currentWorker();
+            std::sort(m_a.begin() + lo, m_a.begin() + hi);
+            for (int i = lo; i < hi; ++i)
+                m_rec.record(TraceEvent::ParallelWrite, i, m_a[i], worker);
+            Base::end();
+            return;
+        }
+
+        const int mid = lo + (hi - lo) / 2;
+        WorkStealingPool::Group group;
+        m_pool.spawn(group, [this, lo, mid]() { sort(lo, mid); });
+        sort(mid, hi);
+        Base::join(group, lo, hi);
+
+        merge(lo, mid, mid, hi, lo);
+        Base::end();
+        Base::copyBack(lo, hi);
+    }
+
+    // 将 a[lo1, hi1) 与 a[lo2, hi2) 合并到 buffer[out, ...)
+    void merge(int lo1, int hi1, int lo2, int hi2, int out) {
+        const int n1 = hi1 - lo1;
+        const int n2 = hi2 - lo2;
+        if (n1 < n2) {
+            merge(lo2, hi2, lo1, hi1, out);
+            return;
+        }
+        if (n1 + n2 <= m_grain) {
+            std::merge(m_a.constBegin() + lo1, m_a.constBegin() + hi1,
+                       m_a.constBegin() + lo2, m_a.constBegin() + hi2, m_buffer.begin() + out);
+            return;
+        }
+
+        // 第一段的中位数直接落位，两侧各自合并
+        const int mid1 = lo1 + n1 / 2;
+        const int mid2 = std::lower_bound(m_a.constBegin() + lo2, m_a.constBegin() + hi2, m_a[mid1]) - m_a.constBegin();
+        const int pos = out + (mid1 - lo1) + (mid2 - lo2);
+        m_buffer[pos] = m_a[mid1];
+
+        WorkStealingPool::Group group;
+        m_pool.spawn(group, [this, lo1, mid1, lo2, mid2, out]() {
+            Base::begin(out, out + (mid1 - lo1) + (mid2 - lo2));
+            merge(lo1, mid1, lo2, mid2, out);
+            Base::end();
+        });
+        merge(mid1 + 1, hi1, mid2, hi2, pos + 1);
+        Base::join(group, out, out + n1 + n2);
+    }
+};
+
+// 样本排序：抽样选出分隔值 → 各块并行统计桶计数 → 前缀和 → 各块并行散射 → 各桶并行排序并写回
+template <class Recorder>
+class SampleSorter : private SorterBase<Recorder> {
+    typedef SorterBase<Recorder> Base;
+    using Base::m_a;
+    using Base::m_buffer;
+    using Base::m_pool;
+    using Base::m_rec;
+    using Base::m_grain;
+
+public:
+    SampleSorter(QVector<int>& a, WorkStealingPool& pool, Recorder& rec, int grain)
+        : Base(a, pool, rec, grain) {}
+
+    void run() {
+        Base::recordStart();
+        m_pool.run([this]() { sortAll(); });
+        Base::recordFinish();
+    }
+
+private:
+    void sortAll() {
+        const int n = m_a.size();
+        Base::begin(0, n);
+        const int parts = qBound(1, n / qMax(1, m_grain), m_pool.workerCount() * TasksPerWorker);
+        if (parts == 1) {
+            const int worker = WorkStealingPool::currentWorker();
+            std::sort(m_a.begin(), m_a.end());
+            for (int i = 0; i < n; ++i)
+                m_rec.record(TraceEvent::ParallelWrite, i, m_a[i], worker);
+            Base::end();
+            return;
+        }
+
+        // 1. 等距抽样，排序后每 Oversampling 个样本取一个分隔值
+        QVector<int> sample;
+        sample.reserve(parts * Oversampling);
+        for (int s = 0; s < parts * Oversampling; ++s)
+            sample.append(m_a[static_cast<int>(static_cast<qint64>(s) * n / (parts * Oversampling))]);
+        std::sort(sample.begin(), sample.end());
+        m_splitters.clear();
+        for (int b = 1; b < parts; ++b)
+            m_splitters.append(sample[b * Oversampling]);
+
+        // 2. 各块统计落入每个桶的元素数
+        m_blockSize = (n + parts - 1) / parts;
+        m_blocks = (n + m_blockSize - 1) / m_blockSize;
+        m_buckets = parts;
+        m_bucketOf.resize(n);
+        m_counts.fill(0, m_blocks * m_buckets);
+        forEachBlock([this](int block, int lo, int hi) { classify(block, lo, hi); });
+        if (m_rec.truncated()) return;
+
+        // 3. 前缀和：按桶优先、块其次排列，同一桶内保持块的先后顺序
+        m_offsets.resize(m_blocks * m_buckets);
+        m_bucketStart.fill(0, m_buckets + 1);
+        int offset = 0;
+        for (int b = 0; b < m_buckets; ++b) {
+            m_bucketStart[b] = offset;
+            for (int k = 0; k < m_blocks; ++k) {
+                m_offsets[k * m_buckets + b] = offset;
+                offset += m_counts[k * m_buckets + b];
+            }
+        }
+        m_bucketStart[m_buckets] = offset;
+
+        // 4. 各块散射到缓冲区
+        forEachBlock([this](int block, int lo, int hi) { scatter(block, lo, hi); });
+        if (m_rec.truncated()) return;
+
+        // 5. 各桶独立排序并写回原数组
+        WorkStealingPool::Group group;
+        for (int b = 0; b < m_buckets; ++b)
+            m_pool.spawn(group, [this, b]() { sortBucket(b); });
+        Base::join(group, 0, n);
+        Base::end();
+    }
+
+    template <class Body>
+    void forEachBlock(const Body& body) {
+        WorkStealingPool::Group group;
+        for (int k = 0; k < m_blocks; ++k) {
+            const int lo = k * m_blockSize;
+            const int hi = qMin(m_a.size(), lo + m_blockSize);
+            m_pool.spawn(group, [&body, k, lo, hi]() { body(k, lo, hi); });
+        }
+        Base::join(group, 0, m_a.size());
+    }
+
+    void classify(int block, int lo, int hi) {
+        Base::begin(lo, hi);
+        int* counts = m_counts.data() + block * m_buckets;
+        for (int i = lo; i < hi; ++i) {
+            const int b = std::upper_bound(m_splitters.constBegin(), m_splitters.constEnd(), m_a[i]) - m_splitters.constBegin();
+            m_bucketOf[i] = static_cast<quint16>(b);
+            ++counts[b];
+        }
+        Base::end();
+    }
+
+    void scatter(int block, int lo, int hi) {
+        Base::begin(lo, hi);
+        int* next = m_offsets.data() + block * m_buckets;
+        for (int i = lo; i < hi; ++i)
+            m_buffer[next[m_bucketOf[i]]++] = m_a[i];
+        Base::end();
+    }
+
+    void sortBucket(int b) {
+        const int lo = m_bucketStart[b];
+        const int hi = m_bucketStart[b + 1];
+        if (lo == hi || m_rec.truncated()) return;
+        Base::begin(lo, hi);
+        const int worker = WorkStealingPool::currentWorker();
+        std::sort(m_buffer.begin() + lo, m_buffer.begin() + hi);
+        for (int i = lo; i < hi; ++i) {
+            m_a[i] = m_buffer[i];
+            m_rec.record(TraceEvent::ParallelWrite, i, m_a[i], worker);
+        }
+        Base::end();
+    }
+
+    QVector<int> m_splitters;
+    QVector<quint16> m_bucketOf;     // 每个元素所属的桶，散射时不必再次二分
+    QVector<int> m_counts;           // [块][桶] 计数
+    QVector<int> m_offsets;          // [块][桶] 散射起点
+    QVector<int> m_bucketStart;
+    int m_blockSize = 0;
+    int m_blocks = 0;
+    int m_buckets = 0;
+};
+
+enum Algorithm {
+    MergeSort,
+    SampleSort
+};
+
+template <class Recorder>
+void sort(Algorithm algorithm, QVector<int>& a, WorkStealingPool& pool, Recorder& rec, int grain) {
+    if (algorithm == MergeSort)
+        MergeSorter<Recorder>(a, pool, rec, grain).run();
+    else
+        SampleSorter<Recorder>(a, pool, rec, grain).run();
+}
+
+// 以 workers 个工作者对 input 的副本计时（不记录事件），返回 repeats 次的中位数（秒）
+double timeSort(Algorithm algorithm, const QVector<int>& input, int workers, int repeats);
+
+}
+
+#endif // PARALLELSORT_H
@@ -0,0 +1,114 @@
+#ifndef RADIXSORT_H
+#define RADIXSORT_H
+
+#include "sorttrace.h"
+#include <QVector>
+#include <QPair>
+#include <algorithm>
+
+// LSD / MSD 基数排序（计数排序式的分配：直方图 → 前缀和 → 散射）
+// 算法以模板形式接收记录器：轨迹生成时记录 RADIX_* 事件，计时时传入 NullRecorder，记录调用被完全内联消除
+namespace RadixSort {
+
+const int MinBits = 4;       // 每趟位数范围，即基数 2^4 … 2^16
+const int MaxBits = 16;
+
+struct NullRecorder {
+    void record(TraceEvent::Op, int = 0, int = 0, int = 0) {}
+    bool truncated() const { return false; }
+};
+
+// 键值减去最小值后按无符号数处理，负数与取值范围窄的数据都只需要必要的位数
+inline int keyBits(const QVector<int>& a, int* minValue) {
+    if (a.isEmpty()) { *minValue = 0; return 1; }
+    const auto range = std::minmax_element(a.begin(), a.end());
+    *minValue = *range.first;
+    quint32 span = static_cast<quint32>(static_cast<qint64>(*range.second) - *range.first);
+    int bits = 1;
+    while (bits < 32 && (span >> bits) != 0)
+        ++bits;
+    return bits;
+}
+
+inline quint32 digitOf(int value, int minValue, int shift, quint32 mask) {
+    return (static_cast<quint32>(static_cast<qint64>(value) - minValue) >> shift) & mask;
+}
+
+// 对 a[lo, hi) 按 shift 处的一位做一趟分配，结果写回 a；starts 返回各数字桶的起点（长度为基数 + 1）
+template <class Recorder>
+void distribute(QVector<int>& a, QVector<int>& buffer, int lo, int hi, int minValue, int shift, int bits,
+                QVector<int>& starts, Recorder& rec) {
+    const quint32 mask = (1u << bits) - 1;
+    const int radix = 1 << bits;
+
+    rec.record(TraceEvent::RadixRange, lo, hi);
+    rec.record(TraceEvent::RadixPass, shift, bits);
+
+    starts.fill(0, radix + 1);
+    for (int i = lo; i < hi; ++i) {
+        quint32 d = digitOf(a[i], minValue, shift, mask);
+        ++starts[d + 1];
+        rec.record(TraceEvent::RadixCount, i, static_cast<int>(d));
+    }
+
+    rec.record(TraceEvent::RadixPrefix);
+    starts[0] = lo;
+    for (int d = 0; d < radix; ++d)
+        starts[d + 1] += starts[d];
+
+    // 散射保持同一数字内的相对顺序（稳定），LSD 的正确性依赖于此
+    QVector<int> next = starts;
+    for (int i = lo; i < hi; ++i) {
+        quint32 d = digitOf(a[i], minValue, shift, mask);
+        int dest = next[d]++;
+        buffer[dest] = a[i];
+        rec.record(TraceEvent::RadixScatter, i, dest, static_cast<int>(d));
+    }
+    std::copy(buffer.begin() + lo, buffer.begin() + hi, a.begin() + lo);
+    rec.record(TraceEvent::RadixDone);
+}
+
+// 从最低位开始逐趟分配，趟数由数据的实际位宽决定
+template <class Recorder>
+void lsd(QVector<int>& a, int bits, Recorder& rec) {
+    bits = qBound(MinBits, bits, MaxBits);
+    int minValue;
+    const int totalBits = keyBits(a, &minValue);
+    QVector<int> buffer(a.size());
+    QVector<int> starts;
+    for (int shift = 0; shift < totalBits && !rec.truncated(); shift += bits)
+        distribute(a, buffer, 0, a.size(), minValue, shift, bits, starts, rec);
+    rec.record(TraceEvent::SortFinished);
+}
+
+// 从最高位开始分配，再对每个含两个以上元素的桶处理下一位；显式栈代替递归，按从左到右的顺序处理子区间
+template <class Recorder>
+void msd(QVector<int>& a, int bits, Recorder& rec) {
+    bits = qBound(MinBits, bits, MaxBits);
+    int minValue;
+    const int totalBits = keyBits(a, &minValue);
+    const int radix = 1 << bits;
+    QVector<int> buffer(a.size());
+    QVector<int> starts;
+
+    struct Range { int lo, hi, shift; };
+    QVector<Range> stack;
+    stack.append(Range{0, a.size(), (totalBits - 1) / bits * bits});
+    while (!stack.isEmpty() && !rec.truncated()) {
+        Range range = stack.last();
+        stack.removeLast();
+        if (range.hi - range.lo < 2) continue;
+
+        distribute(a, buffer, range.lo, range.hi, minValue, range.shift, bits, starts, rec);
+        if (range.shift == 0) continue;
+        for (int d = radix - 1; d >= 0; --d) {
+            if (starts[d + 1] - starts[d] >= 2)
+                stack.append(Range{starts[d], starts[d + 1], range.shift - bits});
+        }
+    }
+    rec.record(TraceEvent::SortFinished);
+}
+
+}
+
+#endif // RADIXSORT_H
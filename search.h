@@ -0,0 +1,223 @@
+#ifndef SEARCH_H
+#define SEARCH_H
+
+#include "sorttrace.h"
+#include <QString>
+#include <QVector>
+#include <QRandomGenerator>
+#include <algorithm>
+#include <climits>
+
+// 有序数组上的四种查找，共用 RANGE l r mid / FOUND_INDEX / NOT_FOUND 协议：每次探查记录当前候选区间与探查位置
+//   Binary         折半：取区间中点
+//   Interpolation  插值：按目标值在 a[l]…a[r] 间的比例估计位置，均匀分布时约 log log n 次，偏斜分布可退化到 n 次
+//   Exponential    指数（galloping）：探查 0、1、2、4…直到越过目标，再在最后一段折半；目标靠前时只需 2 log i 次
+//   Fibonacci      斐波那契：按斐波那契数划分区间，只用加减法，探查点偏向区间前部
+// 与其他引擎一样以模板接收记录器，批量统计时传入 ProbeCounter
+namespace Search {
+
+enum Method {
+    Binary,
+    Interpolation,
+    Exponential,
+    Fibonacci
+};
+
+const int MethodCount = 4;
+const int BatchQueries = 10000;            // 批量查询次数
+const qint64 BatchProbeBudget = 20000000;  // 每种方法的探查总数上限，防止插值查找在偏斜数据上退化时界面卡住
+
+inline QString methodName(Method method) {
+    switch (method) {
+    case Binary:        return "折半查找";
+    case Interpolation: return "插值查找";
+    case Exponential:   return "指数查找";
+    case Fibonacci:     return "斐波那契查找";
+    }
+    return QString();
+}
+
+// 只统计探查次数的记录器
+struct ProbeCounter {
+    qint64 probes = 0;
+    void record(TraceEvent::Op op, int = 0, int = 0, int = 0) {
+        if (op == TraceEvent::Range) ++probes;
+    }
+    bool truncated() const { return false; }
+};
+
+// 在 [left, right] 内折半，供折半查找与指数查找的第二阶段使用
+template <class Recorder>
+int bisect(const QVector<int>& a, int left, int right, int target, Recorder& rec) {
+    while (left <= right) {
+        const int mid = left + (right - left) / 2;
+        rec.record(TraceEvent::Range, left, right, mid);
+        if (a[mid] == target) {
+            rec.record(TraceEvent::FoundIndex, mid);
+            return mid;
+        }
+        if (a[mid] < target)
+            left = mid + 1;
+        else
+            right = mid - 1;
+    }
+    rec.record(TraceEvent::NotFound, target);
+    return -1;
+}
+
+template <class Recorder>
+int interpolation(const QVector<int>& a, int target, Recorder& rec) {
+    int left = 0;
+    int right = a.size() - 1;
+    while (left <= right && target >= a[left] && target <= a[right]) {
+        // 64 位计算比例，避免键差与区间长度相乘溢出
+        const qint64 span = static_cast<qint64>(a[right]) - a[left];
+        const int mid = span == 0 ? left
+                      : left + static_cast<int>((static_cast<qint64>(target) - a[left]) * (right - left) / span);
+        rec.record(TraceEvent::Range, left, right, mid);
+        if (a[mid] == target) {
+            rec.record(TraceEvent::FoundIndex, mid);
+            return mid;
+        }
+        if (a[mid] < target)
+            left = mid + 1;
+        else
+            right = mid - 1;
+    }
+    rec.record(TraceEvent::NotFound, target);
+    return -1;
+}
+
+template <class Recorder>
+int exponential(const QVector<int>& a, int target, Recorder& rec) {
+    const int n = a.size();
+    if (n == 0) {
+        rec.record(TraceEvent::NotFound, target);
+        return -1;
+    }
+    rec.record(TraceEvent::Range, 0, n - 1, 0);
+    if (a[0] == target) {
+        rec.record(TraceEvent::FoundIndex, 0);
+        return 0;
+    }
+    if (a[0] > target) {
+        rec.record(TraceEvent::NotFound, target);
+        return -1;
+    }
+
+    // 已知 a[bound / 2] < target，候选区间为 (bound / 2, n - 1]
+    int bound = 1;
+    while (bound < n) {
+        rec.record(TraceEvent::Range, bound / 2 + 1, n - 1, bound);
+        if (a[bound] == target) {
+            rec.record(TraceEvent::FoundIndex, bound);
+            return bound;
+        }
+        if (a[bound] > target) break;
+        bound = bound > n / 2 ? n : bound * 2;
+    }
+    return bisect(a, bound / 2 + 1, std::min(bound, n) - 1, target, rec);
+}
+
+template <class Recorder>
+int fibonacci(const QVector<int>& a, int target, Recorder& rec) {
+    const int n = a.size();
+    // fib 为不小于 n 的最小斐波那契数，fib1、fib2 为它前面两项
+    int fib2 = 0;
+    int fib1 = 1;
+    int fib = 1;
+    while (fib < n) {
+        fib2 = fib1;
+        fib1 = fib;
+        fib = fib1 + fib2;
+    }
+
+    // 候选区间为 [offset + 1, offset + fib]，在 offset + fib2 处探查
+    int offset = -1;
+    while (fib > 1) {
+        const int i = std::min(offset + fib2, n - 1);
+        rec.record(TraceEvent::Range, offset + 1, std::min(offset + fib, n - 1), i);
+        if (a[i] == target) {
+            rec.record(TraceEvent::FoundIndex, i);
+            return i;
+        }
+        if (a[i] < target) {
+            if (i == n - 1) break;           // 探查点被截到末尾且仍小于目标
+            // 去掉前 fib2 个，区间长度降为 fib1
+            fib = fib1;
+            fib1 = fib2;
+            fib2 = fib - fib1;
+            offset = i;
+        } else {
+            // 只保留前 fib2 个
+            fib = fib2;
+            fib1 = fib1 - fib2;
+            fib2 = fib - fib1;
+        }
+    }
+    if (fib == 1 && offset + 1 < n) {
+        rec.record(TraceEvent::Range, offset + 1, offset + 1, offset + 1);
+        if (a[offset + 1] == target) {
+            rec.record(TraceEvent::FoundIndex, offset + 1);
+            return offset + 1;
+        }
+    }
+    rec.record(TraceEvent::NotFound, target);
+    return -1;
+}
+
+// a 须已升序；找到时返回某个等于 target 的下标，否则返回 -1
+template <class Recorder>
+int find(const QVector<int>& a, int target, Method method, Recorder& rec) {
+    switch (method) {
+    case Binary:        return bisect(a, 0, a.size() - 1, target, rec);
+    case Interpolation: return interpolation(a, target, rec);
+    case Exponential:   return exponential(a, target, rec);
+    case Fibonacci:     return fibonacci(a, target, rec);
+    }
+    return -1;
+}
+
+// 批量查询的目标：约四分之三取自数组，其余在键的取值范围内均匀选取（多数不存在）
+inline QVector<int> batchQueries(const QVector<int>& sorted, int count, quint32 seed) {
+    QVector<int> queries;
+    if (sorted.isEmpty()) return queries;
+    queries.reserve(count);
+    QRandomGenerator rng(seed);
+    const qint64 low = static_cast<qint64>(sorted.first()) - 1;
+    const qint64 high = static_cast<qint64>(sorted.last()) + 1;
+    for (int q = 0; q < count; ++q) {
+        if (rng.bounded(4) != 0)
+            queries.append(sorted[rng.bounded(sorted.size())]);
+        else
+            queries.append(static_cast<int>(qBound<qint64>(INT_MIN, low + static_cast<qint64>(rng.generateDouble() * (high - low + 1)), INT_MAX)));
+    }
+    return queries;
+}
+
+struct BatchStats {
+    int queries = 0;             // 实际完成的查询数，超出探查预算时少于请求数
+    int found = 0;
+    qint64 probes = 0;
+    qint64 maxProbes = 0;
+
+    double averageProbes() const { return queries > 0 ? static_cast<double>(probes) / queries : 0; }
+};
+
+inline BatchStats batch(const QVector<int>& sorted, const QVector<int>& queries, Method method) {
+    BatchStats stats;
+    for (int target : queries) {
+        if (stats.probes >= BatchProbeBudget) break;
+        ProbeCounter counter;
+        if (find(sorted, target, method, counter) >= 0)
+            ++stats.found;
+        ++stats.queries;
+        stats.probes += counter.probes;
+        stats.maxProbes = std::max(stats.maxProbes, counter.probes);
+    }
+    return stats;
+}
+
+}
+
+#endif // SEARCH_H
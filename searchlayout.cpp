@@ -0,0 +1,109 @@
+#include "searchlayout.h"
+#include "radixsort.h"
+#include <QElapsedTimer>
+#include <QRandomGenerator>
+
+namespace SearchLayout {
+
+static volatile qint64 s_sink;   // 接收查找结果，防止计时循环被整体优化掉
+
+QString kindName(Kind kind) {
+    switch (kind) {
+    case Sorted:    return "有序数组";
+    case Eytzinger: return "Eytzinger";
+    case BTree:     return "B 树分块";
+    }
+    return QString();
+}
+
+Layout::Layout(Kind kind, const int* sorted, qint64 n, bool withRanks)
+    : m_kind(kind), m_n(n), m_slots(0), m_memory(nullptr) {
+    switch (kind) {
+    case Sorted:    m_slots = n; break;
+    case Eytzinger: m_slots = n + 1; break;          // 下标 0 不用
+    case BTree:     m_slots = (n + KeysPerLine - 1) / KeysPerLine * KeysPerLine; break;
+    }
+
+    m_storage.reset(new char[m_slots * sizeof(int) + LineBytes]);
+    const quintptr address = reinterpret_cast<quintptr>(m_storage.get());
+    m_memory = reinterpret_cast<int*>((address + LineBytes - 1) / LineBytes * LineBytes);
+    if (withRanks)
+        m_ranks.fill(-1, static_cast<int>(m_slots));
+
+    qint64 next = 0;
+    switch (kind) {
+    case Sorted:
+        for (qint64 i = 0; i < n; ++i) {
+            m_memory[i] = sorted[i];
+            if (withRanks) m_ranks[i] = static_cast<int>(i);
+        }
+        break;
+    case Eytzinger:
+        m_memory[0] = INT_MIN;
+        buildEytzinger(1, sorted, &next);
+        break;
+    case BTree:
+        buildBTree(0, sorted, &next);
+        break;
+    }
+}
+
+qint64 Layout::rankAt(qint64 pos) const {
+    if (pos < 0 || pos >= m_ranks.size()) return -1;
+    return m_ranks[pos];
+}
+
+// 中序遍历隐式二叉树，依次填入有序键
+void Layout::buildEytzinger(qint64 k, const int* sorted, qint64* next) {
+    if (k > m_n) return;
+    buildEytzinger(2 * k, sorted, next);
+    if (!m_ranks.isEmpty()) m_ranks[k] = static_cast<int>(*next);
+    m_memory[k] = sorted[(*next)++];
+    buildEytzinger(2 * k + 1, sorted, next);
+}
+
+// 中序遍历隐式 B 树：第 i 个键之前先填第 i 个孩子；最后一个节点不满时用 INT_MAX 填充
+void Layout::buildBTree(qint64 k, const int* sorted, qint64* next) {
+    const qint64 blocks = m_slots / KeysPerLine;
+    if (k >= blocks) return;
+    for (int i = 0; i < KeysPerLine; ++i) {
+        buildBTree(k * (KeysPerLine + 1) + i + 1, sorted, next);
+        const qint64 pos = k * KeysPerLine + i;
+        if (*next < m_n) {
+            if (!m_ranks.isEmpty()) m_ranks[pos] = static_cast<int>(*next);
+            m_memory[pos] = sorted[(*next)++];
+        } else {
+            m_memory[pos] = INT_MAX;
+        }
+    }
+    buildBTree(k * (KeysPerLine + 1) + KeysPerLine + 1, sorted, next);
+}
+
+double nanosPerLookup(Kind kind, qint64 n, int lookups, quint32 seed) {
+    QVector<int> queries;
+    queries.reserve(lookups);
+    QRandomGenerator rng(seed);
+    for (int i = 0; i < lookups; ++i)
+        queries.append(static_cast<int>(rng.bounded(static_cast<quint32>(2 * n + 2))));
+
+    // 有序源数组只在构建期间存在，峰值内存约为布局本身的两倍
+    std::unique_ptr<Layout> layout;
+    {
+        std::unique_ptr<int[]> sorted(new int[n]);
+        for (qint64 i = 0; i < n; ++i)
+            sorted[i] = static_cast<int>(2 * i + 1);
+        layout.reset(new Layout(kind, sorted.get(), n));
+    }
+
+    RadixSort::NullRecorder rec;
+    qint64 checksum = 0;
+    QElapsedTimer timer;
+    timer.start();
+    for (int q : queries)
+        checksum += layout->lowerBound(q, rec);
+    const qint64 elapsed = timer.nsecsElapsed();
+    s_sink = checksum;
+    return lookups > 0 ? static_cast<double>(elapsed) / lookups : 0;
+}
+
+}
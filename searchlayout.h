@@ -0,0 +1,143 @@
+#ifndef SEARCHLAYOUT_H
+#define SEARCHLAYOUT_H
+
+#include "sorttrace.h"
+#include <QString>
+#include <QVector>
+#include <climits>
+#include <memory>
+
+// 同一组有序键的三种内存布局与无分支查找：
+//   Sorted     有序数组上的无分支折半查找，预取下一步可能访问的两个位置
+//   Eytzinger  按宽度优先顺序存放的隐式二叉树（下标从 1 开始），预取四层之后的 16 个后代——恰好一条缓存行
+//   BTree      每个节点 16 个键占满一条缓存行、17 个孩子的隐式 B 树，节点内统计“小于目标的键数”而不做分支
+// 查找都返回第一个不小于目标的键在内存中的位置，没有时返回 -1；探查通过模板记录器输出 LAYOUT_PROBE 事件，
+// 计时时传入 RadixSort::NullRecorder，记录调用被完全内联消除
+namespace SearchLayout {
+
+enum Kind {
+    Sorted,
+    Eytzinger,
+    BTree
+};
+
+const int KindCount = 3;
+const int LineBytes = 64;                              // 缓存行字节数
+const int KeysPerLine = LineBytes / sizeof(int);       // 一条缓存行的键数，也是 B 树节点的键数
+const int TraceQueries = 8;                            // 轨迹中的查询次数
+
+QString kindName(Kind kind);
+
+inline void prefetch(const int* base, qint64 index) {
+#if defined(__GNUC__)
+    // 预取可能越过数组末尾，按整数地址计算以免越界的指针运算
+    __builtin_prefetch(reinterpret_cast<const void*>(reinterpret_cast<quintptr>(base) + index * sizeof(int)));
+#else
+    Q_UNUSED(base);
+    Q_UNUSED(index);
+#endif
+}
+
+// 最低位起连续 1 的个数
+inline int trailingOnes(quint64 k) {
+#if defined(__GNUC__)
+    return ~k ? __builtin_ctzll(~k) : 64;
+#else
+    int count = 0;
+    while (k & 1) {
+        k >>= 1;
+        ++count;
+    }
+    return count;
+#endif
+}
+
+class Layout {
+public:
+    // withRanks 为真时另存每个内存位置对应的有序下标（填充位置为 -1），供轨迹与可视化使用；计时时不需要
+    Layout(Kind kind, const int* sorted, qint64 n, bool withRanks = false);
+
+    Kind kind() const { return m_kind; }
+    qint64 size() const { return m_n; }
+    qint64 memorySize() const { return m_slots; }        // 含填充的槽位数
+    const int* memory() const { return m_memory; }
+    qint64 rankAt(qint64 pos) const;                     // 内存位置对应的有序下标，填充位置为 -1
+
+    template <class Recorder>
+    qint64 lowerBound(int x, Recorder& rec) const {
+        switch (m_kind) {
+        case Sorted:    return lowerBoundSorted(x, rec);
+        case Eytzinger: return lowerBoundEytzinger(x, rec);
+        case BTree:     return lowerBoundBTree(x, rec);
+        }
+        return -1;
+    }
+
+private:
+    template <class Recorder>
+    qint64 lowerBoundSorted(int x, Recorder& rec) const {
+        if (m_n == 0) return -1;
+        const int* base = m_memory;
+        qint64 length = m_n;
+        while (length > 1) {
+            const qint64 half = length / 2;
+            length -= half;
+            prefetch(base, length / 2 - 1);
+            prefetch(base, half + length / 2 - 1);
+            rec.record(TraceEvent::LayoutProbe, Sorted, static_cast<int>(base - m_memory + half - 1));
+            base += (base[half - 1] < x) * half;         // 乘法代替分支，编译为条件传送
+        }
+        rec.record(TraceEvent::LayoutProbe, Sorted, static_cast<int>(base - m_memory));
+        const qint64 pos = (base - m_memory) + (*base < x);
+        return pos < m_n ? pos : -1;
+    }
+
+    template <class Recorder>
+    qint64 lowerBoundEytzinger(int x, Recorder& rec) const {
+        quint64 k = 1;
+        while (k <= static_cast<quint64>(m_n)) {
+            prefetch(m_memory, static_cast<qint64>(k) * KeysPerLine);
+            rec.record(TraceEvent::LayoutProbe, Eytzinger, static_cast<int>(k));
+            k = 2 * k + (m_memory[k] < x);
+        }
+        // 最后一次向左走的位置即答案：去掉末尾连续的“向右”与那一次“向左”
+        k >>= trailingOnes(k) + 1;
+        return k == 0 ? -1 : static_cast<qint64>(k);
+    }
+
+    template <class Recorder>
+    qint64 lowerBoundBTree(int x, Recorder& rec) const {
+        const qint64 blocks = m_slots / KeysPerLine;
+        qint64 k = 0;
+        qint64 result = -1;
+        while (k < blocks) {
+            const int* node = m_memory + k * KeysPerLine;
+            int i = 0;
+            for (int j = 0; j < KeysPerLine; ++j)
+                i += node[j] < x;                        // 固定 16 次比较，可被向量化
+            rec.record(TraceEvent::LayoutProbe, BTree, static_cast<int>(k * KeysPerLine + qMin(i, KeysPerLine - 1)));
+            if (i < KeysPerLine)
+                result = k * KeysPerLine + i;
+            k = k * (KeysPerLine + 1) + i + 1;
+        }
+        // 填充键为 INT_MAX，落在填充上说明不存在
+        return result >= 0 && !m_ranks.isEmpty() && m_ranks[result] < 0 ? -1 : result;
+    }
+
+    void buildEytzinger(qint64 k, const int* sorted, qint64* next);
+    void buildBTree(qint64 k, const int* sorted, qint64* next);
+
+    Kind m_kind;
+    qint64 m_n;
+    qint64 m_slots;
+    std::unique_ptr<char[]> m_storage;                   // 多分配一条缓存行用于对齐
+    int* m_memory;                                       // 按缓存行对齐
+    QVector<int> m_ranks;
+};
+
+// 对 1…2n 中的奇数键构建的布局做 lookups 次随机查找，返回每次查找的平均纳秒数；内存不足时抛出 std::bad_alloc
+double nanosPerLookup(Kind kind, qint64 n, int lookups, quint32 seed);
+
+}
+
+#endif // SEARCHLAYOUT_H
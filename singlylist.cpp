@@ -7,13 +7,13 @@ SinglyLinkedList::~SinglyLinkedList() {
 }
 
 void SinglyLinkedList::insertAtHead(int value) {
-    SinglyListNode *newNode = new SinglyListNode(value);
+    SinglyListNode *newNode = pool.create(value);
     newNode->next = head;
     head = newNode;
 }
 
 void SinglyLinkedList::insertAtTail(int value) {
-    SinglyListNode *newNode = new SinglyListNode(value);
+    SinglyListNode *newNode = pool.create(value);
     if (!head) {
         head = newNode;
         return;
@@ -40,7 +40,7 @@ void SinglyLinkedList::deleteValue(int value) {
         prev->next = curr->next;
     }
 
-    delete curr;
+    pool.destroy(curr);
 }
 
 bool SinglyLinkedList::find(int value) const {
@@ -55,11 +55,8 @@ bool SinglyLinkedList::find(int value) const {
 
 
 void SinglyLinkedList::clear() {
-    while (head) {
-        SinglyListNode *temp = head;
-        head = head->next;
-        delete temp;
-    }
+    pool.release();
+    head = nullptr;
 }
 
 SinglyListNode* SinglyLinkedList::getHead() const {
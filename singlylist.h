@@ -1,6 +1,7 @@
 #ifndef SINGLYLINKEDLIST_H
 #define SINGLYLINKEDLIST_H
 
+#include "nodepool.h"
 #include <QList>
 
 struct SinglyListNode {
@@ -25,6 +26,7 @@ public:
 
 private:
     SinglyListNode *head;
+    NodePool<SinglyListNode> pool;
 };
 
 #endif // SINGLYLINKEDLIST_H
@@ -0,0 +1,353 @@
+#include "sorttrace.h"
+#include "radixsort.h"
+#include "introsort.h"
+#include "heapsort.h"
+#include "parallelsort.h"
+#include "search.h"
+#include "searchlayout.h"
+#include <QPair>
+#include <QRandomGenerator>
+#include <QtMath>
+#include <algorithm>
+
+QString TraceEvent::toString() const {
+    switch (op) {
+    case Insert:       return QString("INSERT %1").arg(a);
+    case Compare:      return QString("COMPARE %1 %2").arg(a).arg(b);
+    case CompareA:     return QString("COMPARE_A %1 %2").arg(a).arg(b);
+    case CompareB:     return QString("COMPARE_B %1 %2").arg(a).arg(b);
+    case Pivot:        return QString("PIVOT %1 %2").arg(a).arg(b);
+    case Swap:         return QString("SWAP %1 %2").arg(a).arg(b);
+    case MarkSorted:   return QString("MARK_SORTED %1").arg(a);
+    case ExtractMax:   return QString("EXTRACT_MAX %1").arg(a);
+    case SortFinished: return QString("SORT_FINISHED");
+    case BucketInit:   return QString("BUCKET_INIT %1").arg(a);
+    case BucketRange:  return QString("BUCKET_RANGE %1 %2 %3").arg(a).arg(b).arg(c);
+    case BucketAssign: return QString("BUCKET_ASSIGN %1 %2").arg(a).arg(b);
+    case BucketSwap:   return QString("SWAP %1 %2 %3").arg(a).arg(b).arg(c);
+    case FinalOutput:  return QString("FINAL_OUTPUT %1").arg(a);
+    case Range:        return QString("RANGE %1 %2 %3").arg(a).arg(b).arg(c);
+    case FoundIndex:   return QString("FOUND_INDEX %1").arg(a);
+    case NotFound:     return QString("NOT_FOUND %1").arg(a);
+    case RadixRange:   return QString("RADIX_RANGE %1 %2").arg(a).arg(b);
+    case RadixPass:    return QString("RADIX_PASS %1 %2").arg(a).arg(b);
+    case RadixCount:   return QString("RADIX_COUNT %1 %2").arg(a).arg(b);
+    case RadixPrefix:  return QString("RADIX_PREFIX");
+    case RadixScatter: return QString("RADIX_SCATTER %1 %2 %3").arg(a).arg(b).arg(c);
+    case RadixDone:    return QString("RADIX_DONE");
+    case HeapFallback: return QString("HEAP_FALLBACK %1 %2").arg(a).arg(b);
+    case Heapify:      return QString("HEAPIFY %1 %2").arg(a).arg(b);
+    case SiftUp:       return QString("SIFT_UP %1").arg(a);
+    case SiftDown:     return QString("SIFT_DOWN %1 %2").arg(a).arg(b);
+    case ParallelInit: return QString("PAR_INIT %1 %2").arg(a).arg(b);
+    case ParallelTask: return QString("PAR_TASK %1 %2 %3").arg(a).arg(b).arg(c);
+    case ParallelIdle: return QString("PAR_IDLE %1").arg(a);
+    case ParallelWrite: return QString("PAR_WRITE %1 %2 %3").arg(a).arg(b).arg(c);
+    case ParallelSteal: return QString("PAR_STEAL %1 %2").arg(a).arg(b);
+    case LayoutQuery:  return QString("LAYOUT_QUERY %1").arg(a);
+    case LayoutProbe:  return QString("LAYOUT_PROBE %1 %2").arg(a).arg(b);
+    case LayoutResult: return QString("LAYOUT_RESULT %1 %2 %3").arg(a).arg(b).arg(c);
+    }
+    return QString();
+}
+
+namespace {
+
+// 带上限的事件记录器，超过上限后丢弃事件，算法在 truncated() 后尽早退出
+class TraceRecorder {
+public:
+    TraceRecorder(QVector<TraceEvent>* events, int limit)
+        : m_events(events), m_limit(limit), m_truncated(false) {}
+
+    void record(TraceEvent::Op op, int a = 0, int b = 0, int c = 0) {
+        if (m_events->size() < m_limit)
+            m_events->append(TraceEvent{op, a, b, c});
+        else
+            m_truncated = true;
+    }
+
+    bool truncated() const { return m_truncated; }
+
+private:
+    QVector<TraceEvent>* m_events;
+    int m_limit;
+    bool m_truncated;
+};
+
+void recordInput(const QVector<int>& a, TraceRecorder& rec) {
+    for (int v : a)
+        rec.record(TraceEvent::Insert, v);
+}
+
+void bubbleSort(QVector<int> a, TraceRecorder& rec) {
+    const int n = a.size();
+    for (int i = 0; i < n - 1 && !rec.truncated(); ++i) {
+        bool swapped = false;
+        for (int j = 0; j < n - 1 - i; ++j) {
+            rec.record(TraceEvent::Compare, j, j + 1);
+            if (a[j] > a[j + 1]) {
+                std::swap(a[j], a[j + 1]);
+                rec.record(TraceEvent::Swap, j, j + 1);
+                swapped = true;
+            }
+        }
+        rec.record(TraceEvent::MarkSorted, n - 1 - i);
+        if (!swapped) {
+            // 本轮没有交换，剩余部分已经有序
+            for (int k = n - 2 - i; k > 0; --k)
+                rec.record(TraceEvent::MarkSorted, k);
+            break;
+        }
+    }
+    if (n > 0)
+        rec.record(TraceEvent::MarkSorted, 0);
+}
+
+void quickSort(QVector<int> a, TraceRecorder& rec) {
+    // 显式栈代替递归，有序输入退化为 O(n) 深度时也不会栈溢出
+    QVector<QPair<int, int>> ranges;
+    ranges.append(qMakePair(0, a.size() - 1));
+
+    while (!ranges.isEmpty() && !rec.truncated()) {
+        const int lo = ranges.last().first;
+        const int hi = ranges.last().second;
+        ranges.removeLast();
+        if (lo > hi) continue;
+        if (lo == hi) {
+            rec.record(TraceEvent::MarkSorted, lo);
+            continue;
+        }
+
+        const int pivot = a[lo];
+        rec.record(TraceEvent::Pivot, lo, pivot);
+
+        int i = lo + 1;
+        int j = hi;
+        while (true) {
+            while (i <= j) {
+                rec.record(TraceEvent::CompareA, i, lo);
+                if (a[i] > pivot) break;
+                ++i;
+            }
+            while (i <= j) {
+                rec.record(TraceEvent::CompareB, j, lo);
+                if (a[j] <= pivot) break;
+                --j;
+            }
+            if (i >= j) break;
+            std::swap(a[i], a[j]);
+            rec.record(TraceEvent::Swap, i, j);
+            ++i;
+            --j;
+        }
+
+        // 主元归位
+        if (j != lo) {
+            std::swap(a[lo], a[j]);
+            rec.record(TraceEvent::Swap, lo, j);
+        }
+        rec.record(TraceEvent::MarkSorted, j);
+
+        ranges.append(qMakePair(j + 1, hi));
+        ranges.append(qMakePair(lo, j - 1));
+    }
+}
+
+// 按样本分位数确定桶的上界：偏斜分布下各桶元素数仍大致相等
+// 返回严格递增的上界序列，最后一个上界不小于最大值
+QVector<int> bucketBounds(const QVector<int>& a) {
+    const int n = a.size();
+    const int wanted = qBound(1, qRound(qSqrt(n)), SortTrace::MaxBuckets);
+
+    // 等距抽样，避免对整个输入排序
+    const int sampleSize = qMin(n, wanted * SortTrace::BucketSampleFactor);
+    QVector<int> sample;
+    sample.reserve(sampleSize);
+    for (int i = 0; i < sampleSize; ++i)
+        sample.append(a[static_cast<int>(static_cast<qint64>(i) * n / sampleSize)]);
+    std::sort(sample.begin(), sample.end());
+
+    QVector<int> bounds;
+    for (int b = 1; b < wanted; ++b) {
+        int bound = sample[b * sampleSize / wanted - 1];
+        // 重复值只能落入同一个桶，相同的分位数合并
+        if (bounds.isEmpty() || bound > bounds.last())
+            bounds.append(bound);
+    }
+    const int maxValue = *std::max_element(a.begin(), a.end());
+    if (bounds.isEmpty() || maxValue > bounds.last())
+        bounds.append(maxValue);
+    return bounds;
+}
+
+void bucketSort(const QVector<int>& a, TraceRecorder& rec) {
+    if (a.isEmpty()) return;
+
+    const QVector<int> bounds = bucketBounds(a);
+    const int minValue = *std::min_element(a.begin(), a.end());
+    rec.record(TraceEvent::BucketInit, bounds.size());
+    for (int b = 0; b < bounds.size(); ++b)
+        rec.record(TraceEvent::BucketRange, b, b == 0 ? minValue : bounds[b - 1] + 1, bounds[b]);
+
+    QVector<QVector<int>> buckets(bounds.size());
+    for (int v : a) {
+        int b = static_cast<int>(std::lower_bound(bounds.begin(), bounds.end(), v) - bounds.begin());
+        buckets[b].append(v);
+        rec.record(TraceEvent::BucketAssign, v, b);
+    }
+
+    // 桶内冒泡排序
+    for (int b = 0; b < buckets.size() && !rec.truncated(); ++b) {
+        QVector<int>& bucket = buckets[b];
+        for (int i = 0; i < bucket.size() - 1; ++i) {
+            for (int j = 0; j < bucket.size() - 1 - i; ++j) {
+                if (bucket[j] > bucket[j + 1]) {
+                    std::swap(bucket[j], bucket[j + 1]);
+                    rec.record(TraceEvent::BucketSwap, j, j + 1, b);
+                }
+            }
+        }
+    }
+
+    for (const QVector<int>& bucket : buckets) {
+        for (int v : bucket)
+            rec.record(TraceEvent::FinalOutput, v);
+    }
+}
+
+// 四种查找共用：排序后按所选方法探查；数组可达百万元素，不逐个输出 INSERT，由调用方整体载入
+void searchSorted(QVector<int> a, int target, Search::Method method, TraceRecorder& rec) {
+    std::sort(a.begin(), a.end());
+    Search::find(a, target, method, rec);
+}
+
+Search::Method searchMethod(SortTrace::Algorithm algorithm) {
+    switch (algorithm) {
+    case SortTrace::InterpolationSearch: return Search::Interpolation;
+    case SortTrace::ExponentialSearch:   return Search::Exponential;
+    case SortTrace::FibonacciSearch:     return Search::Fibonacci;
+    default:                             return Search::Binary;
+    }
+}
+
+// 同一组查询依次在三种布局上执行；目标大多取自数据集，少数取某个键加一，通常落在两个键之间或最大键之后
+void layoutSearch(QVector<int> a, quint32 seed, TraceRecorder& rec) {
+    std::sort(a.begin(), a.end());
+    recordInput(a, rec);
+    if (a.isEmpty()) return;
+
+    QVector<SearchLayout::Layout*> layouts;
+    for (int k = 0; k < SearchLayout::KindCount; ++k)
+        layouts.append(new SearchLayout::Layout(static_cast<SearchLayout::Kind>(k), a.constData(), a.size(), true));
+
+    QRandomGenerator rng(seed);
+    for (int q = 0; q < SearchLayout::TraceQueries && !rec.truncated(); ++q) {
+        const int pick = rng.bounded(a.size() + a.size() / 4 + 1);
+        int target = a[pick % a.size()];
+        if (pick >= a.size() && target < INT_MAX)
+            ++target;
+        rec.record(TraceEvent::LayoutQuery, target);
+        for (SearchLayout::Layout* layout : layouts) {
+            const qint64 pos = layout->lowerBound(target, rec);
+            rec.record(TraceEvent::LayoutResult, layout->kind(), static_cast<int>(pos), static_cast<int>(layout->rankAt(pos)));
+        }
+    }
+    qDeleteAll(layouts);
+    rec.record(TraceEvent::SortFinished);
+}
+
+}
+
+namespace SortTrace {
+
+bool algorithmForFile(const QString& filePath, Algorithm* algorithm) {
+    if (filePath == ":/codes/bubblesort.c")          *algorithm = Bubble;
+    else if (filePath == ":/codes/quicksort.c")      *algorithm = Quick;
+    else if (filePath == ":/codes/heapsort.c")       *algorithm = Heap;
+    else if (filePath == ":/codes/bucketsort.c")     *algorithm = Bucket;
+    else if (filePath == ":/codes/binarysearch.c")   *algorithm = BinarySearch;
+    else if (filePath == ":/codes/interpolationsearch.c") *algorithm = InterpolationSearch;
+    else if (filePath == ":/codes/exponentialsearch.c") *algorithm = ExponentialSearch;
+    else if (filePath == ":/codes/fibonaccisearch.c") *algorithm = FibonacciSearch;
+    else if (filePath == ":/codes/lsdradixsort.c")   *algorithm = RadixLSD;
+    else if (filePath == ":/codes/msdradixsort.c")   *algorithm = RadixMSD;
+    else if (filePath == ":/codes/introsort.c")      *algorithm = Intro;
+    else if (filePath == ":/codes/parallelmergesort.c") *algorithm = ParallelMerge;
+    else if (filePath == ":/codes/samplesort.c")     *algorithm = SampleSort;
+    else if (filePath == ":/codes/layoutsearch.c")   *algorithm = LayoutSearch;
+    else return false;
+    return true;
+}
+
+int maxElements(Algorithm algorithm) {
+    switch (algorithm) {
+    case Heap:         return 127;    // 七层完全二叉树；4 叉堆五层，8 叉堆四层
+    case Bucket:       return 4096;   // 约 64 个桶，桶内冒泡排序的事件数仍可控
+    case BinarySearch:
+    case InterpolationSearch:
+    case ExponentialSearch:
+    case FibonacciSearch: return 1 << 20; // 柱子窄于一个像素时按像素列绘制
+    case RadixLSD:
+    case RadixMSD:     return 8192;   // 桶道中逐格绘制
+    case ParallelMerge:
+    case SampleSort:   return 4096;   // 每个元素在每层归并都产生一次写入事件
+    case LayoutSearch: return 1024;   // 64 条缓存行，三种布局各一幅内存图
+    default:           return 20000;  // 柱状图单图元绘制
+    }
+}
+
+bool isSearch(Algorithm algorithm) {
+    return algorithm == BinarySearch || algorithm == InterpolationSearch
+        || algorithm == ExponentialSearch || algorithm == FibonacciSearch;
+}
+
+bool generate(Algorithm algorithm, const QVector<int>& input, QVector<TraceEvent>* events, int parameter, int eventLimit) {
+    events->clear();
+    TraceRecorder rec(events, eventLimit);
+    if (!isSearch(algorithm) && algorithm != LayoutSearch)
+        recordInput(input, rec);
+
+    switch (algorithm) {
+    case Bubble:       bubbleSort(input, rec);              break;
+    case Quick:        quickSort(input, rec);               break;
+    case Heap: {
+        QVector<int> a = input;
+        HeapSort::sort(a, HeapSort::decode(parameter), rec);
+        break;
+    }
+    case Bucket:       bucketSort(input, rec);              break;
+    case BinarySearch:
+    case InterpolationSearch:
+    case ExponentialSearch:
+    case FibonacciSearch: searchSorted(input, parameter, searchMethod(algorithm), rec); break;
+    case LayoutSearch: layoutSearch(input, static_cast<quint32>(parameter), rec); break;
+    case RadixLSD: {
+        QVector<int> a = input;
+        RadixSort::lsd(a, parameter, rec);
+        break;
+    }
+    case RadixMSD: {
+        QVector<int> a = input;
+        RadixSort::msd(a, parameter, rec);
+        break;
+    }
+    case Intro: {
+        QVector<int> a = input;
+        IntroSort::sort(a, IntroSort::decode(parameter), rec);
+        break;
+    }
+    case ParallelMerge:
+    case SampleSort: {
+        QVector<int> a = input;
+        const int workers = qBound(1, parameter, ParallelSort::MaxWorkers);
+        WorkStealingPool pool(workers);
+        ParallelSort::LockedRecorder<TraceRecorder> locked(rec);
+        ParallelSort::sort(algorithm == ParallelMerge ? ParallelSort::MergeSort : ParallelSort::SampleSort,
+                           a, pool, locked, ParallelSort::grainFor(a.size(), workers, ParallelSort::MinGrain));
+        break;
+    }
+    }
+    return !rec.truncated();
+}
+
+}
@@ -0,0 +1,94 @@
+#ifndef SORTTRACE_H
+#define SORTTRACE_H
+
+#include <QString>
+#include <QVector>
+
+// 一条排序/查找轨迹事件，与 codes/*.c 通过 printf 输出的指令一一对应
+struct TraceEvent {
+    enum Op : quint8 {
+        Insert,         // INSERT v
+        Compare,        // COMPARE i j
+        CompareA,       // COMPARE_A i pivotIdx
+        CompareB,       // COMPARE_B j pivotIdx
+        Pivot,          // PIVOT idx value
+        Swap,           // SWAP i j
+        MarkSorted,     // MARK_SORTED i
+        ExtractMax,     // EXTRACT_MAX last
+        SortFinished,   // SORT_FINISHED
+        BucketInit,     // BUCKET_INIT k
+        BucketRange,    // BUCKET_RANGE b low high
+        BucketAssign,   // BUCKET_ASSIGN v b
+        BucketSwap,     // SWAP i j b
+        FinalOutput,    // FINAL_OUTPUT v
+        Range,          // RANGE l r mid
+        FoundIndex,     // FOUND_INDEX i
+        NotFound,       // NOT_FOUND target
+        RadixRange,     // RADIX_RANGE lo hi        下一趟分配的区间 [lo, hi)
+        RadixPass,      // RADIX_PASS shift bits    开始一趟分配
+        RadixCount,     // RADIX_COUNT i d          直方图计数
+        RadixPrefix,    // RADIX_PREFIX             计算前缀和
+        RadixScatter,   // RADIX_SCATTER i dest d   散射到输出位置
+        RadixDone,      // RADIX_DONE               输出写回数组
+        HeapFallback,   // HEAP_FALLBACK lo hi      内省排序深度超限，区间改用堆排序
+        Heapify,        // HEAPIFY mode n           建堆开始，mode 为 HeapSort::Build（0 逐个插入，1 Floyd）
+        SiftUp,         // SIFT_UP i                位置 i 的元素开始上浮
+        SiftDown,       // SIFT_DOWN root size      从 root 开始下沉，堆的范围为 [0, size)
+        ParallelInit,   // PAR_INIT workers n       并行排序开始
+        ParallelTask,   // PAR_TASK w lo hi         工作者 w 开始（或恢复）处理区间 [lo, hi)
+        ParallelIdle,   // PAR_IDLE w               工作者 w 空闲或等待子任务
+        ParallelWrite,  // PAR_WRITE i v w          工作者 w 把 v 写入位置 i
+        ParallelSteal,  // PAR_STEAL w victim       工作者 w 从 victim 的队列窃取任务
+        LayoutQuery,    // LAYOUT_QUERY target      缓存友好查找：开始一次查询，三种布局依次执行
+        LayoutProbe,    // LAYOUT_PROBE layout pos  读取布局 layout（SearchLayout::Kind）内存位置 pos 的键
+        LayoutResult    // LAYOUT_RESULT layout pos rank  查找结果的内存位置与有序下标，不存在时均为 -1
+    };
+
+    Op op;
+    int a;
+    int b;
+    int c;
+
+    QString toString() const;   // 生成与 C 程序完全相同的输出行
+};
+
+// 排序与查找算法的进程内轨迹生成器：直接在 C++ 中运行算法并记录事件，无需 gcc/gdb 往返
+// 输入数组由 Dataset 生成或载入
+namespace SortTrace {
+
+enum Algorithm {
+    Bubble,
+    Quick,
+    Heap,
+    Bucket,
+    BinarySearch,
+    RadixLSD,
+    RadixMSD,
+    Intro,
+    ParallelMerge,
+    SampleSort,
+    LayoutSearch,
+    InterpolationSearch,
+    ExponentialSearch,
+    FibonacciSearch
+};
+
+const int DefaultEventLimit = 2000000;  // 事件数上限，防止 O(n²) 算法耗尽内存
+const int MaxBuckets = 256;             // 桶排序的最大桶数
+const int BucketSampleFactor = 32;      // 每个桶抽取的样本数，用于确定桶边界
+
+bool algorithmForFile(const QString& filePath, Algorithm* algorithm);
+int maxElements(Algorithm algorithm);   // 该算法可视化能容纳的最大元素个数
+bool isSearch(Algorithm algorithm);     // 折半、插值、指数、斐波那契查找共用查找视图与 RANGE / FOUND_INDEX 协议
+
+// 生成完整轨迹；事件数超过上限时截断并返回 false
+// 折半等四种查找的轨迹不含 INSERT 事件，调用方将排序后的输入整体交给可视化对象
+// parameter：折半等四种查找为查找目标（输入会先排序），堆排序为 HeapSort::encode 打包的叉数与建堆、下沉方式，
+// 基数排序为每趟位数，内省排序为 IntroSort::encode 打包的选项，
+// 并行排序为工作者个数（并行排序的事件交错顺序取决于线程调度，每次生成可能不同），缓存友好查找为查询目标的随机种子
+bool generate(Algorithm algorithm, const QVector<int>& input, QVector<TraceEvent>* events,
+              int parameter = 0, int eventLimit = DefaultEventLimit);
+
+}
+
+#endif // SORTTRACE_H
@@ -0,0 +1,191 @@
+#include "speedupdialog.h"
+#include <QHBoxLayout>
+#include <QVBoxLayout>
+#include <QCloseEvent>
+
+static const qreal kChartMargin = 36;
+
+SpeedupChart::SpeedupChart(QWidget* parent)
+    : QWidget(parent), m_maxWorkers(1) {
+    setMinimumSize(420, 280);
+}
+
+void SpeedupChart::setTimes(const QVector<double>& seconds, int maxWorkers) {
+    m_seconds = seconds;
+    m_maxWorkers = qMax(1, maxWorkers);
+    update();
+}
+
+void SpeedupChart::paintEvent(QPaintEvent* event) {
+    Q_UNUSED(event);
+    QPainter painter(this);
+    painter.setRenderHint(QPainter::Antialiasing);
+    painter.setFont(QFont("Segoe UI", 8));
+
+    const QRectF area = QRectF(rect()).adjusted(kChartMargin, 10, -10, -kChartMargin);
+    painter.setPen(QPen(QColor("#555555"), 1));
+    painter.drawLine(area.bottomLeft(), area.bottomRight());
+    painter.drawLine(area.bottomLeft(), area.topLeft());
+
+    // 两个坐标轴都从 1 到 P，理想加速比即对角线
+    const int maxWorkers = m_maxWorkers;
+    auto toPoint = [&](qreal workers, qreal speedup) {
+        const qreal span = qMax(1, maxWorkers - 1);
+        return QPointF(area.left() + area.width() * (workers - 1) / span,
+                       area.bottom() - area.height() * (speedup - 1) / span);
+    };
+
+    painter.setPen(QPen(QColor("#444444"), 1, Qt::DotLine));
+    for (int w = 1; w <= maxWorkers; ++w) {
+        QPointF p = toPoint(w, 1);
+        painter.drawLine(QPointF(p.x(), area.top()), QPointF(p.x(), area.bottom()));
+    }
+    painter.setPen(QColor("#ABB2BF"));
+    const int step = qMax(1, maxWorkers / 8);
+    for (int w = 1; w <= maxWorkers; w += step) {
+        QPointF p = toPoint(w, 1);
+        painter.drawText(QRectF(p.x() - 15, area.bottom() + 4, 30, 14), Qt::AlignCenter, QString::number(w));
+        QPointF q = toPoint(1, w);
+        painter.drawText(QRectF(0, q.y() - 7, area.left() - 4, 14), Qt::AlignRight | Qt::AlignVCenter,
+                         QString("%1×").arg(w));
+    }
+    painter.drawText(QRectF(area.left(), area.bottom() + 18, area.width(), 14), Qt::AlignCenter, "工作者数");
+
+    painter.setPen(QPen(QColor("#98C379"), 1, Qt::DashLine));
+    painter.drawLine(toPoint(1, 1), toPoint(maxWorkers, maxWorkers));
+
+    if (m_seconds.isEmpty() || m_seconds.first() <= 0) return;
+
+    // 加速比相对 1 个工作者的耗时，超出纵轴时截到顶部
+    QVector<QPointF> measured;
+    for (int i = 0; i < m_seconds.size(); ++i) {
+        qreal speedup = m_seconds[i] > 0 ? m_seconds.first() / m_seconds[i] : 0;
+        measured.append(toPoint(i + 1, qBound<qreal>(0, speedup, maxWorkers)));
+    }
+    painter.setPen(QPen(QColor("#E5C07B"), 2));
+    painter.drawPolyline(measured.constData(), measured.size());
+    painter.setBrush(QColor("#E5C07B"));
+    for (const QPointF& p : measured)
+        painter.drawEllipse(p, 3, 3);
+
+    painter.setPen(QPen(QColor("#98C379"), 1, Qt::DashLine));
+    painter.drawLine(QPointF(area.left() + 10, area.top() + 10), QPointF(area.left() + 30, area.top() + 10));
+    painter.setPen(QColor("#ABB2BF"));
+    painter.drawText(QPointF(area.left() + 36, area.top() + 14), "理想线性加速");
+}
+
+SpeedupDialog::SpeedupDialog(ParallelSort::Algorithm algorithm, const QVector<int>& input, QWidget* parent)
+    : QDialog(parent), m_algorithm(algorithm), m_input(input), m_thread(nullptr), m_worker(nullptr) {
+    setWindowTitle(QString("加速比：%1，N = %2")
+                   .arg(algorithm == ParallelSort::MergeSort ? "并行归并排序" : "并行样本排序")
+                   .arg(input.size()));
+    setStyleSheet("background-color:#333333; color:#ABB2BF;");
+
+    QString buttonStyle =
+        "QToolButton { background-color: transparent; border: none; padding: 3px; color:#ABB2BF; font-weight:bold; }"
+        "QToolButton:hover { background-color: rgba(255, 255, 255, 30); }"
+        "QToolButton:disabled { color:#666666; }";
+
+    QLabel* workersLabel = new QLabel("最多工作者");
+    m_workersSpinBox = new QSpinBox;
+    m_workersSpinBox->setRange(1, ParallelSort::MaxWorkers);
+    m_workersSpinBox->setValue(WorkStealingPool::maxWorkers());
+    m_workersSpinBox->setToolTip(QString("本机硬件线程数为 %1，超过后加速比通常不再增长").arg(WorkStealingPool::maxWorkers()));
+
+    QLabel* repeatsLabel = new QLabel("重复");
+    m_repeatsSpinBox = new QSpinBox;
+    m_repeatsSpinBox->setRange(1, 50);
+    m_repeatsSpinBox->setValue(3);
+    m_repeatsSpinBox->setToolTip("每个工作者数重复测量的次数，取中位数");
+
+    m_startButton = new QToolButton;
+    m_startButton->setText("开始");
+    m_startButton->setStyleSheet(buttonStyle);
+    m_stopButton = new QToolButton;
+    m_stopButton->setText("停止");
+    m_stopButton->setStyleSheet(buttonStyle);
+    m_stopButton->setEnabled(false);
+
+    QHBoxLayout* controls = new QHBoxLayout;
+    controls->addWidget(workersLabel);
+    controls->addWidget(m_workersSpinBox);
+    controls->addWidget(repeatsLabel);
+    controls->addWidget(m_repeatsSpinBox);
+    controls->addStretch();
+    controls->addWidget(m_startButton);
+    controls->addWidget(m_stopButton);
+
+    m_chart = new SpeedupChart;
+    m_resultLabel = new QLabel("数据集较小时调度开销占主导，建议 N ≥ 10^6");
+
+    QVBoxLayout* layout = new QVBoxLayout(this);
+    layout->addLayout(controls);
+    layout->addWidget(m_chart, 1);
+    layout->addWidget(m_resultLabel);
+
+    connect(m_startButton, &QToolButton::clicked, this, &SpeedupDialog::start);
+    connect(m_stopButton, &QToolButton::clicked, this, &SpeedupDialog::stop);
+}
+
+SpeedupDialog::~SpeedupDialog() {
+    stop();
+}
+
+void SpeedupDialog::closeEvent(QCloseEvent* event) {
+    stop();
+    QDialog::closeEvent(event);
+}
+
+void SpeedupDialog::start() {
+    if (m_thread) return;
+
+    m_seconds.clear();
+    m_chart->setTimes(m_seconds, m_workersSpinBox->value());
+    m_resultLabel->setText("测量中……");
+    m_startButton->setEnabled(false);
+    m_stopButton->setEnabled(true);
+    m_workersSpinBox->setEnabled(false);
+    m_repeatsSpinBox->setEnabled(false);
+
+    // 工作对象没有父对象，随线程结束一起释放
+    m_thread = new QThread;
+    m_worker = new SpeedupWorker(m_algorithm, m_input, m_workersSpinBox->value(), m_repeatsSpinBox->value());
+    m_worker->moveToThread(m_thread);
+    connect(m_thread, &QThread::started, m_worker, &SpeedupWorker::run);
+    connect(m_worker, &SpeedupWorker::finished, m_thread, &QThread::quit);
+    connect(m_thread, &QThread::finished, m_worker, &QObject::deleteLater);
+    connect(m_thread, &QThread::finished, m_thread, &QObject::deleteLater);
+    connect(m_worker, &SpeedupWorker::measured, this, &SpeedupDialog::onMeasured);
+    connect(m_worker, &SpeedupWorker::finished, this, &SpeedupDialog::onFinished);
+    m_thread->start();
+}
+
+void SpeedupDialog::stop() {
+    if (!m_thread) return;
+    m_worker->cancel();
+    m_thread->quit();
+    m_thread->wait();
+    // 线程已退出，deleteLater 由 finished 信号排入主线程事件队列
+    m_thread = nullptr;
+    m_worker = nullptr;
+    m_startButton->setEnabled(true);
+    m_stopButton->setEnabled(false);
+    m_workersSpinBox->setEnabled(true);
+    m_repeatsSpinBox->setEnabled(true);
+}
+
+void SpeedupDialog::onMeasured(int workers, double seconds) {
+    m_seconds.append(seconds);
+    m_chart->setTimes(m_seconds, m_workersSpinBox->value());
+
+    const double speedup = seconds > 0 ? m_seconds.first() / seconds : 0;
+    m_resultLabel->setText(QString("%1 个工作者：%2 s，加速比 %3×，并行效率 %4%")
+                           .arg(workers)
+                           .arg(seconds, 0, 'g', 3)
+                           .arg(speedup, 0, 'f', 2)
+                           .arg(qRound(speedup / workers * 100)));
+}
+
+void SpeedupDialog::onFinished() {
+    stop();
+}
@@ -0,0 +1,62 @@
+#ifndef SPEEDUPDIALOG_H
+#define SPEEDUPDIALOG_H
+
+#include "benchmark.h"
+#include <QDialog>
+#include <QWidget>
+#include <QSpinBox>
+#include <QLabel>
+#include <QToolButton>
+#include <QThread>
+#include <QPainter>
+#include <QPaintEvent>
+#include <QVector>
+
+// 工作者数-加速比曲线，附带理想线性加速的参考线
+class SpeedupChart : public QWidget {
+    Q_OBJECT
+
+public:
+    explicit SpeedupChart(QWidget* parent = nullptr);
+    void setTimes(const QVector<double>& seconds, int maxWorkers);   // seconds[w - 1] 为 w 个工作者的耗时
+
+protected:
+    void paintEvent(QPaintEvent* event) override;
+
+private:
+    QVector<double> m_seconds;
+    int m_maxWorkers;
+};
+
+// 加速比对话框：在同一数据集上以 1…P 个工作者运行并行排序，给出加速比与并行效率
+class SpeedupDialog : public QDialog {
+    Q_OBJECT
+
+public:
+    SpeedupDialog(ParallelSort::Algorithm algorithm, const QVector<int>& input, QWidget* parent = nullptr);
+    ~SpeedupDialog();
+
+protected:
+    void closeEvent(QCloseEvent* event) override;
+
+private:
+    void start();
+    void stop();                                   // 取消测量并等待工作线程退出
+    void onMeasured(int workers, double seconds);
+    void onFinished();
+
+    ParallelSort::Algorithm m_algorithm;
+    QVector<int> m_input;
+    QSpinBox* m_workersSpinBox;
+    QSpinBox* m_repeatsSpinBox;
+    QToolButton* m_startButton;
+    QToolButton* m_stopButton;
+    QLabel* m_resultLabel;
+    SpeedupChart* m_chart;
+
+    QThread* m_thread;
+    SpeedupWorker* m_worker;
+    QVector<double> m_seconds;
+};
+
+#endif // SPEEDUPDIALOG_H
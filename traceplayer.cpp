@@ -0,0 +1,70 @@
+#include "traceplayer.h"
+
+static const int kVerboseBatchLimit = 4;  // 每帧事件数不超过该值时才逐条写日志
+
+TracePlayer::TracePlayer(QObject* parent)
+    : QObject(parent), m_cursor(0), m_batchSize(1) {
+    connect(&m_timer, &QTimer::timeout, this, &TracePlayer::onTick);
+    setSpeed(0);
+}
+
+void TracePlayer::load(const QVector<TraceEvent>& events) {
+    m_timer.stop();
+    m_events = events;
+    m_cursor = 0;
+}
+
+void TracePlayer::play() {
+    if (m_cursor < m_events.size())
+        m_timer.start();
+}
+
+void TracePlayer::pause() {
+    m_timer.stop();
+}
+
+void TracePlayer::stop() {
+    m_timer.stop();
+    m_events.clear();
+    m_cursor = 0;
+}
+
+bool TracePlayer::isPlaying() const {
+    return m_timer.isActive();
+}
+
+void TracePlayer::setSpeed(int sliderValue) {
+    // 慢速档沿用逐步执行的节奏，快速档固定 16ms 一帧、按档位放大批量
+    int interval = 16;
+    switch (sliderValue) {
+    case -3: interval = 800; m_batchSize = 1;    break;
+    case -2: interval = 400; m_batchSize = 1;    break;
+    case -1: interval = 100; m_batchSize = 1;    break;
+    case 0:  interval = 16;  m_batchSize = 2;    break;
+    case 1:  interval = 16;  m_batchSize = 32;   break;
+    case 2:  interval = 16;  m_batchSize = 512;  break;
+    case 3:  interval = 16;  m_batchSize = 8192; break;
+    default: interval = 16;  m_batchSize = 2;    break;
+    }
+    m_timer.setInterval(interval);
+}
+
+int TracePlayer::position() const {
+    return m_cursor;
+}
+
+int TracePlayer::size() const {
+    return m_events.size();
+}
+
+void TracePlayer::onTick() {
+    const bool verbose = m_batchSize <= kVerboseBatchLimit;
+    const int end = qMin(m_events.size(), m_cursor + m_batchSize);
+    while (m_cursor < end && m_cursor < m_events.size())
+        emit eventReady(m_events[m_cursor++], verbose);
+
+    if (m_timer.isActive() && m_cursor >= m_events.size()) {
+        m_timer.stop();
+        emit finished();
+    }
+}
@@ -0,0 +1,40 @@
+#ifndef TRACEPLAYER_H
+#define TRACEPLAYER_H
+
+#include "sorttrace.h"
+#include <QObject>
+#include <QTimer>
+#include <QVector>
+
+// 原生轨迹回放：按速度档位在每次定时器触发时分发一批事件
+// 低速时逐条播放，高速时每帧批量分发，使上万元素的排序也能在数秒内看完
+class TracePlayer : public QObject {
+    Q_OBJECT
+
+public:
+    explicit TracePlayer(QObject* parent = nullptr);
+
+    void load(const QVector<TraceEvent>& events);
+    void play();
+    void pause();
+    void stop();                   // 停止并丢弃剩余事件
+    bool isPlaying() const;
+    void setSpeed(int sliderValue);  // 与速度滑块一致，取值 -3 ~ 3
+
+    int position() const;
+    int size() const;
+
+signals:
+    void eventReady(const TraceEvent& event, bool verbose); // verbose 为真时逐条写日志
+    void finished();
+
+private:
+    void onTick();
+
+    QTimer m_timer;
+    QVector<TraceEvent> m_events;
+    int m_cursor;
+    int m_batchSize;
+};
+
+#endif // TRACEPLAYER_H
@@ -1,23 +1,36 @@
 #include "visualbtree.h"
 
 
-VisualBTree::VisualBTree(QGraphicsScene* scene, QSize areaSize, QGraphicsView* view)
-    : m_scene(scene), m_areaSize(areaSize), m_rootVisual(nullptr), m_view(view) {
-    m_logicTree = new BTree();
-}
+VisualBTree::VisualBTree(QGraphicsScene* scene, QSize areaSize, QGraphicsView* view, int minDegree)
+    : m_scene(scene), m_areaSize(areaSize), m_view(view), m_rootVisual(nullptr),
+      m_logicTree(AnyBTree::create(minDegree)), m_generation(0) {}
 
 VisualBTree::~VisualBTree() {
    clear();
    delete m_logicTree;
 }
 
+// 只释放可视化结点记录，图元随场景一起释放：运行结束后最终的树仍留在画面上
 void VisualBTree::clear() {
-    clearVisualNode(m_rootVisual);
+    ++m_generation;
+    releaseVisualNode(m_rootVisual);
     m_rootVisual = nullptr;
-    m_scene->clear();
     m_logicTree->clear();
 }
 
+// 尚未完成的逐层显现随 generation 失效，留下的图元直接补全为不透明
+void VisualBTree::releaseVisualNode(VisualBTreeNode* node) {
+    if (!node) return;
+    for (auto child : node->children)
+        releaseVisualNode(child);
+    node->rect->setOpacity(1);
+    for (auto text : node->keyTexts)
+        text->setOpacity(1);
+    if (node->lineToParent)
+        node->lineToParent->setOpacity(1);
+    delete node;
+}
+
 void VisualBTree::clearVisualNode(VisualBTreeNode* node) {
     if (!node) return;
     for (auto child : node->children)
@@ -43,6 +56,59 @@ void VisualBTree::removeAnimated(int key) {
     adjustViewScale();
 }
 
+void VisualBTree::bulkLoadAnimated(const QVector<int>& sorted, double fill) {
+    m_logicTree->bulkLoad(sorted.constData(), sorted.size(), fill);
+    visualizeTree();
+    adjustViewScale();
+    revealLevels();
+}
+
+// 批量构建先装满叶子层、再由相邻结点之间的分隔键生成上一层，显现顺序与之相同：
+// 叶子层最先出现，之后每层连同连向孩子的边一起淡入
+void VisualBTree::revealLevels() {
+    QVector<QVector<VisualBTreeNode*>> levels;
+    QVector<VisualBTreeNode*> current;
+    if (m_rootVisual) current.push_back(m_rootVisual);
+    while (!current.isEmpty()) {
+        levels.push_back(current);
+        QVector<VisualBTreeNode*> next;
+        for (auto node : current)
+            for (auto child : node->children)
+                next.push_back(child);
+        current = next;
+    }
+
+    const int generation = m_generation;
+    for (int depth = levels.size() - 1; depth >= 0; --depth) {
+        QVector<QGraphicsItem*> items;
+        for (auto node : levels[depth]) {
+            items.push_back(node->rect);
+            for (auto text : node->keyTexts)
+                items.push_back(text);
+            for (auto child : node->children)
+                items.push_back(child->lineToParent);
+        }
+        for (auto item : items)
+            item->setOpacity(0);
+
+        // 定时器与动画都以本对象为上下文；场景重绘后 generation 不再相符，图元已被删除，不再访问
+        QTimer::singleShot((levels.size() - 1 - depth) * revealInterval, this, [this, items, generation]() {
+            if (generation != m_generation) return;
+            QVariantAnimation* anim = new QVariantAnimation(this);
+            anim->setDuration(revealInterval * 3 / 5);
+            anim->setStartValue(0.0);
+            anim->setEndValue(1.0);
+            anim->setEasingCurve(QEasingCurve::OutQuad);
+            connect(anim, &QVariantAnimation::valueChanged, this, [this, items, generation](const QVariant &value) {
+                if (generation != m_generation) return;
+                for (auto item : items)
+                    item->setOpacity(value.toReal());
+            });
+            anim->start(QAbstractAnimation::DeleteWhenStopped);
+        });
+    }
+}
+
 void VisualBTree::highlightNode(int key) {
     if (!m_rootVisual) return;
     VisualBTreeNode* target = findVisualNode(m_rootVisual, key);
@@ -51,8 +117,8 @@ void VisualBTree::highlightNode(int key) {
 
 VisualBTreeNode* VisualBTree::findVisualNode(VisualBTreeNode* node, int key) {
     if (!node) return nullptr;
-    for (int i = 0; i < node->logicalNode->numKeys; i++)
-        if (node->logicalNode->keys[i] == key) return node;
+    for (int i = 0; i < m_logicTree->keyCount(node->logicalNode); i++)
+        if (m_logicTree->key(node->logicalNode, i) == key) return node;
     for (auto child : node->children) {
         VisualBTreeNode* found = findVisualNode(child, key);
         if (found) return found;
@@ -80,27 +146,44 @@ void VisualBTree::animateHighlight(VisualBTreeNode* node, int key) {
 }
 
 void VisualBTree::visualizeTree() {
+    ++m_generation;
     clearVisualNode(m_rootVisual);
+    m_rootVisual = nullptr;
     m_scene->clear();
-    if (m_logicTree->getRoot())
-        m_rootVisual = createVisualNode(m_logicTree->getRoot(), QPointF(m_areaSize.width() / 2, 60), 0);
+    AnyBTree::Node root = m_logicTree->root();
+    if (root) {
+        // 整棵树的宽度由叶子跨度决定，居中放置
+        qreal totalWidth = m_logicTree->leafSpan(root) * slotWidth();
+        m_rootVisual = createVisualNode(root, m_areaSize.width() / 2 - totalWidth / 2, 60);
+    }
     visualizeConnections(m_rootVisual);
 }
 
-VisualBTreeNode* VisualBTree::createVisualNode(BTreeNode* node, QPointF position, qreal level) {
+int VisualBTree::maxKeys() const {
+    return 2 * m_logicTree->minDegree() - 1;
+}
+
+qreal VisualBTree::slotWidth() const {
+    return keyWidth * maxKeys() + nodeGap;
+}
+
+VisualBTreeNode* VisualBTree::createVisualNode(AnyBTree::Node node, qreal left, qreal top) {
     if (!node) return nullptr;
 
-    const int rectWidth = 45 * (2 * DEGREE - 1);
+    const int rectWidth = keyWidth * maxKeys();
     const int rectHeight = 50;
-    VisualBTreeNode* vNode = new VisualBTreeNode{node, nullptr, {}, {}};
+    VisualBTreeNode* vNode = new VisualBTreeNode{node, nullptr, {}, {}, nullptr};
+
+    // 节点居中于自身子树所覆盖的叶子区间之上
+    QPointF position(left + m_logicTree->leafSpan(node) * slotWidth() / 2, top);
 
-    QGraphicsRectItem* rect = m_scene->addRect(position.x() - rectWidth / 2, position.y(), rectWidth, rectHeight,
-                                               QPen(QColor("#ABB2BF"), 2), QBrush(QColor("#707070")));
+    QGraphicsRectItem* rect = new LodRectItem(position.x() - rectWidth / 2, position.y(), rectWidth, rectHeight);
+    m_scene->addItem(rect);
     rect->setBrush(QBrush(QColor("#707070")));
     rect->setPen(QPen(QColor("#E0E0E0"), 2));
     rect->setZValue(1);
 
-    auto shadow = new QGraphicsDropShadowEffect();
+    auto shadow = new LodShadowEffect();
     shadow->setBlurRadius(20);
     shadow->setColor(QColor(0, 0, 0, 150));
     shadow->setOffset(0, 4);
@@ -108,22 +191,25 @@ VisualBTreeNode* VisualBTree::createVisualNode(BTreeNode* node, QPointF position
 
     vNode->rect = rect;
 
-    for (int i = 0; i < node->numKeys; i++) {
-        auto text = m_scene->addText(QString::number(node->keys[i]), QFont("Segoe UI", 11, QFont::Bold));
+    const int numKeys = m_logicTree->keyCount(node);
+    for (int i = 0; i < numKeys; i++) {
+        auto text = new LodTextItem(QString::number(m_logicTree->key(node, i)));
+        text->setFont(QFont("Segoe UI", 11, QFont::Bold));
         text->setDefaultTextColor(QColor("#FFFFFF"));
+        m_scene->addItem(text);
         text->setZValue(2);
-        text->setPos(position.x() - rectWidth / 2 + i * 45 + 15, position.y() + 12);
+        text->setPos(position.x() - rectWidth / 2 + i * keyWidth + 15, position.y() + 12);
         vNode->keyTexts.push_back(text);
     }
 
-    qreal offset = rectWidth * 1.8;
-    qreal childX = position.x() - offset * (node->numKeys / 2.0);
-    qreal childY = position.y() + 100;
-
-    for (int i = 0; i <= node->numKeys; i++) {
-        if (node->children[i]) {
-            auto child = createVisualNode(node->children[i], QPointF(childX + offset * i, childY), level + 1);
-            vNode->children.push_back(child);
+    if (!m_logicTree->isLeaf(node)) {
+        // 兄弟子树按各自的叶子跨度依次紧密排列
+        qreal childLeft = left;
+        for (int i = 0; i <= numKeys; i++) {
+            AnyBTree::Node childNode = m_logicTree->child(node, i);
+            if (!childNode) continue;
+            vNode->children.push_back(createVisualNode(childNode, childLeft, top + levelHeight));
+            childLeft += m_logicTree->leafSpan(childNode) * slotWidth();
         }
     }
     return vNode;
@@ -136,6 +222,7 @@ void VisualBTree::visualizeConnections(VisualBTreeNode* node) {
         QPointF childCenter = child->rect->rect().center() + child->rect->pos() - QPointF(0, child->rect->rect().height() / 2);
         auto line = m_scene->addLine(QLineF(parentCenter, childCenter), QPen(QColor("#E0E0E0"), 2));
         line->setZValue(0);
+        child->lineToParent = line;
         visualizeConnections(child);
     }
 }
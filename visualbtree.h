@@ -11,42 +11,58 @@
 #include <QVariantAnimation>
 #include <QGraphicsView>
 #include <QEasingCurve>
+#include <QTimer>
 #include "btree.h"
+#include "loditems.h"
 
 struct VisualBTreeNode {
-    BTreeNode* logicalNode;                      // 对应的逻辑树节点
+    AnyBTree::Node logicalNode;                  // 对应的逻辑树节点
     QGraphicsRectItem* rect;                     // 可视化的矩形框
     QVector<QGraphicsTextItem*> keyTexts;        // 关键字文本
     QVector<VisualBTreeNode*> children;          // 子节点
+    QGraphicsLineItem* lineToParent;             // 连向父节点的边，根为空
 };
 
 class VisualBTree : public QObject {
     Q_OBJECT
 
 public:
-    VisualBTree(QGraphicsScene* scene, QSize areaSize, QGraphicsView* view);
+    VisualBTree(QGraphicsScene* scene, QSize areaSize, QGraphicsView* view, int minDegree = 2);
     ~VisualBTree();
 
-    void clear();                               // 清空树结构
+    void clear();                               // 清空树结构，已绘制的图元留给场景
     void insertAnimated(int key);               // 插入节点并动画更新
     void removeAnimated(int key);               // 删除节点并动画更新
     void highlightNode(int key);                // 查找节点并字体高亮动画
+    void bulkLoadAnimated(const QVector<int>& sorted, double fill);  // 自底向上批量构建，逐层显现
+
+    static const int MaxBulkKeys = 500;         // 批量构建超过此键数时只计时、不绘制
 
 private:
     QGraphicsScene* m_scene;                    // 场景对象
     QSize m_areaSize;                           // 绘图区域尺寸
     QGraphicsView* m_view;                      // 视图对象用于自动缩放
     VisualBTreeNode* m_rootVisual;              // 根节点（可视化）
-    BTree* m_logicTree;                         // B树逻辑结构
+    AnyBTree* m_logicTree;                      // B树逻辑结构，阶数在构造时选定
+    int m_generation;                           // 每次重绘递增，使尚未触发的逐层显现失效
 
     void visualizeTree();                       // 可视化整棵树
-    VisualBTreeNode* createVisualNode(BTreeNode* node, QPointF position, qreal level);
+    VisualBTreeNode* createVisualNode(AnyBTree::Node node, qreal left, qreal top);  // 在 [left, left + 跨度) 内布局子树
     void visualizeConnections(VisualBTreeNode* node);
     VisualBTreeNode* findVisualNode(VisualBTreeNode* node, int key);
     void animateHighlight(VisualBTreeNode* node, int key);
-    void clearVisualNode(VisualBTreeNode* node);
+    void clearVisualNode(VisualBTreeNode* node);      // 连同图元一起删除，重绘前使用
+    void releaseVisualNode(VisualBTreeNode* node);    // 只删除结点记录，图元留在场景中
+    void revealLevels();                        // 从叶子层起逐层淡入
 
     void adjustViewScale();                     // 自动调整视图缩放
+
+    static const int keyWidth = 45;             // 单个关键字宽度
+    static const int nodeGap = 20;              // 相邻叶子节点间距
+    static const int levelHeight = 100;         // 层间距
+    static const int revealInterval = 500;      // 逐层显现的间隔（毫秒）
+    int maxKeys() const;                        // 结点最多容纳的关键字数 2t - 1
+    qreal slotWidth() const;                    // 每个叶子占用的水平宽度
 };
 
 #endif // VISUALBTREE_H
@@ -1,15 +1,9 @@
 #ifndef VISUALBUBBLESORT_H
 #define VISUALBUBBLESORT_H
 
+#include "histogramitem.h"
 #include <QObject>
 #include <QGraphicsScene>
-#include <QGraphicsRectItem>
-#include <QGraphicsTextItem>
-#include <QParallelAnimationGroup>
-#include <QVariantAnimation>
-#include <QPropertyAnimation>
-#include <QEasingCurve>
-#include <QTimer>
 #include <QSize>
 #include <QVector>
 
@@ -18,7 +12,6 @@ class VisualBubbleSort : public QObject {
 
 public:
     VisualBubbleSort(QGraphicsScene* scene, QSize areaSize);
-    QPointF getBarPosition(int index, int barHeight) const;
     void insertValue(int value);
     void compare(int i, int j);
     void swap(int i, int j);
@@ -26,19 +19,13 @@ public:
     void clear();
 
 private:
-    struct VisualNode {
-        int value;
-        QGraphicsRectItem* bar;
-        QGraphicsTextItem* label;
-    };
+    HistogramItem* histogram();      // 首次插入时创建柱状图图元
+    void clearTransient();           // 清除上一步的比较/交换高亮
 
-    QVector<VisualNode*> m_nodes;
+    HistogramItem* m_histogram;
+    QVector<int> m_transient;        // 当前带有临时高亮的下标
     QGraphicsScene* m_scene;
     QSize m_areaSize;
-
-    void animateSwap(int i, int j);
-    void animateHighlight(int index, const QColor& color);
-    void animateTemporaryHighlight(int index, const QColor& highlightColor);
 };
 
 #endif // VISUALBUBBLESORT_H
@@ -1,15 +1,9 @@
 #ifndef VISUALBUCKETSORT_H
 #define VISUALBUCKETSORT_H
 
+#include "bucketlanesitem.h"
 #include <QObject>
 #include <QGraphicsScene>
-#include <QGraphicsRectItem>
-#include <QGraphicsTextItem>
-#include <QGraphicsSimpleTextItem>
-#include <QVariantAnimation>
-#include <QTimer>
-#include <QVector>
-#include <QMap>
 #include <QSize>
 
 
@@ -20,35 +14,19 @@ public:
     VisualBucketSort(QGraphicsScene* scene, QSize areaSize);
     void clear();
 
+    void initBuckets(int count);                   // BUCKET_INIT：按桶数划分桶道
+    void setBucketRange(int bucketIdx, int low, int high);
     void insertValue(int value);                   // 上方插入数组元素
     void assignToBucket(int value, int bucketIdx); // 移动元素到底部桶
     void swapInBucket(int i, int j, int bucketId); // 桶内冒泡排序
     void markFinal(int value);                     // 回归数组位置并高亮
 
 private:
-    struct VisualNode {
-        int value;
-        QGraphicsRectItem* box;
-        QGraphicsTextItem* label;
-        int bucket = -1;       // -1 表示未分配桶
-        QPointF originalPos;   // 上方原始位置
-
-        VisualNode(int v, QGraphicsRectItem* b, QGraphicsTextItem* l, QPointF pos)
-                : value(v), box(b), label(l), bucket(-1), originalPos(pos) {}
-    };
+    BucketLanesItem* lanes();        // 首次使用时创建图元
+
+    BucketLanesItem* m_lanes;        // 输出位置等每次运行的状态都保存在图元中
     QGraphicsScene* m_scene;
     QSize m_areaSize;
-
-    QVector<VisualNode*> m_nodes;
-    QMap<int, QVector<VisualNode*>> m_buckets;
-    QMap<int, QGraphicsTextItem*> m_bucketLabels;
-
-    QPointF getTopArrayPos(int index) const;
-    QPointF getBucketPos(int bucketIdx, int localIndex) const;
-
-    void animateMove(VisualNode* node, QPointF target);
-    void animateMove(VisualNode* node, QPointF target, QSizeF targetSize);
-    void animateHighlight(VisualNode* node, const QColor& color);
 };
 
 #endif // VISUALBUCKETSORT_H
@@ -1,70 +1,111 @@
 #include "visualgraph.h"
 
 VisualGraph::VisualGraph(QGraphicsScene *scene, QSize areaSize)
-    : m_scene(scene), m_areaSize(areaSize) {}
+    : m_scene(scene), m_areaSize(areaSize), m_layout(nullptr), m_matrixItem(nullptr) {}
 
 VisualGraph::~VisualGraph() {
     clear();
 }
 
 void VisualGraph::clear() {
+    if (m_layout) m_layout->stop();
     m_nodes.clear();
     m_edges.clear();
+    m_highlightedEdges.clear();
+    m_matrixItem = nullptr; // 图元随场景一起释放
+}
+
+// 顶点较多时按 sqrt(n) 扩大布局区域，保持平均边长不变
+static QRectF growBounds(QRectF bounds, int nodeCount, bool keepBottom) {
+    if (nodeCount <= 20) return bounds;
+    qreal factor = qSqrt(nodeCount / 20.0);
+    QRectF grown(0, 0, bounds.width() * factor, bounds.height() * factor);
+    grown.moveCenter(bounds.center());
+    if (keepBottom) grown.moveBottom(bounds.bottom()); // 不遮挡下方的距离矩阵
+    return grown;
 }
 
 void VisualGraph::autoLayoutNodes(int nodeCount) {
     clear();
     if (nodeCount <= 0) return;
 
-    const QPointF center(m_areaSize.width() / 2, m_areaSize.height() / 2);
-    const double radius = qMin(m_areaSize.width(), m_areaSize.height()) / 2.8;
-    const double angleStep = 2 * M_PI / nodeCount;
-
-    for (int i = 0; i < nodeCount; ++i) {
-        double angle = i * angleStep;
-        double x = center.x() + radius * qCos(angle);
-        double y = center.y() + radius * qSin(angle);
-
-        addNode(i, QPointF(x, y));
-    }
+    QRectF bounds(40, 40, m_areaSize.width() - 80, m_areaSize.height() - 80);
+    startLayout(nodeCount, growBounds(bounds, nodeCount, false));
 }
 
 void VisualGraph::autoLayoutNodes_Fd(int nodeCount) {
     clear();
     if (nodeCount <= 0) return;
 
-    const QPointF center(m_areaSize.width() / 2, m_areaSize.height() / 4); // 上半部分中心点
-    const double radius = qMin(m_areaSize.width(), m_areaSize.height() / 2) / 2.5; // 半径适当减小
+    // 上半部分放置图，下半部分留给距离矩阵
+    QRectF bounds(40, 40, m_areaSize.width() - 80, m_areaSize.height() / 2 - 80);
+    startLayout(nodeCount, growBounds(bounds, nodeCount, true));
+}
+
+void VisualGraph::startLayout(int nodeCount, QRectF bounds) {
+    // 初始位置仍为圆形，随后由力导向布局逐帧调整
+    const QPointF center = bounds.center();
+    const double radius = qMin(bounds.width(), bounds.height()) / 2 * 0.8;
     const double angleStep = 2 * M_PI / nodeCount;
 
+    QVector<QPointF> initial;
+    initial.reserve(nodeCount);
     for (int i = 0; i < nodeCount; ++i) {
         double angle = i * angleStep;
-        double x = center.x() + radius * qCos(angle);
-        double y = center.y() + radius * qSin(angle);
-        addNode(i, QPointF(x, y));
+        QPointF pos(center.x() + radius * qCos(angle), center.y() + radius * qSin(angle));
+        addNode(i, pos);
+        initial.append(pos);
     }
+
+    delete m_layout;
+    m_layout = new ForceLayout(bounds, this);
+    m_layout->reset(initial);
+    connect(m_layout, &ForceLayout::positionsUpdated, this, &VisualGraph::applyLayout);
 }
 
+void VisualGraph::applyLayout() {
+    const QVector<QPointF>& positions = m_layout->positions();
+    for (auto node : m_nodes) {
+        if (node->id < positions.size())
+            moveNode(node, positions[node->id]);
+    }
+    for (auto edge : m_edges) {
+        edge->line->setLine(QLineF(m_nodes[edge->src]->position, m_nodes[edge->dest]->position));
+        placeWeightLabel(edge);
+    }
+}
 
 VisualGraphNode* VisualGraph::createNode(int id, QPointF position) {
-    auto ellipse = m_scene->addEllipse(position.x() - 25, position.y() - 25, 50, 50,
-                                       QPen(QColor("#E0E0E0"), 3), QBrush(QColor("#707070")));
+    auto ellipse = new LodEllipseItem(-25, -25, 50, 50);
+    ellipse->setPen(QPen(QColor("#E0E0E0"), 3));
+    ellipse->setBrush(QBrush(QColor("#707070")));
+    ellipse->setPos(position);
+    m_scene->addItem(ellipse);
 
     ellipse->setZValue(1);
-    auto shadow = new QGraphicsDropShadowEffect();
+    auto shadow = new LodShadowEffect();
     shadow->setBlurRadius(20);
     shadow->setColor(QColor(0, 0, 0, 150));
     shadow->setOffset(QPointF(0, 3));
     ellipse->setGraphicsEffect(shadow);
 
 
-    auto label = m_scene->addText(QString::number(id), QFont("Segoe UI", 13, QFont::Bold));
+    auto label = new LodTextItem(QString::number(id));
+    label->setFont(QFont("Segoe UI", 13, QFont::Bold));
     label->setDefaultTextColor(Qt::white);
+    m_scene->addItem(label);
     label->setZValue(2);
-    label->setPos(position.x() - label->boundingRect().width() / 2,
-                  position.y() - label->boundingRect().height() / 2);
 
-    return new VisualGraphNode{id, position, ellipse, label};
+    auto node = new VisualGraphNode{id, position, ellipse, label};
+    moveNode(node, position);
+    return node;
+}
+
+void VisualGraph::moveNode(VisualGraphNode* node, QPointF position) {
+    node->position = position;
+    node->ellipse->setPos(position);
+    node->label->setPos(position.x() - node->label->boundingRect().width() / 2,
+                        position.y() - node->label->boundingRect().height() / 2);
 }
 
 void VisualGraph::addNode(int id, QPointF position) {
@@ -73,12 +114,28 @@ void VisualGraph::addNode(int id, QPointF position) {
     }
 }
 
-void VisualGraph::createEdge(int src, int dest) {
+quint64 VisualGraph::edgeKey(int src, int dest) {
+    // 无向图：(src, dest) 与 (dest, src) 映射到同一个键
+    quint32 a = static_cast<quint32>(qMin(src, dest));
+    quint32 b = static_cast<quint32>(qMax(src, dest));
+    return (static_cast<quint64>(a) << 32) | b;
+}
+
+VisualGraphEdge* VisualGraph::findEdge(int src, int dest) const {
+    return m_edges.value(edgeKey(src, dest), nullptr);
+}
+
+VisualGraphEdge* VisualGraph::createEdge(int src, int dest) {
+    if (auto existing = findEdge(src, dest)) return existing; // 重复边复用已有图元
+
     auto srcNode = m_nodes[src];
     auto destNode = m_nodes[dest];
     auto line = m_scene->addLine(QLineF(srcNode->position, destNode->position), QPen(QColor("#ABB2BF"), 3));
     line->setZValue(0);
-    m_edges.append(new VisualGraphEdge{src, dest, line});
+    auto edge = new VisualGraphEdge{src, dest, line, nullptr, 0, false};
+    m_edges.insert(edgeKey(src, dest), edge);
+    if (m_layout) m_layout->addEdge(src, dest);
+    return edge;
 }
 
 void VisualGraph::addEdge(int src, int dest) {
@@ -90,14 +147,49 @@ void VisualGraph::addEdge(int src, int dest) {
 void VisualGraph::addEdge(int src, int dest, int weight) {
     if (m_nodes.contains(src) && m_nodes.contains(dest)) {
         createEdge(src, dest);
+        updateEdgeWeight(src, dest, weight);
+    }
+}
+
+void VisualGraph::updateEdgeWeight(int src, int dest, int weight) {
+    auto edge = findEdge(src, dest);
+    if (!edge) return;
 
+    edge->weight = weight;
+    if (!edge->weightLabel) {
         // 添加权重文本
-        QPointF mid = (m_nodes[src]->position + m_nodes[dest]->position) / 2;
-        auto text = m_scene->addText(QString::number(weight), QFont("Segoe UI", 12, QFont::Bold));
+        auto text = new LodTextItem(QString());
+        text->setFont(QFont("Segoe UI", 12, QFont::Bold));
         text->setDefaultTextColor(Qt::white);
+        m_scene->addItem(text);
         text->setZValue(3);
-        text->setPos(mid.x() - 10, mid.y() - 10);
+        edge->weightLabel = text;
     }
+    edge->weightLabel->setPlainText(weight == INF ? "∞" : QString::number(weight));
+    placeWeightLabel(edge);
+}
+
+void VisualGraph::removeEdge(int src, int dest) {
+    auto edge = m_edges.take(edgeKey(src, dest));
+    if (!edge) return;
+
+    if (edge->highlighted)
+        m_highlightedEdges.removeOne(edge);
+    if (m_layout) m_layout->removeEdge(src, dest);
+
+    m_scene->removeItem(edge->line);
+    delete edge->line;
+    if (edge->weightLabel) {
+        m_scene->removeItem(edge->weightLabel);
+        delete edge->weightLabel;
+    }
+    delete edge;
+}
+
+void VisualGraph::placeWeightLabel(VisualGraphEdge* edge) {
+    if (!edge->weightLabel) return;
+    QPointF mid = (m_nodes[edge->src]->position + m_nodes[edge->dest]->position) / 2;
+    edge->weightLabel->setPos(mid.x() - 10, mid.y() - 10);
 }
 
 void VisualGraph::highlightNode(int id) {
@@ -121,96 +213,40 @@ void VisualGraph::highlightNode(int id) {
 }
 
 void VisualGraph::highlightEdge(int src, int dest) {
-    for(auto edge : m_edges) {
-        if((edge->src == src && edge->dest == dest) || (edge->src == dest && edge->dest == src)) {
-            edge->line->setPen(QPen(QColor("#E5C07B"), 7));
-        }
-    }
+    setEdgeHighlight(src, dest, QColor("#E5C07B"));
 }
 
 void VisualGraph::Dj_highlightEdge(int src, int dest) {
-    for(auto edge : m_edges) {
-        if((edge->src == src && edge->dest == dest) || (edge->src == dest && edge->dest == src)) {
-            edge->line->setPen(QPen(QColor("#E06C75"), 7));
-        }
-    }
+    setEdgeHighlight(src, dest, QColor("#E06C75"));
 }
 
-void VisualGraph::initDistanceMatrix(int vertices, QVector<QVector<int>> initialMatrix) {
-    currentDistances = initialMatrix;
-    drawDistanceMatrix();
-}
-
-void VisualGraph::drawDistanceMatrix() {
-    const int cellSize = 50;
-
-    // 邻接矩阵尺寸
-    int matrixSize = currentDistances.size();
-
-    // 计算起始位置 (下半部分居中)
-    const int matrixWidth = cellSize * matrixSize;
-    const QPointF start((m_areaSize.width() - matrixWidth) / 2 + cellSize - 50,
-                        m_areaSize.height() / 2 + 40 + cellSize);
-
-    // 背景矩形 (包括边界标签的额外空间)
-    matrixBackground = m_scene->addRect(start.x(), start.y(),
-                                        matrixWidth, matrixWidth,
-                                        QPen(Qt::black), QBrush(QColor("#282C34")));
-
-    distanceMatrixTexts.resize(matrixSize);
-    for (int i = 0; i < matrixSize; ++i) {
-        distanceMatrixTexts[i].resize(matrixSize);
-        for (int j = 0; j < matrixSize; ++j) {
-            QString text = currentDistances[i][j] == INF ? "∞" : QString::number(currentDistances[i][j]);
-            QGraphicsTextItem* item = m_scene->addText(text, QFont("Segoe UI", 10, QFont::Bold));
-            item->setDefaultTextColor(Qt::white);
-            item->setPos(start.x() + j * cellSize + 15, start.y() + i * cellSize + 15);
-            distanceMatrixTexts[i][j] = item;
-        }
-    }
+void VisualGraph::setEdgeHighlight(int src, int dest, const QColor& color) {
+    auto edge = findEdge(src, dest);
+    if (!edge) return;
 
-    // 新增结点编号
-    for (int i = 0; i < matrixSize; ++i) {
-        // 顶部编号 (横向)
-        QGraphicsTextItem* topLabel = m_scene->addText(QString("V%1").arg(i), QFont("Segoe UI", 10, QFont::Bold));
-        topLabel->setDefaultTextColor(QColor("#61AFEF"));
-        topLabel->setPos(start.x() + i * cellSize + 15, start.y() - cellSize + 15);
-
-        // 左侧编号 (纵向)
-        QGraphicsTextItem* leftLabel = m_scene->addText(QString("V%1").arg(i), QFont("Segoe UI", 10, QFont::Bold));
-        leftLabel->setDefaultTextColor(QColor("#61AFEF"));
-        leftLabel->setPos(start.x() - cellSize + 15, start.y() + i * cellSize + 15);
+    edge->line->setPen(QPen(color, 7));
+    if (!edge->highlighted) {
+        edge->highlighted = true;
+        m_highlightedEdges.append(edge);
     }
 }
 
-void VisualGraph::updateDistanceMatrix(int src, int dest, int newDist) {
-    // 更新邻接矩阵的数据
-   currentDistances[src][dest] = newDist;
-   currentDistances[dest][src] = newDist;
-
-   QString text = newDist == INF ? "∞" : QString::number(newDist);
-
-   // 更新矩阵显示文本
-   distanceMatrixTexts[src][dest]->setPlainText(text);
-   distanceMatrixTexts[dest][src]->setPlainText(text);
-
-   // 设置高亮颜色
-   distanceMatrixTexts[src][dest]->setDefaultTextColor(QColor("#E06C75"));
-   distanceMatrixTexts[dest][src]->setDefaultTextColor(QColor("#E06C75"));
-
-   // 动画效果：字体颜色从高亮渐变回白色
-   QVariantAnimation* anim = new QVariantAnimation(this);
-   anim->setDuration(1200);
-   anim->setStartValue(QColor("#E06C75"));
-   anim->setEndValue(QColor("#FFFFFF"));
-   anim->setEasingCurve(QEasingCurve::InOutQuad);
-
-   connect(anim, &QVariantAnimation::valueChanged, [=](const QVariant &value) {
-       distanceMatrixTexts[src][dest]->setDefaultTextColor(value.value<QColor>());
-       distanceMatrixTexts[dest][src]->setDefaultTextColor(value.value<QColor>());
-   });
+void VisualGraph::initDistanceMatrix(int vertices, QVector<QVector<int>> initialMatrix) {
+    m_matrixItem = new DistanceMatrixItem(vertices, INF);
+    m_matrixItem->setMatrix(initialMatrix);
+
+    // 矩阵位于下半部分居中，左侧与上方留出编号所需的一格
+    const qreal cellSize = m_matrixItem->cellSize();
+    const qreal matrixWidth = cellSize * vertices;
+    m_matrixItem->setPos((m_areaSize.width() - matrixWidth) / 2 + cellSize - 50,
+                         m_areaSize.height() / 2 + 40 + cellSize);
+    m_scene->addItem(m_matrixItem);
+}
 
-   anim->start(QAbstractAnimation::DeleteWhenStopped);
+void VisualGraph::updateDistanceMatrix(int src, int dest, int newDist) {
+    if (!m_matrixItem) return;
+    m_matrixItem->setValue(src, dest, newDist);
+    m_matrixItem->setValue(dest, src, newDist);
 }
 
 void VisualGraph::resetHighlights() {
@@ -218,7 +254,9 @@ void VisualGraph::resetHighlights() {
         node->ellipse->setBrush(QBrush(QColor("#707070")));
         node->ellipse->setScale(1.0);
     }
-    for(auto edge : m_edges) {
+    for(auto edge : m_highlightedEdges) {
         edge->line->setPen(QPen(QColor("#ABB2BF"), 2));
+        edge->highlighted = false;
     }
+    m_highlightedEdges.clear();
 }
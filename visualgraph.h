@@ -14,7 +14,11 @@
 #include <QVariant>
 #include <QVector>
 #include <QMap>
+#include <QHash>
 #include <QtMath>
+#include "forcelayout.h"
+#include "distancematrixitem.h"
+#include "loditems.h"
 
 const int INF = 99999; //自定义无穷大
 
@@ -29,6 +33,9 @@ struct VisualGraphEdge {
     int src;
     int dest;
     QGraphicsLineItem *line;
+    QGraphicsTextItem *weightLabel; // 权重文本（无权边为 nullptr）
+    int weight;
+    bool highlighted;
 };
 
 class VisualGraph : public QObject {
@@ -45,9 +52,12 @@ public:
     void highlightNode(int id);
     void highlightEdge(int src, int dest);
     void Dj_highlightEdge(int src, int dest);
+    void updateEdgeWeight(int src, int dest, int weight); // 更新（或补充）边的权重文本
+    void removeEdge(int src, int dest);
     void resetHighlights();
     void autoLayoutNodes(int nodeCount);
     void autoLayoutNodes_Fd(int nodeCount);
+    void applyLayout();                          // 将力导向布局的结果同步到图元
 
     // 新增邻接矩阵显示和更新功能
     void initDistanceMatrix(int vertices, QVector<QVector<int>> initialMatrix);
@@ -58,15 +68,22 @@ private:
     QGraphicsScene *m_scene;
     QSize m_areaSize;
     QMap<int, VisualGraphNode*> m_nodes;
-    QVector<VisualGraphEdge*> m_edges;
+    QHash<quint64, VisualGraphEdge*> m_edges;      // 以无序顶点对为键的边表
+    QVector<VisualGraphEdge*> m_highlightedEdges;  // 当前高亮的边，重置时只处理这些
+
+    static quint64 edgeKey(int src, int dest);
+    VisualGraphEdge* findEdge(int src, int dest) const;
+    void setEdgeHighlight(int src, int dest, const QColor& color);
 
     VisualGraphNode* createNode(int id, QPointF position);
-    void createEdge(int src, int dest);
+    VisualGraphEdge* createEdge(int src, int dest);
+    void startLayout(int nodeCount, QRectF bounds); // 初始圆形布局 + 力导向迭代
+    void moveNode(VisualGraphNode* node, QPointF position);
+    void placeWeightLabel(VisualGraphEdge* edge);
+
+    ForceLayout *m_layout;
 
-    QVector<QVector<QGraphicsTextItem*>> distanceMatrixTexts;
-    QGraphicsRectItem* matrixBackground;
-    void drawDistanceMatrix();
-    QVector<QVector<int>> currentDistances;
+    DistanceMatrixItem* m_matrixItem;  // 单个图元绘制整个距离矩阵
 
 };
 
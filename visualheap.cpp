@@ -1,109 +1,285 @@
 #include "visualheap.h"
+#include "heapsort.h"
 #include <QtMath>
 #include <QFont>
-#include <QVariantAnimation>
+#include <climits>
+
+static const qreal kMargin = 30;        // 视图四周留白
+static const qreal kMaxRadius = 25;     // 节点较少时的半径，与原先固定大小一致
+static const qreal kMinRadius = 10;     // 再小文字就看不清，改由视图整体缩放
+static const qreal kMaxSlot = 120;      // 叶子间距上限，避免小堆被拉得过散
+static const qreal kMaxLevelGap = 100;
 
 VisualHeap::VisualHeap(QGraphicsScene* scene, QGraphicsView* view, QSize areaSize)
-    : m_scene(scene), m_view(view), m_areaSize(areaSize) {}
+    : m_scene(scene), m_view(view), m_areaSize(areaSize), m_arity(HeapSort::DefaultArity), m_radius(kMaxRadius),
+      m_phase(Building), m_buildName("建堆"), m_comparisons{0, 0}, m_swaps{0, 0},
+      m_sortedFrom(INT_MAX), m_siftNode(-1), m_phaseLabel(nullptr) {}
 
 VisualHeap::~VisualHeap() {
     clear();
 }
 
 void VisualHeap::clear() {
+    if (m_layoutAnimation)
+        m_layoutAnimation->stop();
+    qDeleteAll(m_nodes);   // 图元随场景一起释放
     m_nodes.clear();
+    m_compared.clear();
+    m_phaseLabel = nullptr;
+}
+
+void VisualHeap::setArity(int arity) {
+    m_arity = HeapSort::isSupportedArity(arity) ? arity : HeapSort::DefaultArity;
+    if (!m_nodes.isEmpty())
+        relayout();
+}
+
+int VisualHeap::arity() const {
+    return m_arity;
+}
+
+int VisualHeap::levels() const {
+    return HeapSort::levels(m_nodes.size(), m_arity);
+}
+
+// 先序遍历：叶子依次占用一个横向槽位，内部节点取首末孩子的中点；layout 中 x 为槽位序号，y 为深度
+qreal VisualHeap::layoutSubtree(int index, int depth, qreal* nextLeaf, QVector<QPointF>* layout) const {
+    const int first = m_arity * index + 1;
+    qreal x;
+    if (first >= m_nodes.size()) {
+        x = (*nextLeaf)++;
+    } else {
+        const int last = qMin(first + m_arity, m_nodes.size()) - 1;
+        qreal firstX = 0, lastX = 0;
+        for (int child = first; child <= last; ++child) {
+            qreal childX = layoutSubtree(child, depth + 1, nextLeaf, layout);
+            if (child == first) firstX = childX;
+            lastX = childX;
+        }
+        x = (firstX + lastX) / 2;
+    }
+    (*layout)[index] = QPointF(x, depth);
+    return x;
+}
+
+QVector<QPointF> VisualHeap::computeLayout() {
+    const int n = m_nodes.size();
+    QVector<QPointF> positions(n);
+    if (n == 0) return positions;
+
+    qreal leaves = 0;
+    layoutSubtree(0, 0, &leaves, &positions);
+    const int depthCount = levels();
+
+    // 横向：叶子平分可用宽度，节点半径随槽宽缩小；到下限后槽宽不再缩小，超出的部分由 fitView 缩放视图
+    const qreal usableWidth = m_areaSize.width() - 2 * kMargin;
+    qreal slot = qMin(kMaxSlot, usableWidth / leaves);
+    m_radius = qBound(kMinRadius, slot * 0.42, kMaxRadius);
+    slot = qMax(slot, 2 * m_radius + 4);
+
+    // 纵向：层间距随层数收缩，但不小于节点直径
+    const qreal usableHeight = m_areaSize.height() - 2 * kMargin - 2 * m_radius;
+    const qreal levelGap = depthCount > 1 ? qBound(2.6 * m_radius, usableHeight / (depthCount - 1), kMaxLevelGap) : 0;
+
+    const qreal left = (m_areaSize.width() - leaves * slot) / 2;
+    const qreal top = kMargin + m_radius;
+    for (QPointF& p : positions)
+        p = QPointF(left + (p.x() + 0.5) * slot, top + p.y() * levelGap);
+    return positions;
+}
+
+void VisualHeap::placeNode(VisualHeapNode* node, QPointF pos) {
+    node->circle->setPos(pos);
+    node->label->setPos(pos.x() - node->label->boundingRect().width() / 2,
+                        pos.y() - node->label->boundingRect().height() / 2);
 }
 
-QPointF VisualHeap::getPosition(int index) const {
-    int depth = static_cast<int>(qFloor(qLn(index + 1) / qLn(2)));
-    int maxNodes = 1 << depth;
-    int posInLevel = index - ((1 << depth) - 1);
-    int spacingX = 60 * (1 << (3 - depth));
-    int baseX = (m_areaSize.width() - (maxNodes - 1) * spacingX) / 2;
-    int x = baseX + posInLevel * spacingX;
-    int y = depth * 100 + 60;
-    return QPointF(x, y);
+void VisualHeap::applyNodeStyle(VisualHeapNode* node) {
+    const qreal penWidth = m_radius > 15 ? 2 : 1;
+    node->circle->setRect(-m_radius, -m_radius, 2 * m_radius, 2 * m_radius);
+    node->circle->setPen(penFor(node->index));
+    node->label->setFont(QFont("Segoe UI", qMax(6, qRound(m_radius * 0.48)), QFont::Bold));
+    if (node->lineToParent)
+        node->lineToParent->setPen(QPen(QColor("#ABB2BF"), penWidth));
+}
+
+// 目标布局超出视图时整体缩放，与 VisualTree::resetView 的处理一致
+void VisualHeap::fitView(const QVector<QPointF>& positions) {
+    if (positions.isEmpty()) return;
+    qreal minX = positions.first().x(), maxX = minX;
+    qreal maxY = positions.first().y();
+    for (const QPointF& p : positions) {
+        minX = qMin(minX, p.x());
+        maxX = qMax(maxX, p.x());
+        maxY = qMax(maxY, p.y());
+    }
+    const qreal extent = m_radius + kMargin;
+    const QRectF bounds(QPointF(minX - extent, 0), QPointF(maxX + extent, maxY + extent));
+
+    m_view->resetTransform();
+    if (bounds.width() > m_view->viewport()->width() || bounds.height() > m_view->viewport()->height())
+        m_view->fitInView(bounds, Qt::KeepAspectRatio);
+}
+
+void VisualHeap::relayout(int duration) {
+    if (m_layoutAnimation)
+        m_layoutAnimation->stop();
+
+    const QVector<QPointF> targets = computeLayout();
+    QVector<QPointF> starts;
+    starts.reserve(m_nodes.size());
+    for (auto* node : m_nodes) {
+        applyNodeStyle(node);
+        starts.append(node->circle->pos());
+    }
+    fitView(targets);
+
+    // 所有节点共用一个动画，每帧移动后统一刷新连线
+    auto* anim = new QVariantAnimation(this);
+    anim->setStartValue(0.0);
+    anim->setEndValue(1.0);
+    anim->setDuration(duration);
+    anim->setEasingCurve(QEasingCurve::OutCubic);
+    connect(anim, &QVariantAnimation::valueChanged, this, [=](const QVariant &value) {
+        const qreal t = value.toReal();
+        for (int i = 0; i < m_nodes.size() && i < targets.size(); ++i)
+            placeNode(m_nodes[i], starts[i] + (targets[i] - starts[i]) * t);
+        updateLines();
+    });
+    m_layoutAnimation = anim;
+    anim->start(QAbstractAnimation::DeleteWhenStopped);
+}
+
+void VisualHeap::updateLines() {
+    for (int i = 1; i < m_nodes.size(); ++i) {
+        VisualHeapNode* node = m_nodes[i];
+        if (!node->lineToParent) continue;
+        const QPointF parentPos = m_nodes[HeapSort::parentOf(i, m_arity)]->circle->pos();
+        node->lineToParent->setLine(QLineF(parentPos, node->circle->pos()));
+    }
 }
 
 void VisualHeap::insert(int value) {
     int index = m_nodes.size();
-    QPointF pos = getPosition(index);
+    // 新节点从父节点处长出，随后与其余节点一起移动到新布局
+    QPointF pos = index > 0 ? m_nodes[HeapSort::parentOf(index, m_arity)]->circle->pos()
+                            : QPointF(m_areaSize.width() / 2.0, kMargin + m_radius);
 
-    auto* circle = m_scene->addEllipse(-25, -25, 50, 50,
-                                       QPen(QColor("#ABB2BF"), 2), QBrush(QColor("#707070")));
+    auto* circle = new LodEllipseItem(-m_radius, -m_radius, 2 * m_radius, 2 * m_radius);
+    circle->setBrush(QBrush(QColor("#707070")));
+    m_scene->addItem(circle);
     circle->setZValue(1);
-    circle->setPos(pos);
 
-    QFont font("Segoe UI", 12, QFont::Bold);
-    auto* label = m_scene->addText(QString::number(value), font);
+    auto* label = new LodTextItem(QString::number(value));
     label->setDefaultTextColor(Qt::white);
+    m_scene->addItem(label);
     label->setZValue(2);
-    label->setPos(pos.x() - label->boundingRect().width() / 2,
-                  pos.y() - label->boundingRect().height() / 2);
 
     auto* node = new VisualHeapNode{value, index, circle, label};
-    m_nodes.append(node);
-
     if (index > 0) {
-        int parent = (index - 1) / 2;
-        QPointF p = getPosition(parent);
-        node->lineToParent = m_scene->addLine(QLineF(p, pos), QPen(QColor("#ABB2BF"), 2));
+        node->lineToParent = m_scene->addLine(QLineF(pos, pos));
         node->lineToParent->setZValue(0);
     }
+    m_nodes.append(node);
+    applyNodeStyle(node);
+    placeNode(node, pos);
+
+    relayout();
 }
 
-void VisualHeap::swap(int i, int j) {
-    if (i < 0 || j < 0 || i >= m_nodes.size() || j >= m_nodes.size()) return;
+QPen VisualHeap::penFor(int index) const {
+    const qreal penWidth = m_radius > 15 ? 2 : 1;
+    if (index == m_siftNode)
+        return QPen(QColor("#E5C07B"), penWidth * 2);
+    if (m_compared.contains(index))
+        return QPen(QColor("#61AFEF"), penWidth * 2);
+    return QPen(QColor("#ABB2BF"), penWidth);
+}
 
-    auto* nodeA = m_nodes[i];
-    auto* nodeB = m_nodes[j];
-    nodeA->circle->setBrush(QColor("#E06C75"));
-    nodeB->circle->setBrush(QColor("#E06C75"));
+QColor VisualHeap::restingColor(int index) const {
+    return index >= m_sortedFrom ? QColor("#98C379") : QColor("#707070");
+}
 
-    auto animateScale = [](QGraphicsItem* item) {
-        auto* scaleAnim = new QVariantAnimation();
-        scaleAnim->setStartValue(1.0);
-        scaleAnim->setKeyValueAt(0.5, 1.25);
-        scaleAnim->setEndValue(1.0);
-        scaleAnim->setDuration(600);
-        scaleAnim->setEasingCurve(QEasingCurve::OutBack);
+void VisualHeap::setSiftNode(int index) {
+    const int previous = m_siftNode;
+    m_siftNode = index;
+    if (previous >= 0 && previous < m_nodes.size())
+        m_nodes[previous]->circle->setPen(penFor(previous));
+    if (index >= 0 && index < m_nodes.size())
+        m_nodes[index]->circle->setPen(penFor(index));
+}
 
-        QObject::connect(scaleAnim, &QVariantAnimation::valueChanged, [item](const QVariant &value) {
-            item->setScale(value.toReal());
-        });
+void VisualHeap::updatePhaseLabel() {
+    if (!m_phaseLabel) {
+        m_phaseLabel = new LodTextItem(QString());
+        m_phaseLabel->setFont(QFont("Segoe UI", 10, QFont::Bold));
+        m_phaseLabel->setDefaultTextColor(QColor("#ABB2BF"));
+        m_phaseLabel->setZValue(3);
+        m_phaseLabel->setPos(10, 4);
+        m_scene->addItem(m_phaseLabel);
+    }
 
-        scaleAnim->start(QAbstractAnimation::DeleteWhenStopped);
-     };
+    const QString build = QString("%1：比较 %2 · 交换 %3").arg(m_buildName).arg(m_comparisons[Building]).arg(m_swaps[Building]);
+    if (m_phase == Building)
+        m_phaseLabel->setPlainText(build);
+    else
+        m_phaseLabel->setPlainText(build + QString("\n排序：比较 %1 · 交换 %2").arg(m_comparisons[Sorting]).arg(m_swaps[Sorting]));
+}
 
-     animateScale(nodeA->circle);
-     animateScale(nodeB->circle);
+void VisualHeap::heapify(int mode, int n) {
+    Q_UNUSED(n);
+    m_buildName = HeapSort::buildName(static_cast<HeapSort::Build>(qBound(0, mode, static_cast<int>(HeapSort::Floyd))));
+    m_phase = Building;
+    updatePhaseLabel();
+}
 
-     // 延迟恢复原色
-     QTimer::singleShot(600, [=]() {
-        nodeA->circle->setBrush(QColor("#707070"));
-        nodeB->circle->setBrush(QColor("#707070"));
-     });
+void VisualHeap::siftUp(int index) {
+    setSiftNode(index);
+}
 
-     // 值交换 + 更新 label
-     std::swap(nodeA->value, nodeB->value);
-     nodeA->label->setPlainText(QString::number(nodeA->value));
-     nodeB->label->setPlainText(QString::number(nodeB->value));
+void VisualHeap::siftDown(int root, int size) {
+    Q_UNUSED(size);   // 范围之外的节点已由 extractMax 标为就位
+    setSiftNode(root);
 }
 
-void VisualHeap::up(int from, int to) {
-    swap(from, to);
+void VisualHeap::compare(int i, int j) {
+    auto refreshPens = [this](const QVector<int>& indices) {
+        for (int index : indices)
+            if (index >= 0 && index < m_nodes.size())
+                m_nodes[index]->circle->setPen(penFor(index));
+    };
+    const QVector<int> previous = m_compared;
+    m_compared = {i, j};
+    refreshPens(previous);
+    refreshPens(m_compared);
+
+    ++m_comparisons[m_phase];
+    updatePhaseLabel();
 }
 
-void VisualHeap::down(int from, int to) {
-    swap(from, to);
+void VisualHeap::finish() {
+    m_sortedFrom = 0;
+    m_compared.clear();
+    setSiftNode(-1);
+    for (auto* node : m_nodes) {
+        node->circle->setPen(penFor(node->index));
+        node->circle->setBrush(restingColor(node->index));
+    }
 }
 
-void VisualHeap::extractMax(int last) {
-    if (m_nodes.isEmpty()) return;
+int VisualHeap::comparisons(Phase phase) const {
+    return m_comparisons[phase];
+}
 
-    auto* nodeA = m_nodes[0];
-    auto* nodeB = m_nodes[last];
+int VisualHeap::swaps(Phase phase) const {
+    return m_swaps[phase];
+}
 
+void VisualHeap::swap(int i, int j) {
+    if (i < 0 || j < 0 || i >= m_nodes.size() || j >= m_nodes.size()) return;
+
+    auto* nodeA = m_nodes[i];
+    auto* nodeB = m_nodes[j];
     nodeA->circle->setBrush(QColor("#E06C75"));
     nodeB->circle->setBrush(QColor("#E06C75"));
 
@@ -125,33 +301,25 @@ void VisualHeap::extractMax(int last) {
      animateScale(nodeA->circle);
      animateScale(nodeB->circle);
 
-     // 延迟恢复原色
-     QTimer::singleShot(600, [=]() {
-        nodeA->circle->setBrush(QColor("#707070"));
-        nodeB->circle->setBrush(QColor("#707070"));
+     // 延迟恢复原色，已就位的节点恢复为绿色
+     QTimer::singleShot(600, this, [=]() {
+        nodeA->circle->setBrush(restingColor(i));
+        nodeB->circle->setBrush(restingColor(j));
      });
 
+     ++m_swaps[m_phase];
+     updatePhaseLabel();
+
      // 值交换 + 更新 label
      std::swap(nodeA->value, nodeB->value);
      nodeA->label->setPlainText(QString::number(nodeA->value));
      nodeB->label->setPlainText(QString::number(nodeB->value));
 }
 
-void VisualHeap::animateNode(VisualHeapNode* node, QPointF endPos, int duration) {
-    QPointF startPos = node->circle->pos();
-
-    auto* anim = new QVariantAnimation();
-    anim->setStartValue(startPos);
-    anim->setEndValue(endPos);
-    anim->setDuration(duration);
-    anim->setEasingCurve(QEasingCurve::OutCubic);
-
-    connect(anim, &QVariantAnimation::valueChanged, this, [=](const QVariant &value) {
-        QPointF pos = value.toPointF();
-        node->circle->setPos(pos);
-        node->label->setPos(pos.x() - node->label->boundingRect().width() / 2,
-                            pos.y() - node->label->boundingRect().height() / 2);
-    });
-
-    anim->start(QAbstractAnimation::DeleteWhenStopped);
+void VisualHeap::extractMax(int last) {
+    if (last <= 0 || last >= m_nodes.size()) return;
+    m_phase = Sorting;
+    m_sortedFrom = last;
+    setSiftNode(-1);
+    swap(0, last);
 }
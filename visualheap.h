@@ -12,6 +12,9 @@
 #include <QMap>
 #include <QSize>
 #include <QTimer>
+#include <QPointer>
+#include <QVariantAnimation>
+#include "loditems.h"
 
 struct VisualHeapNode {
     int value;
@@ -24,6 +27,8 @@ struct VisualHeapNode {
         : value(val), index(idx), circle(c), label(l), lineToParent(nullptr) {}
 };
 
+// 堆的树形视图：布局随节点数、层数与视图大小伸缩，叉数可选（二叉、4 叉、8 叉）
+// 叶子按从左到右的顺序等距排开，内部节点居于首末孩子之间；放不下时缩小节点并让视图整体缩放
 class VisualHeap : public QObject {
     Q_OBJECT
 
@@ -32,23 +37,58 @@ public:
     ~VisualHeap();
 
     void clear();
+    void setArity(int arity);       // 在插入节点之前设置；不支持的叉数按二叉堆处理
+    int arity() const;
+    int levels() const;             // 当前层数
+
+    // 建堆与排序两个阶段分别统计比较、交换次数；第一次 EXTRACT_MAX 起进入排序阶段
+    enum Phase {
+        Building,
+        Sorting
+    };
 
     void insert(int value);
+    void heapify(int mode, int n);      // HEAPIFY：mode 为 HeapSort::Build
+    void siftUp(int index);             // SIFT_UP：标出开始上浮的节点
+    void siftDown(int root, int size);  // SIFT_DOWN：标出开始下沉的节点
+    void compare(int i, int j);
     void swap(int i, int j);
-    void up(int from, int to);
-    void down(int from, int to);
-    void extractMax(int last);
+    void extractMax(int last);          // 堆顶与 last 交换，last 起的节点已就位
+    void finish();
+
+    int comparisons(Phase phase) const;
+    int swaps(Phase phase) const;
 
     QVector<VisualHeapNode*> m_nodes;
 
 private:
-    QPointF getPosition(int index) const;
-    void animateNode(VisualHeapNode* node, QPointF endPos, int duration = 300);
+    qreal layoutSubtree(int index, int depth, qreal* nextLeaf, QVector<QPointF>* layout) const;
+    QVector<QPointF> computeLayout();   // 同时更新节点半径
+    void relayout(int duration = 300);   // 节点平滑移动到新布局，连线随之更新
+    void placeNode(VisualHeapNode* node, QPointF pos);
+    void applyNodeStyle(VisualHeapNode* node);
+    void fitView(const QVector<QPointF>& positions);
     void updateLines();
+    QPen penFor(int index) const;
+    QColor restingColor(int index) const;   // 交换高亮结束后恢复的颜色
+    void setSiftNode(int index);
+    void updatePhaseLabel();
 
     QGraphicsScene* m_scene;
     QGraphicsView* m_view;
     QSize m_areaSize;
+    int m_arity;
+    qreal m_radius;
+    QPointer<QVariantAnimation> m_layoutAnimation;
+
+    Phase m_phase;
+    QString m_buildName;
+    int m_comparisons[2];
+    int m_swaps[2];
+    int m_sortedFrom;               // 下标不小于该值的节点已排好
+    int m_siftNode;                 // 当前上浮/下沉的起点，-1 表示无
+    QVector<int> m_compared;        // 最近一次比较的两个节点
+    LodTextItem* m_phaseLabel;
 };
 
 #endif // VISUALHEAP_H
@@ -0,0 +1,76 @@
+#include "visuallayoutsearch.h"
+
+VisualLayoutSearch::VisualLayoutSearch(QGraphicsScene* scene, QSize areaSize)
+    : m_scene(scene), m_areaSize(areaSize), m_target(0) {}
+
+void VisualLayoutSearch::clear() {
+    m_maps.clear(); // 图元随场景一起释放
+    m_values.clear();
+    m_target = 0;
+}
+
+void VisualLayoutSearch::insertValue(int value) {
+    m_values.append(value);
+}
+
+void VisualLayoutSearch::build() {
+    const qreal panelHeight = static_cast<qreal>(m_areaSize.height()) / SearchLayout::KindCount;
+    for (int k = 0; k < SearchLayout::KindCount; ++k) {
+        const SearchLayout::Kind kind = static_cast<SearchLayout::Kind>(k);
+        SearchLayout::Layout layout(kind, m_values.constData(), m_values.size(), true);
+        QVector<int> values;
+        QVector<int> ranks;
+        for (qint64 pos = 0; pos < layout.memorySize(); ++pos) {
+            values.append(layout.memory()[pos]);
+            ranks.append(static_cast<int>(layout.rankAt(pos)));
+        }
+
+        CacheLineMapItem* item = new CacheLineMapItem(SearchLayout::kindName(kind), QSizeF(m_areaSize.width(), panelHeight));
+        item->setMemory(values, ranks);
+        item->setPos(0, k * panelHeight);
+        item->setZValue(1);
+        m_scene->addItem(item);
+        m_maps.append(item);
+    }
+}
+
+CacheLineMapItem* VisualLayoutSearch::map(int kind) const {
+    return kind >= 0 && kind < m_maps.size() ? m_maps[kind] : nullptr;
+}
+
+void VisualLayoutSearch::beginQuery(int target) {
+    if (m_maps.isEmpty())
+        build();
+    m_target = target;
+    for (CacheLineMapItem* item : m_maps)
+        item->beginQuery();
+}
+
+void VisualLayoutSearch::probe(int kind, int pos) {
+    if (CacheLineMapItem* item = map(kind))
+        item->probe(pos);
+}
+
+void VisualLayoutSearch::result(int kind, int pos, int rank) {
+    Q_UNUSED(rank);
+    if (CacheLineMapItem* item = map(kind))
+        item->setResult(pos);
+}
+
+void VisualLayoutSearch::finish() {
+    for (CacheLineMapItem* item : m_maps)
+        item->update();
+}
+
+int VisualLayoutSearch::currentTarget() const {
+    return m_target;
+}
+
+int VisualLayoutSearch::queryCount() const {
+    return m_maps.isEmpty() ? 0 : m_maps.first()->queryCount();
+}
+
+double VisualLayoutSearch::averageLines(int kind) const {
+    CacheLineMapItem* item = map(kind);
+    return item ? item->averageLines() : 0;
+}
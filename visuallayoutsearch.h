@@ -0,0 +1,41 @@
+#ifndef VISUALLAYOUTSEARCH_H
+#define VISUALLAYOUTSEARCH_H
+
+#include "cachelinemapitem.h"
+#include "searchlayout.h"
+#include <QObject>
+#include <QGraphicsScene>
+#include <QSize>
+#include <QVector>
+
+// 缓存友好查找可视化：有序数组、Eytzinger、B 树分块三种布局的内存图上下排列，
+// 同一查询在各布局上探查的槽位与触及的缓存行同时可见
+class VisualLayoutSearch : public QObject {
+    Q_OBJECT
+
+public:
+    VisualLayoutSearch(QGraphicsScene* scene, QSize areaSize);
+    void clear();
+
+    void insertValue(int value);                 // INSERT，轨迹中的输入已排好序
+    void beginQuery(int target);                 // LAYOUT_QUERY
+    void probe(int kind, int pos);               // LAYOUT_PROBE
+    void result(int kind, int pos, int rank);    // LAYOUT_RESULT
+    void finish();                               // SORT_FINISHED
+
+    int currentTarget() const;
+    int queryCount() const;
+    double averageLines(int kind) const;         // 该布局平均每次查询触及的缓存行数
+
+private:
+    void build();                                // 首次查询时按收集到的键构建三种布局的内存图
+    CacheLineMapItem* map(int kind) const;
+
+    QVector<CacheLineMapItem*> m_maps;
+    QVector<int> m_values;
+    QGraphicsScene* m_scene;
+    QSize m_areaSize;
+    int m_target;
+};
+
+#endif // VISUALLAYOUTSEARCH_H
@@ -0,0 +1,82 @@
+#include "visualparallelsort.h"
+
+static const qreal kHistogramShare = 0.62;   // 柱状图占视图高度的比例，其余留给时间线
+
+VisualParallelSort::VisualParallelSort(QGraphicsScene* scene, QSize areaSize)
+    : m_histogram(nullptr), m_timeline(nullptr), m_scene(scene), m_areaSize(areaSize) {}
+
+void VisualParallelSort::clear() {
+    m_histogram = nullptr; // 图元随场景一起释放
+    m_timeline = nullptr;
+}
+
+HistogramItem* VisualParallelSort::histogram() {
+    if (!m_histogram) {
+        m_histogram = new HistogramItem(QSizeF(m_areaSize.width(), m_areaSize.height() * kHistogramShare));
+        m_histogram->setZValue(1);
+        m_scene->addItem(m_histogram);
+    }
+    return m_histogram;
+}
+
+WorkerTimelineItem* VisualParallelSort::timeline() {
+    if (!m_timeline) {
+        const qreal top = m_areaSize.height() * kHistogramShare;
+        m_timeline = new WorkerTimelineItem(QSizeF(m_areaSize.width(), m_areaSize.height() - top));
+        m_timeline->setPos(0, top);
+        m_timeline->setZValue(1);
+        m_scene->addItem(m_timeline);
+    }
+    return m_timeline;
+}
+
+void VisualParallelSort::insertValue(int value) {
+    histogram()->append(value);
+}
+
+void VisualParallelSort::init(int workers) {
+    timeline()->setWorkerCount(workers);
+}
+
+void VisualParallelSort::beginTask(int worker, int lo, int hi) {
+    Q_UNUSED(lo);
+    Q_UNUSED(hi);
+    timeline()->setBusy(worker, true);
+    timeline()->tick();
+}
+
+void VisualParallelSort::idle(int worker) {
+    timeline()->setBusy(worker, false);
+    timeline()->tick();
+}
+
+void VisualParallelSort::write(int index, int value, int worker) {
+    HistogramItem* item = histogram();
+    item->setValue(index, value);
+    item->setOwner(index, worker);
+    timeline()->tick();
+}
+
+void VisualParallelSort::steal(int worker, int victim) {
+    Q_UNUSED(victim);
+    timeline()->markSteal(worker);
+}
+
+void VisualParallelSort::finish() {
+    WorkerTimelineItem* item = timeline();
+    for (int w = 0; w < item->workerCount(); ++w)
+        item->setBusy(w, false);
+    item->update();
+}
+
+int VisualParallelSort::workerCount() const {
+    return m_timeline ? m_timeline->workerCount() : 0;
+}
+
+double VisualParallelSort::utilization(int worker) const {
+    return m_timeline ? m_timeline->utilization(worker) : 0;
+}
+
+int VisualParallelSort::stealCount(int worker) const {
+    return m_timeline ? m_timeline->stealCount(worker) : 0;
+}
@@ -0,0 +1,40 @@
+#ifndef VISUALPARALLELSORT_H
+#define VISUALPARALLELSORT_H
+
+#include "histogramitem.h"
+#include "workertimelineitem.h"
+#include <QObject>
+#include <QGraphicsScene>
+#include <QSize>
+
+// 并行排序可视化：上方柱状图按最后写入的工作者着色，下方为各工作者的忙碌/空闲时间线
+class VisualParallelSort : public QObject {
+    Q_OBJECT
+
+public:
+    VisualParallelSort(QGraphicsScene* scene, QSize areaSize);
+    void clear();
+
+    void insertValue(int value);
+    void init(int workers);                      // PAR_INIT
+    void beginTask(int worker, int lo, int hi);  // PAR_TASK
+    void idle(int worker);                       // PAR_IDLE
+    void write(int index, int value, int worker); // PAR_WRITE
+    void steal(int worker, int victim);          // PAR_STEAL
+    void finish();                               // SORT_FINISHED
+
+    int workerCount() const;
+    double utilization(int worker) const;
+    int stealCount(int worker) const;
+
+private:
+    HistogramItem* histogram();                  // 首次使用时创建图元
+    WorkerTimelineItem* timeline();
+
+    HistogramItem* m_histogram;
+    WorkerTimelineItem* m_timeline;
+    QGraphicsScene* m_scene;
+    QSize m_areaSize;
+};
+
+#endif // VISUALPARALLELSORT_H
@@ -1,175 +1,99 @@
 #include "visualquicksort.h"
 
 VisualQuickSort::VisualQuickSort(QGraphicsScene* scene, QSize areaSize)
-    : m_scene(scene), m_areaSize(areaSize) {}
+    : m_histogram(nullptr), m_scene(scene), m_areaSize(areaSize) {}
 
 void VisualQuickSort::clear() {
-    m_nodes.clear();
+    m_histogram = nullptr; // 图元随场景一起释放
+    m_transient.clear();
     pivotIndices.clear();
 }
 
-QPointF VisualQuickSort::getBarPosition(int index, int barHeight) const {
-    const int spacing = 16;
-    const int barWidth = 36;
-    int x = index * (barWidth + spacing) + (m_areaSize.width() - (barWidth + spacing) * 10) / 2;
-    int y = m_areaSize.height() - barHeight - 50;
-    return QPointF(x, y);
+HistogramItem* VisualQuickSort::histogram() {
+    if (!m_histogram) {
+        m_histogram = new HistogramItem(m_areaSize);
+        m_histogram->setZValue(1);
+        m_scene->addItem(m_histogram);
+    }
+    return m_histogram;
+}
+
+void VisualQuickSort::restoreState(int index) {
+    if (m_histogram->state(index) == HistogramItem::Sorted) return;
+    m_histogram->setState(index, pivotIndices.contains(index) ? HistogramItem::Pivot : HistogramItem::Normal);
+}
+
+void VisualQuickSort::clearTransient() {
+    for (int index : m_transient)
+        restoreState(index);
+    m_transient.clear();
 }
 
 void VisualQuickSort::insertValue(int value) {
-    const int barWidth = 36;
-    int index = m_nodes.size();
-    int maxHeight = m_areaSize.height() - 140;
-    int barHeight = qMin(maxHeight, value * 4);
-
-    QPointF pos = getBarPosition(index, barHeight);
-
-    auto bar = new QGraphicsRectItem(0, 0, barWidth, barHeight);
-    bar->setBrush(QColor("#707070"));
-    bar->setPen(QPen(QColor("#E0E0E0"), 2));
-    bar->setZValue(1);
-    bar->setOpacity(0);
-    bar->setScale(0.7);
-    bar->setPos(pos);
-    m_scene->addItem(bar);
-
-    auto label = new QGraphicsTextItem(QString::number(value));
-    label->setDefaultTextColor(QColor("#ABB2BF"));
-    label->setFont(QFont("Segoe UI", 12, QFont::Bold));
-    label->setZValue(2);
-    label->setOpacity(0);
-    label->setPos(pos.x() + barWidth / 2 - label->boundingRect().width() / 2, m_areaSize.height() - 35);
-    m_scene->addItem(label);
-
-    m_nodes.append(new VisualNode{value, bar, label});
-
-    auto anim1 = new QVariantAnimation();
-    anim1->setStartValue(0.0);
-    anim1->setEndValue(1.0);
-    anim1->setDuration(400);
-    anim1->setEasingCurve(QEasingCurve::OutCubic);
-    connect(anim1, &QVariantAnimation::valueChanged, [bar, label](const QVariant& v) {
-        bar->setOpacity(v.toDouble());
-        label->setOpacity(v.toDouble());
-    });
-    anim1->start(QAbstractAnimation::DeleteWhenStopped);
-
-    auto anim2 = new QVariantAnimation();
-    anim2->setStartValue(0.7);
-    anim2->setEndValue(1.0);
-    anim2->setDuration(400);
-    anim2->setEasingCurve(QEasingCurve::OutBack);
-    connect(anim2, &QVariantAnimation::valueChanged, [bar](const QVariant& v) {
-        bar->setScale(v.toDouble());
-    });
-    anim2->start(QAbstractAnimation::DeleteWhenStopped);
+    histogram()->append(value);
 }
 
 void VisualQuickSort::setPivot(int index) {
-    if (index < 0 || index >= m_nodes.size()) return;
+    if (!m_histogram || index < 0 || index >= m_histogram->count()) return;
+    clearTransient();
+
+    // 新区间开始划分，上一个区间的主元标记不再有意义
+    QSet<int> previous = pivotIndices;
+    pivotIndices.clear();
+    for (int old : previous)
+        restoreState(old);
+
     pivotIndices.insert(index);
-    auto node = m_nodes[index];
-    node->bar->setBrush(QColor("#C678DD"));
+    m_histogram->setState(index, HistogramItem::Pivot);
 }
 
-void VisualQuickSort::compareA(int i, int pivot_index) {
-    animateHighlight(i);
-    animateHighlight(pivot_index);
-    if (i < 0 || i >= m_nodes.size()) return;
-    if (m_nodes[i]->value > m_nodes[pivot_index]->value) {
-        m_nodes[i]->bar->setBrush(QColor("#E5C07B"));
+void VisualQuickSort::highlightCompare(int index, int pivot_index, bool greater) {
+    if (!m_histogram) return;
+    clearTransient();
+    if (index < 0 || index >= m_histogram->count()) return;
+    if (pivot_index < 0 || pivot_index >= m_histogram->count()) return;
+
+    // 找到需要交换的元素时标记为黄色，直到下一个事件
+    int value = m_histogram->value(index);
+    int pivot = m_histogram->value(pivot_index);
+    if (greater ? value > pivot : value < pivot) {
+        m_histogram->setState(index, HistogramItem::Compare);
+        m_transient.append(index);
     }
 }
 
-void VisualQuickSort::compareB(int j, int pivot_index) {
-    animateHighlight(j);
-    animateHighlight(pivot_index);
-    if (j < 0 || j >= m_nodes.size()) return;
-    if (m_nodes[j]->value < m_nodes[pivot_index]->value) {
-        m_nodes[j]->bar->setBrush(QColor("#E5C07B"));
-    }
+void VisualQuickSort::compareA(int i, int pivot_index) {
+    highlightCompare(i, pivot_index, true);
 }
 
-void VisualQuickSort::swap(int i, int j) {
-    if (i < 0 || j < 0 || i >= m_nodes.size() || j >= m_nodes.size() || i == j) return;
-
-    auto nodeA = m_nodes[i];
-    auto nodeB = m_nodes[j];
-
-    animateSwap(i, j);
-
-    QTimer::singleShot(400, [=]() {
-        // 恢复颜色（如果是主元，恢复紫色）
-        nodeA->bar->setBrush(pivotIndices.contains(i) ? QColor("#C678DD") : QColor("#707070"));
-        nodeB->bar->setBrush(pivotIndices.contains(j) ? QColor("#C678DD") : QColor("#707070"));
-    });
+void VisualQuickSort::compareB(int j, int pivot_index) {
+    highlightCompare(j, pivot_index, false);
 }
 
-void VisualQuickSort::markSorted(int index) {
-    if (index < 0 || index >= m_nodes.size()) return;
-    m_nodes[index]->bar->setBrush(QColor("#98C379"));
+void VisualQuickSort::compare(int i, int j) {
+    if (!m_histogram) return;
+    clearTransient();
+    for (int index : {i, j}) {
+        if (index < 0 || index >= m_histogram->count()) continue;
+        if (m_histogram->state(index) == HistogramItem::Sorted) continue;
+        m_histogram->setState(index, HistogramItem::Compare);
+        m_transient.append(index);
+    }
 }
 
-void VisualQuickSort::animateSwap(int i, int j) {
-    auto nodeA = m_nodes[i];
-    auto nodeB = m_nodes[j];
-
-    int heightA = nodeA->bar->rect().height();
-    int heightB = nodeB->bar->rect().height();
-
-    QPointF targetPosA = getBarPosition(j, heightA);
-    QPointF targetPosB = getBarPosition(i, heightB);
-
-    auto group = new QParallelAnimationGroup();
-
-    auto animA = new QVariantAnimation();
-    animA->setDuration(400);
-    animA->setStartValue(nodeA->bar->pos());
-    animA->setEndValue(targetPosA);
-    animA->setEasingCurve(QEasingCurve::OutCubic);
-    connect(animA, &QVariantAnimation::valueChanged, [=](const QVariant& value) {
-        nodeA->bar->setPos(value.toPointF());
-        nodeA->label->setPos(QPointF(value.toPointF().x() + 18 - nodeA->label->boundingRect().width() / 2, m_areaSize.height() - 35));
-    });
-    group->addAnimation(animA);
-
-    auto animB = new QVariantAnimation();
-    animB->setDuration(400);
-    animB->setStartValue(nodeB->bar->pos());
-    animB->setEndValue(targetPosB);
-    animB->setEasingCurve(QEasingCurve::OutCubic);
-    connect(animB, &QVariantAnimation::valueChanged, [=](const QVariant& value) {
-        nodeB->bar->setPos(value.toPointF());
-        nodeB->label->setPos(QPointF(value.toPointF().x() + 18 - nodeB->label->boundingRect().width() / 2, m_areaSize.height() - 35));
-    });
-    group->addAnimation(animB);
-
-    connect(group, &QParallelAnimationGroup::finished, [=]() {
-        std::swap(m_nodes[i], m_nodes[j]);
-        group->deleteLater();
-    });
-
-    group->start();
+void VisualQuickSort::swap(int i, int j) {
+    if (!m_histogram) return;
+    if (i < 0 || j < 0 || i >= m_histogram->count() || j >= m_histogram->count() || i == j) return;
+    clearTransient();
+
+    m_histogram->swapValues(i, j);
+    m_histogram->setState(i, HistogramItem::Swap);
+    m_histogram->setState(j, HistogramItem::Swap);
+    m_transient << i << j;
 }
 
-void VisualQuickSort::animateHighlight(int index) {
-    if (index < 0 || index >= m_nodes.size()) return;
-
-    auto node = m_nodes[index];
-
-    auto anim = new QVariantAnimation();
-    anim->setStartValue(1.0);
-    anim->setEndValue(1.1);
-    anim->setDuration(300);
-    anim->setEasingCurve(QEasingCurve::OutBack);
-
-    connect(anim, &QVariantAnimation::valueChanged, [bar = node->bar](const QVariant& value) {
-        bar->setScale(value.toDouble());
-    });
-
-    connect(anim, &QVariantAnimation::finished, [bar = node->bar]() {
-        bar->setScale(1.0);
-    });
-
-    anim->start(QAbstractAnimation::DeleteWhenStopped);
+void VisualQuickSort::markSorted(int index) {
+    if (!m_histogram || index < 0 || index >= m_histogram->count()) return;
+    clearTransient();
+    m_histogram->setState(index, HistogramItem::Sorted);
 }
@@ -2,19 +2,12 @@
 #ifndef VISUALQUICKSORT_H
 #define VISUALQUICKSORT_H
 
+#include "histogramitem.h"
 #include <QObject>
 #include <QGraphicsScene>
-#include <QGraphicsRectItem>
-#include <QGraphicsTextItem>
-#include <QParallelAnimationGroup>
-#include <QVariantAnimation>
-#include <QPropertyAnimation>
-#include <QEasingCurve>
 #include <QSize>
 #include <QSet>
 #include <QVector>
-#include <QTimer>
-#include <QDebug>
 
 class VisualQuickSort : public QObject {
     Q_OBJECT
@@ -25,25 +18,22 @@ public:
     void setPivot(int index);         // 设置主元标记（紫色）
     void compareA(int i, int pivot_index);
     void compareB(int j, int pivot_index);
-    void swap(int i, int j);          // 动画交换两个元素
+    void compare(int i, int j);       // 一般比较（内省排序的各划分方式、插入排序、堆排序回退）
+    void swap(int i, int j);          // 交换两个元素
     void markSorted(int index);       // 标记某个元素为已排序
     void clear();                     // 清除场景元素
-    void animateSwap(int i, int j);
-    void animateHighlight(int index);
 
 private:
-    struct VisualNode {
-        int value;
-        QGraphicsRectItem* bar;
-        QGraphicsTextItem* label;
-    };
+    HistogramItem* histogram();       // 首次插入时创建柱状图图元
+    void clearTransient();            // 清除上一步的比较/交换高亮
+    void restoreState(int index);     // 恢复为主元/普通颜色
+    void highlightCompare(int index, int pivot_index, bool greater);
 
-    QSet<int> pivotIndices;             // 记录主元颜色
-    QVector<VisualNode*> m_nodes;
+    QSet<int> pivotIndices;             // 记录主元颜色（只保留当前区间的主元）
+    HistogramItem* m_histogram;
+    QVector<int> m_transient;           // 当前带有临时高亮的下标
     QGraphicsScene* m_scene;
     QSize m_areaSize;
-    QPointF getBarPosition(int index, int barHeight) const;
-
 };
 
 #endif // VISUALQUICKSORT_H
@@ -0,0 +1,78 @@
+#include "visualradixsort.h"
+#include <climits>
+
+static const int kMaxLanes = 256;    // 2^16 个数字无法逐条显示，超过时按区间合并
+
+VisualRadixSort::VisualRadixSort(QGraphicsScene* scene, QSize areaSize)
+    : m_lanes(nullptr), m_scene(scene), m_areaSize(areaSize),
+      m_rangeLow(0), m_rangeHigh(-1), m_radix(1), m_laneCount(1) {}
+
+void VisualRadixSort::clear() {
+    m_lanes = nullptr; // 图元随场景一起释放
+}
+
+BucketLanesItem* VisualRadixSort::lanes() {
+    if (!m_lanes) {
+        m_lanes = new BucketLanesItem(m_areaSize);
+        m_lanes->setLaneTitle("数字");
+        m_lanes->setZValue(1);
+        m_scene->addItem(m_lanes);
+    }
+    return m_lanes;
+}
+
+int VisualRadixSort::laneOf(int digit) const {
+    return static_cast<int>(static_cast<qint64>(digit) * m_laneCount / m_radix);
+}
+
+void VisualRadixSort::insertValue(int value) {
+    lanes()->appendInput(value);
+}
+
+void VisualRadixSort::setRange(int low, int high) {
+    m_rangeLow = low;
+    m_rangeHigh = high;
+}
+
+void VisualRadixSort::beginPass(int shift, int bits) {
+    Q_UNUSED(shift);
+    m_radix = 1 << qBound(1, bits, 16);
+    m_laneCount = qMin(m_radix, kMaxLanes);
+
+    BucketLanesItem* item = lanes();
+    item->beginPass(m_laneCount, m_rangeLow, m_rangeHigh < 0 ? INT_MAX : m_rangeHigh);
+    for (int lane = 0; lane < m_laneCount; ++lane) {
+        int first = static_cast<int>(static_cast<qint64>(lane) * m_radix / m_laneCount);
+        int last = static_cast<int>(static_cast<qint64>(lane + 1) * m_radix / m_laneCount) - 1;
+        item->setBucketRange(lane, first, last);
+    }
+
+    // 未给出区间的轨迹每趟都处理整个数组
+    m_rangeLow = 0;
+    m_rangeHigh = -1;
+}
+
+void VisualRadixSort::count(int index, int digit) {
+    if (!m_lanes) return;
+    m_lanes->countInto(index, laneOf(digit));
+}
+
+void VisualRadixSort::prefix() {
+    if (!m_lanes) return;
+    m_lanes->computePrefix();
+}
+
+void VisualRadixSort::scatter(int index, int dest, int digit) {
+    if (!m_lanes) return;
+    m_lanes->scatter(index, dest, laneOf(digit));
+}
+
+void VisualRadixSort::endPass() {
+    if (!m_lanes) return;
+    m_lanes->endPass();
+}
+
+void VisualRadixSort::finish() {
+    if (!m_lanes) return;
+    m_lanes->setAllFinal();
+}
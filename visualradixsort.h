@@ -0,0 +1,40 @@
+#ifndef VISUALRADIXSORT_H
+#define VISUALRADIXSORT_H
+
+#include "bucketlanesitem.h"
+#include <QObject>
+#include <QGraphicsScene>
+#include <QSize>
+
+// 基数排序可视化：复用桶道视图，每趟依次展示直方图、前缀和与散射
+// 基数超过桶道上限时，相邻数字合并到同一条桶道
+class VisualRadixSort : public QObject {
+    Q_OBJECT
+
+public:
+    VisualRadixSort(QGraphicsScene* scene, QSize areaSize);
+    void clear();
+
+    void insertValue(int value);
+    void setRange(int low, int high);              // RADIX_RANGE：下一趟的区间
+    void beginPass(int shift, int bits);           // RADIX_PASS
+    void count(int index, int digit);              // RADIX_COUNT
+    void prefix();                                 // RADIX_PREFIX
+    void scatter(int index, int dest, int digit);  // RADIX_SCATTER
+    void endPass();                                // RADIX_DONE
+    void finish();                                 // SORT_FINISHED
+
+private:
+    BucketLanesItem* lanes();        // 首次使用时创建图元
+    int laneOf(int digit) const;
+
+    BucketLanesItem* m_lanes;
+    QGraphicsScene* m_scene;
+    QSize m_areaSize;
+    int m_rangeLow;
+    int m_rangeHigh;                 // -1 表示整个数组
+    int m_radix;
+    int m_laneCount;
+};
+
+#endif // VISUALRADIXSORT_H
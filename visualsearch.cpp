@@ -1,91 +1,86 @@
 #include "visualsearch.h"
+#include <cmath>
 
 VisualBinarySearch::VisualBinarySearch(QGraphicsScene* scene, QSize areaSize)
-    : m_scene(scene), m_areaSize(areaSize) {}
+    : m_histogram(nullptr), m_caption(nullptr), m_marker(nullptr), m_scene(scene), m_areaSize(areaSize),
+      m_probes(0), m_mid(-1) {}
 
 void VisualBinarySearch::clear() {
-    m_nodes.clear();
+    m_histogram = nullptr; // 图元随场景一起释放
+    m_caption = nullptr;
+    m_marker = nullptr;
+    m_probes = 0;
+    m_mid = -1;
 }
 
-void VisualBinarySearch::insertValue(int value) {
-    const int spacing = 16;
-    const int barWidth = 36;
-    int x = (m_nodes.size()) * (barWidth + spacing) + (m_areaSize.width() - (barWidth + spacing) * qMax(1, m_nodes.size() + 1)) / 2;
-    int maxHeight = m_areaSize.height() - 140;
-    int barHeight = qMin(maxHeight, value * 4);
-    int y = m_areaSize.height() - barHeight - 50;
+int VisualBinarySearch::probes() const {
+    return m_probes;
+}
 
-    auto bar = m_scene->addRect(x, y, barWidth, barHeight, QPen(QColor("#E0E0E0"), 2), QBrush(QColor("#707070")));
-    bar->setZValue(1);
-    bar->setOpacity(0);
-    bar->setScale(0.7);
+HistogramItem* VisualBinarySearch::histogram() {
+    if (!m_histogram) {
+        m_histogram = new HistogramItem(m_areaSize);
+        m_histogram->setZValue(1);
+        m_scene->addItem(m_histogram);
 
-    auto label = m_scene->addText(QString::number(value), QFont("Segoe UI", 12, QFont::Bold));
-    label->setDefaultTextColor(QColor("#ABB2BF"));
-    label->setZValue(2);
-    label->setPos(x + barWidth / 2 - label->boundingRect().width() / 2, m_areaSize.height() - 35);
-    label->setOpacity(0);
+        m_caption = m_scene->addText(QString(), QFont("Segoe UI", 11, QFont::Bold));
+        m_caption->setDefaultTextColor(QColor("#ABB2BF"));
+        m_caption->setPos(40, 10);
+        m_caption->setZValue(2);
 
-    m_nodes.append(new VisualNode{value, bar, label});
+        QPolygonF triangle;
+        triangle << QPointF(-7, 0) << QPointF(7, 0) << QPointF(0, 10);
+        m_marker = m_scene->addPolygon(triangle, QPen(Qt::NoPen), QBrush(QColor("#E5C07B")));
+        m_marker->setZValue(2);
+        m_marker->setVisible(false);
+    }
+    return m_histogram;
+}
 
-    auto anim1 = new QVariantAnimation();
-    anim1->setStartValue(0.0);
-    anim1->setEndValue(1.0);
-    anim1->setDuration(400);
-    anim1->setEasingCurve(QEasingCurve::OutCubic);
-    connect(anim1, &QVariantAnimation::valueChanged, [bar, label](const QVariant &v) {
-        bar->setOpacity(v.toDouble());
-        label->setOpacity(v.toDouble());
-    });
-    anim1->start(QAbstractAnimation::DeleteWhenStopped);
+void VisualBinarySearch::insertValue(int value) {
+    histogram()->append(value);
+}
 
-    auto anim2 = new QVariantAnimation();
-    anim2->setStartValue(0.7);
-    anim2->setEndValue(1.0);
-    anim2->setDuration(400);
-    anim2->setEasingCurve(QEasingCurve::OutBack);
-    connect(anim2, &QVariantAnimation::valueChanged, [bar](const QVariant &v) {
-        bar->setScale(v.toDouble());
-    });
-    anim2->start(QAbstractAnimation::DeleteWhenStopped);
+void VisualBinarySearch::setValues(const QVector<int>& sorted) {
+    histogram()->setValues(sorted);
+    // 四种查找共用本视图；log2 n + 1 只是折半查找的上界，作为参照给出（插值查找在偏斜数据上可能多达 n 步）
+    m_caption->setPlainText(QString("%1 个元素（参照：折半查找至多 %2 步）")
+                            .arg(sorted.size())
+                            .arg(sorted.isEmpty() ? 0 : static_cast<int>(std::floor(std::log2(sorted.size()))) + 1));
+}
+
+// 标记位于柱子上方，与区间阴影的上沿对齐
+void VisualBinarySearch::moveMarker(int index, const QColor& color) {
+    const QRectF column = m_histogram->columnRect(index, index);
+    m_marker->setBrush(color);
+    m_marker->setPos(column.center().x(), 30);
+    m_marker->setVisible(true);
 }
 
 void VisualBinarySearch::highlightRange(int left, int right) {
-    for (int i = 0; i < m_nodes.size(); ++i) {
-        if (i >= left && i <= right) {
-            m_nodes[i]->bar->setBrush(QColor("#282C34"));
-        } else {
-            m_nodes[i]->bar->setBrush(QColor("#707070"));
-        }
-    }
+    histogram()->setBand(left, right);
 }
 
 void VisualBinarySearch::highlightCheck(int left, int right, int mid) {
-    highlightRange(left, right);
-    animateHighlight(mid, QColor("#E5C07B"));
+    HistogramItem* item = histogram();
+    if (mid < 0 || mid >= item->count()) return;
+    ++m_probes;
+    if (m_mid >= 0 && m_mid < item->count())
+        item->setState(m_mid, HistogramItem::Normal);
+    m_mid = mid;
+    item->setState(mid, HistogramItem::Compare);
+    item->setBand(left, right);
+    moveMarker(mid, HistogramItem::stateColor(HistogramItem::Compare));
+    m_caption->setPlainText(QString("第 %1 步：区间 [%2, %3] 共 %4 个，探查 a[%5] = %6")
+                            .arg(m_probes).arg(left).arg(right).arg(right - left + 1)
+                            .arg(mid).arg(item->value(mid)));
 }
 
 void VisualBinarySearch::highlightFound(int index) {
-    auto node = m_nodes[index];
-    node->bar->setBrush(QColor("#98C379"));
-}
-
-void VisualBinarySearch::animateHighlight(int index, const QColor& color) {
-    if (index < 0 || index >= m_nodes.size()) return;
-    auto node = m_nodes[index];
-    node->bar->setBrush(QBrush(color));
-
-    auto anim = new QVariantAnimation();
-    anim->setStartValue(1.0);
-    anim->setEndValue(1.1);
-    anim->setDuration(300);
-    anim->setEasingCurve(QEasingCurve::OutBack);
-
-    connect(anim, &QVariantAnimation::valueChanged, [bar = node->bar](const QVariant& value) {
-        bar->setScale(value.toDouble());
-    });
-    connect(anim, &QVariantAnimation::finished, [bar = node->bar]() {
-        bar->setScale(1.0);
-    });
-    anim->start(QAbstractAnimation::DeleteWhenStopped);
+    HistogramItem* item = histogram();
+    if (index < 0 || index >= item->count()) return;
+    item->setState(index, HistogramItem::Sorted);
+    item->setBand(index, index);
+    moveMarker(index, HistogramItem::stateColor(HistogramItem::Sorted));
+    m_caption->setPlainText(QString("第 %1 步找到：a[%2] = %3").arg(m_probes).arg(index).arg(item->value(index)));
 }
@@ -1,42 +1,43 @@
 #ifndef VISUALSEARCH_H
 #define VISUALSEARCH_H
 
+#include "histogramitem.h"
 #include <QObject>
 #include <QGraphicsScene>
-#include <QGraphicsRectItem>
 #include <QGraphicsTextItem>
-#include <QVariantAnimation>
-#include <QEasingCurve>
+#include <QGraphicsPolygonItem>
 #include <QVector>
 #include <QSize>
-#include <QBrush>
-#include <QPen>
 #include <QString>
 
+// 查找可视化：有序数组画成单个柱状图图元，当前候选区间 [l, r] 以阴影标出，探查位置上方有指示标记
+// 柱宽随元素个数缩放，百万元素的数组也能看清 log2(n) 步逐步收缩的区间
 class VisualBinarySearch : public QObject {
     Q_OBJECT
 
 public:
     VisualBinarySearch(QGraphicsScene* scene, QSize areaSize);
 
-    void insertValue(int value);
+    void insertValue(int value);                  // INSERT，调试运行时逐个输入
+    void setValues(const QVector<int>& sorted);   // 原生运行时整体载入已排序的数组
     void highlightFound(int index);
     void highlightCheck(int left, int right, int mid);
     void highlightRange(int left, int right);
     void clear();
 
+    int probes() const;                       // 已回放的探查次数
+
 private:
-    struct VisualNode {
-        int value;
-        QGraphicsRectItem* bar;
-        QGraphicsTextItem* label;
-    };
+    HistogramItem* histogram();               // 首次使用时创建图元
+    void moveMarker(int index, const QColor& color);
 
-    QVector<VisualNode*> m_nodes;
+    HistogramItem* m_histogram;
+    QGraphicsTextItem* m_caption;             // 步数与当前区间
+    QGraphicsPolygonItem* m_marker;           // 探查位置指示
     QGraphicsScene* m_scene;
     QSize m_areaSize;
-
-    void animateHighlight(int index, const QColor& color);
+    int m_probes;
+    int m_mid;
 };
 
 
@@ -55,12 +55,12 @@ VisualNode* VisualTree::insertVisualNode(VisualNode* parentVisualNode, TreeNode*
     widget->setTransformOriginPoint(0, 0);
 
     // 创建圆形节点
-    auto* ellipse = new QGraphicsEllipseItem(-22, -22, 44, 44, widget);
+    auto* ellipse = new LodEllipseItem(-22, -22, 44, 44, widget);
     ellipse->setPen(QPen(QColor("#E0E0E0"), 2));
     ellipse->setBrush(QBrush(QColor("#707070")));
 
     // 创建文字节点
-    auto* text = new QGraphicsTextItem(QString::number(currentNode->value), widget);
+    auto* text = new LodTextItem(QString::number(currentNode->value), widget);
     QFont font("Segoe UI", 12, QFont::Bold);
     text->setFont(font);
     text->setDefaultTextColor(Qt::white);
@@ -107,39 +107,17 @@ VisualNode* VisualTree::insertVisualNode(VisualNode* parentVisualNode, TreeNode*
     return visualNode;
 }
 
-void VisualTree::rebuild(TreeNode* root) {
-
-    scene->clear();
-    visualRoot = nullptr;
-    nodeMap.clear();
-
-    if (!root) return;
-
-    const int spacingX = 60;
-    const int spacingY = 80;
-    QPointF rootPos(areaSize.width() / 2, 50);
-
-    visualRoot = layoutTreeRecursive(root, nullptr, rootPos, areaSize.width() / 4, spacingX, spacingY, 0);
-
-    resetView();
-}
-
-VisualNode* VisualTree::layoutTreeRecursive(TreeNode* node, VisualNode* parentVisual,
-                                            QPointF center, qreal xOffset,
-                                            int spacingX, int spacingY, int depth) {
-    if (!node) return nullptr;
-
-    QPointF currentPos = center + QPointF(0, depth * spacingY);
-
+// 创建单个结点的图元并连到父结点，左右孩子由 layoutTree 填入
+VisualNode* VisualTree::createVisualNode(int value, VisualNode* parentVisual, QPointF currentPos) {
     auto* widget = new QGraphicsWidget();
     scene->addItem(widget);
     widget->setTransformOriginPoint(0, 0);
 
-    auto* ellipse = new QGraphicsEllipseItem(-22, -22, 44, 44, widget);
+    auto* ellipse = new LodEllipseItem(-22, -22, 44, 44, widget);
     ellipse->setPen(QPen(QColor("#E0E0E0"), 2));
     ellipse->setBrush(QBrush(QColor("#707070")));
 
-    auto* text = new QGraphicsTextItem(QString::number(node->value), widget);
+    auto* text = new LodTextItem(QString::number(value), widget);
     QFont font("Segoe UI", 12, QFont::Bold);
     text->setFont(font);
     text->setDefaultTextColor(Qt::white);
@@ -149,7 +127,7 @@ VisualNode* VisualTree::layoutTreeRecursive(TreeNode* node, VisualNode* parentVi
     widget->setPos(currentPos);
 
     auto* visualNode = new VisualNode{
-        node->value,
+        value,
         currentPos,
         widget,
         ellipse,
@@ -164,21 +142,9 @@ VisualNode* VisualTree::layoutTreeRecursive(TreeNode* node, VisualNode* parentVi
         auto* line = scene->addLine(QLineF(parentVisual->pos, currentPos), QPen(QColor("#ABB2BF"), 3));
         line->setZValue(-1);
         visualNode->lineToParent = line;
-
-        if (node->value < parentVisual->value) {
-            parentVisual->left = visualNode;
-        } else {
-            parentVisual->right = visualNode;
-        }
     }
 
-    nodeMap[node->value] = visualNode;
-
-    // 递归构建左右子树
-    visualNode->left = layoutTreeRecursive(node->left, visualNode,
-                                           currentPos + QPointF(-xOffset, 0), xOffset / 2, spacingX, spacingY, depth + 1);
-    visualNode->right = layoutTreeRecursive(node->right, visualNode,
-                                            currentPos + QPointF(xOffset, 0), xOffset / 2, spacingX, spacingY, depth + 1);
+    nodeMap[value] = visualNode;
 
     return visualNode;
 }
@@ -2,6 +2,7 @@
 #define VISUALTREE_H
 
 #include "binarytree.h"
+#include "loditems.h"
 #include <QGraphicsScene>
 #include <QGraphicsView>
 #include <QGraphicsWidget>
@@ -9,6 +10,7 @@
 #include <QGraphicsTextItem>
 #include <QPropertyAnimation>
 #include <QMap>
+#include <QVector>
 #include <cmath>
 #include <QDebug>
 
@@ -39,11 +41,16 @@ public:
     VisualNode* findParentNode(int childValue);
     VisualNode* findVisualNode(int value);
     VisualNode* insertVisualNode(VisualNode*, TreeNode*, TreeNode*, QPointF);
-    void rebuild(TreeNode* root);
+    // 按结点的 value/left/right 重建整棵树，TreeNode 与 AVLTree<int>::Node 均可
+    template <class Node>
+    void rebuild(const Node* root);
     QSizeF computeSubtreeSize(TreeNode* node, int spacingX);
-    VisualNode* layoutTreeRecursive(TreeNode* node, VisualNode* parentVisual,
-                                                QPointF center, qreal xOffset,
-                                                int spacingX, int spacingY, int depth);
+    // 以显式栈先序布局，退化成单链的树也不会耗尽调用栈
+    template <class Node>
+    VisualNode* layoutTree(const Node* root, QPointF rootPos, qreal xOffset, int spacingY);
+    VisualNode* createVisualNode(int value, VisualNode* parentVisual, QPointF pos);
+
+    static const int MaxNodes = 1000;           // 由数据集构建时可视化的最大结点数
 
 
 private:
@@ -55,4 +62,57 @@ private:
 
 };
 
+template <class Node>
+void VisualTree::rebuild(const Node* root) {
+
+    scene->clear();
+    visualRoot = nullptr;
+    nodeMap.clear();
+
+    if (!root) return;
+
+    const int spacingY = 80;
+    QPointF rootPos(areaSize.width() / 2, 50);
+
+    visualRoot = layoutTree(root, rootPos, areaSize.width() / 4, spacingY);
+
+    resetView();
+}
+
+template <class Node>
+VisualNode* VisualTree::layoutTree(const Node* root, QPointF rootPos, qreal xOffset, int spacingY) {
+    struct Frame {
+        const Node* node;
+        VisualNode* parent;
+        bool isLeft;
+        QPointF pos;
+        qreal xOffset;      // 孩子相对本结点的水平偏移，逐层减半
+    };
+
+    VisualNode* top = nullptr;
+    QVector<Frame> stack;
+    if (root) stack.push_back(Frame{root, nullptr, false, rootPos, xOffset});
+    while (!stack.isEmpty()) {
+        const Frame frame = stack.back();
+        stack.pop_back();
+
+        // 孩子挂在哪一侧由树的形状决定，不按值比较：允许重复值的二叉排序树里相等的值在右子树
+        VisualNode* visualNode = createVisualNode(frame.node->value, frame.parent, frame.pos);
+        if (!frame.parent)
+            top = visualNode;
+        else if (frame.isLeft)
+            frame.parent->left = visualNode;
+        else
+            frame.parent->right = visualNode;
+
+        // 先压右孩子，左子树先出栈，创建顺序与递归先序相同
+        const QPointF below = frame.pos + QPointF(0, spacingY);
+        if (frame.node->right)
+            stack.push_back(Frame{frame.node->right, visualNode, false, below + QPointF(frame.xOffset, 0), frame.xOffset / 2});
+        if (frame.node->left)
+            stack.push_back(Frame{frame.node->left, visualNode, true, below + QPointF(-frame.xOffset, 0), frame.xOffset / 2});
+    }
+    return top;
+}
+
 #endif // VISUALTREE_H
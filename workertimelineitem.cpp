@@ -0,0 +1,123 @@
+#include "workertimelineitem.h"
+#include "histogramitem.h"
+
+static const qreal kSideMargin = 40;     // 与柱状图左右留白一致
+static const qreal kLabelWidth = 36;     // 行首“W0”标签
+static const qreal kStatsWidth = 110;    // 行尾忙碌比例与窃取次数
+static const qreal kMaxRowHeight = 22;
+static const qreal kRowGap = 3;
+
+WorkerTimelineItem::WorkerTimelineItem(QSizeF areaSize, QGraphicsItem* parent)
+    : QGraphicsItem(parent), m_areaSize(areaSize), m_now(0) {}
+
+void WorkerTimelineItem::setWorkerCount(int workers) {
+    m_segments.clear();
+    m_steals.clear();
+    m_segments.resize(qMax(0, workers));
+    m_steals.resize(qMax(0, workers));
+    m_now = 0;
+    update();
+}
+
+void WorkerTimelineItem::setBusy(int worker, bool busy) {
+    if (worker < 0 || worker >= m_segments.size()) return;
+    QVector<Segment>& row = m_segments[worker];
+    const bool open = !row.isEmpty() && row.last().end < 0;
+    if (busy && !open) {
+        // 紧接上一段时直接续上，避免同一时刻的“空闲-忙碌”切换留下零宽缝隙
+        if (!row.isEmpty() && row.last().end == m_now)
+            row.last().end = -1;
+        else
+            row.append(Segment{m_now, -1});
+    } else if (!busy && open) {
+        row.last().end = m_now;
+    }
+}
+
+void WorkerTimelineItem::markSteal(int worker) {
+    if (worker < 0 || worker >= m_steals.size()) return;
+    m_steals[worker].append(m_now);
+}
+
+void WorkerTimelineItem::tick() {
+    ++m_now;
+    update();
+}
+
+void WorkerTimelineItem::clear() {
+    m_segments.clear();
+    m_steals.clear();
+    m_now = 0;
+    update();
+}
+
+int WorkerTimelineItem::workerCount() const {
+    return m_segments.size();
+}
+
+int WorkerTimelineItem::busyTime(int worker) const {
+    int total = 0;
+    for (const Segment& segment : m_segments[worker])
+        total += (segment.end < 0 ? m_now : segment.end) - segment.start;
+    return total;
+}
+
+double WorkerTimelineItem::utilization(int worker) const {
+    if (worker < 0 || worker >= m_segments.size() || m_now == 0) return 0;
+    return static_cast<double>(busyTime(worker)) / m_now;
+}
+
+int WorkerTimelineItem::stealCount(int worker) const {
+    if (worker < 0 || worker >= m_steals.size()) return 0;
+    return m_steals[worker].size();
+}
+
+QRectF WorkerTimelineItem::boundingRect() const {
+    return QRectF(0, 0, m_areaSize.width(), m_areaSize.height());
+}
+
+void WorkerTimelineItem::paint(QPainter* painter, const QStyleOptionGraphicsItem* option, QWidget* widget) {
+    Q_UNUSED(option);
+    Q_UNUSED(widget);
+    const int workers = m_segments.size();
+    if (workers == 0) return;
+
+    const qreal rowHeight = qMin(kMaxRowHeight, (m_areaSize.height() - 10) / workers - kRowGap);
+    if (rowHeight < 2) return;
+    const qreal left = kSideMargin + kLabelWidth;
+    const qreal width = m_areaSize.width() - left - kSideMargin - kStatsWidth;
+    const qreal scale = width / qMax(1, m_now);
+
+    painter->setFont(QFont("Segoe UI", qBound(6, static_cast<int>(rowHeight * 0.5), 10), QFont::Bold));
+    for (int w = 0; w < workers; ++w) {
+        const qreal y = 5 + w * (rowHeight + kRowGap);
+        const QColor color = HistogramItem::ownerColor(w);
+
+        painter->setPen(color);
+        painter->drawText(QRectF(kSideMargin, y, kLabelWidth - 4, rowHeight), Qt::AlignRight | Qt::AlignVCenter,
+                          QString("W%1").arg(w));
+
+        painter->setPen(Qt::NoPen);
+        painter->setBrush(QColor("#3A3A3A"));
+        painter->drawRect(QRectF(left, y, width, rowHeight));
+
+        painter->setBrush(color);
+        for (const Segment& segment : m_segments[w]) {
+            const int end = segment.end < 0 ? m_now : segment.end;
+            // 极短的区段也至少画一个像素，否则高并发时看不出交错
+            painter->drawRect(QRectF(left + segment.start * scale, y, qMax<qreal>(1, (end - segment.start) * scale), rowHeight));
+        }
+
+        painter->setBrush(QColor("#E0E0E0"));
+        for (int t : m_steals[w]) {
+            const qreal x = left + t * scale;
+            QPolygonF marker;
+            marker << QPointF(x, y) << QPointF(x - 3, y - 4) << QPointF(x + 3, y - 4);
+            painter->drawPolygon(marker);
+        }
+
+        painter->setPen(QColor("#ABB2BF"));
+        painter->drawText(QRectF(left + width + 8, y, kStatsWidth - 8, rowHeight), Qt::AlignLeft | Qt::AlignVCenter,
+                          QString("%1%  窃取 %2").arg(qRound(utilization(w) * 100)).arg(stealCount(w)));
+    }
+}
@@ -0,0 +1,43 @@
+#ifndef WORKERTIMELINEITEM_H
+#define WORKERTIMELINEITEM_H
+
+#include <QGraphicsItem>
+#include <QStyleOptionGraphicsItem>
+#include <QPainter>
+#include <QVector>
+#include <QSizeF>
+
+// 并行排序的工作者时间线：每个工作者一行，忙碌区段按工作者颜色填充，空闲留暗色
+// 时间以已回放的事件数计量，横轴随回放进度整体缩放；右侧给出各自的忙碌比例
+class WorkerTimelineItem : public QGraphicsItem {
+public:
+    explicit WorkerTimelineItem(QSizeF areaSize, QGraphicsItem* parent = nullptr);
+
+    void setWorkerCount(int workers);
+    void setBusy(int worker, bool busy);      // 在当前时刻切换忙碌/空闲
+    void markSteal(int worker);               // 在当前时刻标记一次窃取
+    void tick();                              // 时间前进一步
+    void clear();
+
+    int workerCount() const;
+    double utilization(int worker) const;     // 忙碌时间占已回放时间的比例
+    int stealCount(int worker) const;
+
+    QRectF boundingRect() const override;
+    void paint(QPainter* painter, const QStyleOptionGraphicsItem* option, QWidget* widget = nullptr) override;
+
+private:
+    struct Segment {
+        int start;
+        int end;                              // 仍在忙碌时为 -1
+    };
+
+    int busyTime(int worker) const;
+
+    QSizeF m_areaSize;
+    QVector<QVector<Segment>> m_segments;
+    QVector<QVector<int>> m_steals;
+    int m_now;
+};
+
+#endif // WORKERTIMELINEITEM_H